@@ -0,0 +1,30 @@
+# Writes BenchCommit.h with the commit id of SOURCE_DIR into OUTPUT.
+# Runs on every build (cmake -P), not at configure time, so committing and
+# rebuilding records the new commit; the header is only rewritten when the
+# id changes, so bench_main.cpp only recompiles then.
+execute_process(
+    COMMAND git rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE COMMIT
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    RESULT_VARIABLE REV_PARSE_RESULT
+    ERROR_QUIET
+)
+if(NOT REV_PARSE_RESULT EQUAL 0 OR NOT COMMIT)
+    set(COMMIT "unknown")
+else()
+    # Uncommitted changes to tracked files: the numbers are not that commit's
+    execute_process(
+        COMMAND git diff-index --quiet HEAD --
+        WORKING_DIRECTORY ${SOURCE_DIR}
+        RESULT_VARIABLE DIRTY
+        ERROR_QUIET
+    )
+    if(NOT DIRTY EQUAL 0)
+        set(COMMIT "${COMMIT}-dirty")
+    endif()
+endif()
+
+file(WRITE ${OUTPUT}.tmp "#pragma once\n#define HFT_GIT_COMMIT \"${COMMIT}\"\n")
+configure_file(${OUTPUT}.tmp ${OUTPUT} COPYONLY)
+file(REMOVE ${OUTPUT}.tmp)
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "TSCTimer.h"
+#include "LatencyHistogram.h"
+#include "ThreadRuntime.h"
+#include <benchmark/benchmark.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace bench {
+
+// Report a histogram's tail as benchmark counters (ns), so percentiles
+// land in the JSON next to the mean Google Benchmark computes itself
+inline void report_percentiles(benchmark::State& state, const LatencyHistogram& hist,
+                               const std::string& prefix = "") {
+    const LatencySummary s = hist.summary(TSCTimer::instance());
+    state.counters[prefix + "p50_ns"] = s.p50_ns;
+    state.counters[prefix + "p99_ns"] = s.p99_ns;
+    state.counters[prefix + "p999_ns"] = s.p999_ns;
+    state.counters[prefix + "max_ns"] = s.max_ns;
+}
+
+// Benchmark threads go on the CPUs listed in HFT_BENCH_CPUS
+// ("producer,consumer", e.g. isolated cores "2,3"); unset leaves them to
+// the scheduler
+inline int bench_cpu(size_t role) {
+    const char* list = std::getenv("HFT_BENCH_CPUS");
+    if (list == nullptr) {
+        return -1;
+    }
+    const std::string cpus(list);
+    size_t start = 0;
+    for (size_t i = 0; i < role; ++i) {
+        start = cpus.find(',', start);
+        if (start == std::string::npos) return -1;
+        ++start;
+    }
+    return std::atoi(cpus.c_str() + start);
+}
+
+inline void pin_role(size_t role) {
+    const int cpu = bench_cpu(role);
+    if (cpu >= 0) {
+        ThreadRuntime::pin_current_thread(cpu);
+    }
+}
+
+// Spin-wait step: pause on a real core, yield when both threads would
+// otherwise share one CPU and starve each other for a whole time slice
+inline void relax() {
+    static const bool shared_cpu = std::thread::hardware_concurrency() < 2;
+    if (shared_cpu) {
+        std::this_thread::yield();
+    } else {
+        _mm_pause();
+    }
+}
+
+// User-space hardware cache-miss counts for the calling thread through
+// perf_event_open. Containers and virtual machines often hide the PMU, or
+// perf_event_paranoid forbids it: available() is then false and the
+// benchmark reports time only.
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+        l1d_fd_ = open_event(PERF_TYPE_HW_CACHE,
+                             PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        llc_fd_ = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    }
+    ~CacheMissCounter() {
+        if (l1d_fd_ >= 0) close(l1d_fd_);
+        if (llc_fd_ >= 0) close(llc_fd_);
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool available() const noexcept { return l1d_fd_ >= 0 && llc_fd_ >= 0; }
+
+    void start() noexcept {
+        for (int fd : {l1d_fd_, llc_fd_}) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    void stop() noexcept {
+        for (int fd : {l1d_fd_, llc_fd_}) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    uint64_t l1d_misses() const noexcept { return read_count(l1d_fd_); }
+    uint64_t llc_misses() const noexcept { return read_count(llc_fd_); }
+
+    // Misses per item as counters, when the PMU is reachable
+    void report(benchmark::State& state, double items) const {
+        if (!available() || items == 0) {
+            return;
+        }
+        state.counters["l1d_misses_per_item"] = static_cast<double>(l1d_misses()) / items;
+        state.counters["llc_misses_per_item"] = static_cast<double>(llc_misses()) / items;
+    }
+
+private:
+    int l1d_fd_ = -1;
+    int llc_fd_ = -1;
+
+    static int open_event(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t read_count(int fd) noexcept {
+        uint64_t count = 0;
+        if (fd < 0 || read(fd, &count, sizeof(count)) != sizeof(count)) {
+            return 0;
+        }
+        return count;
+    }
+};
+
+}  // namespace bench
@@ -0,0 +1,24 @@
+#include "BenchCommit.h"     // Generated on each build: HFT_GIT_COMMIT
+#include "TSCTimer.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+
+// Google Benchmark's main plus the context needed to compare runs across
+// commits and hosts; use --benchmark_out=<file> --benchmark_out_format=json
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    const TSCTimer& timer = TSCTimer::instance();
+    benchmark::AddCustomContext("git_commit", HFT_GIT_COMMIT);
+    benchmark::AddCustomContext("tsc_ghz", std::to_string(timer.get_frequency_ghz()));
+    benchmark::AddCustomContext("tsc_invariant", TSCTimer::is_invariant_tsc() ? "true" : "false");
+    benchmark::AddCustomContext("hardware_threads", std::to_string(std::thread::hardware_concurrency()));
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "BenchUtil.h"
+#include "BookManager.h"
+#include "Capture.h"
+#include "FlowGenerator.h"
+#include "LatencyHistogram.h"
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr SymbolId SYMBOL = 0;
+constexpr size_t FLOW_MESSAGES = 200'000;
+constexpr size_t LIVE_ORDERS = 5'000;
+
+// Steady-state flow on one symbol, ending with a cancel of everything
+// still resting so the same flow can be applied to one book repeatedly
+std::vector<Message> synthetic_flow(size_t count, uint64_t seed) {
+    FlowConfig config;
+    config.seed = seed;
+    config.symbols = 1;
+    config.max_live_orders = LIVE_ORDERS;
+    config.min_live_orders = LIVE_ORDERS / 2;
+    FlowGenerator generator(config);
+
+    std::vector<Message> flow(count);
+    generator.generate(flow);
+    Message msg;
+    while (generator.drain(msg)) {
+        flow.push_back(msg);
+    }
+    return flow;
+}
+
+const std::vector<Message>& shared_flow() {
+    static const std::vector<Message> flow = synthetic_flow(FLOW_MESSAGES, 20);
+    return flow;
+}
+
+// Apply messages one by one, timing each into its type's histogram
+template<typename Range>
+void process_timed(BookManager& books, const Range& messages, MessageLatencyRecorder& latency) {
+    const TSCTimer& timer = TSCTimer::instance();
+    for (const Message& msg : messages) {
+        const uint64_t start = timer.now();
+        books.process(msg);
+        latency.record(msg.type, timer.now() - start);
+    }
+}
+
+void report_by_type(benchmark::State& state, const MessageLatencyRecorder& latency) {
+    bench::report_percentiles(state, latency[MessageType::ADD_ORDER], "add_");
+    bench::report_percentiles(state, latency[MessageType::CANCEL_ORDER], "cancel_");
+    bench::report_percentiles(state, latency[MessageType::MODIFY_ORDER], "modify_");
+    bench::report_percentiles(state, latency[MessageType::EXECUTE_ORDER], "execute_");
+}
+
+}  // namespace
+
+// Per-message latency distribution by type on synthetic flow. Each
+// sample includes one rdtscp pair (see BM_TscTimerBackToBack).
+static void BM_BookLatencySynthetic(benchmark::State& state) {
+    const std::vector<Message>& flow = shared_flow();
+    auto books = std::make_unique<BookManager>(LIVE_ORDERS * 2);
+    books->add_symbol(SYMBOL);
+    auto latency = std::make_unique<MessageLatencyRecorder>();
+
+    for (auto _ : state) {
+        process_timed(*books, flow, *latency);
+    }
+    state.SetItemsProcessed(state.iterations() * flow.size());
+    report_by_type(state, *latency);
+}
+BENCHMARK(BM_BookLatencySynthetic)->Unit(benchmark::kMillisecond);
+
+// Same flow untimed: sustained messages per second
+static void BM_BookThroughputSynthetic(benchmark::State& state) {
+    const std::vector<Message>& flow = shared_flow();
+    auto books = std::make_unique<BookManager>(LIVE_ORDERS * 2);
+    books->add_symbol(SYMBOL);
+
+    for (auto _ : state) {
+        for (const Message& msg : flow) {
+            benchmark::DoNotOptimize(books->process(msg));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * flow.size());
+}
+BENCHMARK(BM_BookThroughputSynthetic)->Unit(benchmark::kMillisecond);
+
+// Replay from a capture mapping: HFT_BENCH_CAPTURE names a recorded
+// session; otherwise the synthetic flow is recorded to a temporary
+// capture first. Each iteration applies the whole capture to fresh books.
+static void BM_BookLatencyReplay(benchmark::State& state) {
+    std::string path;
+    bool temporary = false;
+    if (const char* capture = std::getenv("HFT_BENCH_CAPTURE")) {
+        path = capture;
+    } else {
+        path = "/tmp/hft_bench_flow_" + std::to_string(getpid()) + ".cap";
+        CaptureRecorder recorder;
+        if (!recorder.open(path.c_str(), true)) {
+            state.SkipWithError("cannot write temporary capture");
+            return;
+        }
+        for (const Message& msg : shared_flow()) recorder.record(msg);
+        recorder.close();
+        temporary = true;
+    }
+
+    CaptureReplayer replay;
+    if (!replay.open(path.c_str())) {
+        state.SkipWithError("cannot map capture");
+        return;
+    }
+
+    auto latency = std::make_unique<MessageLatencyRecorder>();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto books = std::make_unique<BookManager>();
+        for (SymbolId s = 0; s < Config::MAX_SYMBOLS; ++s) books->add_symbol(s);
+        state.ResumeTiming();
+
+        process_timed(*books, replay.messages(), *latency);
+    }
+    state.SetItemsProcessed(state.iterations() * replay.size());
+    report_by_type(state, *latency);
+
+    if (temporary) {
+        unlink(path.c_str());
+    }
+}
+BENCHMARK(BM_BookLatencyReplay)->Unit(benchmark::kMillisecond);
+
+// Generator alone, into a reused batch: must stay well ahead of the book
+static void BM_FlowGenerator(benchmark::State& state) {
+    FlowGenerator generator(FlowConfig::market_open(static_cast<size_t>(state.range(0))));
+    std::vector<Message> batch(1024);
+
+    for (auto _ : state) {
+        generator.generate(batch);
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_FlowGenerator)->Arg(1)->Arg(Config::MAX_SYMBOLS);
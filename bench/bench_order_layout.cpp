@@ -0,0 +1,139 @@
+#include "BenchUtil.h"
+#include "BookManager.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Order pool layout: hot/cold split against one interleaved record per
+// order, on a deep book like the open. Orders are added in random level
+// order, so consecutive orders of one queue sit far apart in the pool and
+// every order visited is a fresh line unless the hot set fits in cache.
+
+namespace {
+
+template<OrderLayout Layout>
+using LayoutSpec = BookSpec<Price, Quantity, uint32_t, Config::MIN_PRICE, Config::MAX_PRICE,
+                            Config::MAX_ORDERS, Config::LEVEL_WINDOW_SIZE,
+                            Config::LEVEL_OVERFLOW_SLOTS, Layout>;
+
+constexpr SymbolId SYMBOL = 0;
+constexpr Price MID = 10'000;
+constexpr Price LEVELS = 200;           // Per side
+
+// Resting orders: fill the book to `orders`, alternating sides, each at a
+// random one of LEVELS levels from the touch; ids are 1..orders
+template<typename Manager>
+void build_deep_book(Manager& books, size_t orders) {
+    std::mt19937 rng(7);
+    for (OrderId id = 1; id <= orders; ++id) {
+        const Side side = (id & 1) ? Side::SELL : Side::BUY;
+        const Price offset = 1 + rng() % LEVELS;
+        books.add_order(SYMBOL, id, side, side == Side::SELL ? MID + offset : MID - offset,
+                        100 + rng() % 900);
+    }
+}
+
+template<OrderLayout Layout>
+struct DeepBook {
+    using Manager = BasicBookManager<LayoutSpec<Layout>>;
+
+    std::unique_ptr<Manager> books;
+
+    explicit DeepBook(size_t orders) : books(std::make_unique<Manager>(orders)) {
+        books->add_symbol(SYMBOL);
+        build_deep_book(*books, orders);
+    }
+    auto& book() { return *books->book(SYMBOL); }
+};
+
+}  // namespace
+
+// Sweep the ask side level by level, executing every queued order in
+// time priority: the matching engine's walk, touching quantities and
+// links only
+template<OrderLayout Layout>
+static void BM_LayoutSweepExecute(benchmark::State& state) {
+    const size_t orders = static_cast<size_t>(state.range(0));
+    bench::CacheMissCounter misses;
+    size_t executed = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        DeepBook<Layout> deep(orders);
+        auto& book = deep.book();
+        state.ResumeTiming();
+
+        misses.start();
+        while (book.has_ask()) {
+            book.for_each_order(Side::SELL, book.best_ask(), [&](auto handle, Quantity open) {
+                book.execute_order(handle, open, Side::SELL);
+                ++executed;
+            });
+        }
+        misses.stop();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(executed));
+    misses.report(state, static_cast<double>(executed));
+}
+BENCHMARK_TEMPLATE(BM_LayoutSweepExecute, OrderLayout::INTERLEAVED)
+    ->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LayoutSweepExecute, OrderLayout::SPLIT)
+    ->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+// Queue-position aggregation: open quantity ahead of random resting
+// orders, a walk of prev links and quantities
+template<OrderLayout Layout>
+static void BM_LayoutQueueAhead(benchmark::State& state) {
+    const size_t orders = static_cast<size_t>(state.range(0));
+    DeepBook<Layout> deep(orders);
+    auto& book = deep.book();
+
+    std::mt19937 rng(11);
+    std::vector<typename DeepBook<Layout>::Manager::Handle> probes(4096);
+    for (auto& h : probes) h = deep.books->find_order(1 + rng() % orders);
+
+    bench::CacheMissCounter misses;
+    misses.start();
+    for (auto _ : state) {
+        for (auto h : probes) {
+            benchmark::DoNotOptimize(book.quantity_ahead(h));
+        }
+    }
+    misses.stop();
+    state.SetItemsProcessed(state.iterations() * probes.size());
+    misses.report(state, static_cast<double>(state.iterations() * probes.size()));
+}
+BENCHMARK_TEMPLATE(BM_LayoutQueueAhead, OrderLayout::INTERLEAVED)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_LayoutQueueAhead, OrderLayout::SPLIT)->Arg(1'000'000);
+
+// Random executes by id through the manager: index, cold record (book and
+// side) and hot record, where the split layout pays one extra line
+template<OrderLayout Layout>
+static void BM_LayoutExecuteById(benchmark::State& state) {
+    const size_t orders = static_cast<size_t>(state.range(0));
+    bench::CacheMissCounter misses;
+    std::vector<OrderId> ids(orders);
+    for (size_t i = 0; i < orders; ++i) ids[i] = i + 1;
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(3));
+    size_t executed = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        DeepBook<Layout> deep(orders);
+        state.ResumeTiming();
+
+        misses.start();
+        for (OrderId id : ids) {
+            deep.books->execute_order(id, 50);      // Partial: the order stays queued
+        }
+        misses.stop();
+        executed += ids.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(executed));
+    misses.report(state, static_cast<double>(executed));
+}
+BENCHMARK_TEMPLATE(BM_LayoutExecuteById, OrderLayout::INTERLEAVED)
+    ->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LayoutExecuteById, OrderLayout::SPLIT)
+    ->Arg(1'000'000)->Unit(benchmark::kMillisecond);
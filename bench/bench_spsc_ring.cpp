@@ -0,0 +1,140 @@
+#include "BenchUtil.h"
+#include "SPSCRing.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+
+template<size_t Bytes>
+struct Payload {
+    static_assert(Bytes >= sizeof(uint64_t));
+    uint64_t sequence;
+    uint8_t bytes[Bytes - sizeof(uint64_t)];
+};
+
+// The sequence alone: no zero-length padding array
+template<>
+struct Payload<sizeof(uint64_t)> {
+    uint64_t sequence;
+};
+
+constexpr size_t BATCH = 32;
+
+}  // namespace
+
+// Push a batch then pop it on one thread: the ring's own instruction
+// cost with its indices hot in L1, no coherence traffic
+template<size_t Bytes, size_t RingSize>
+static void BM_SpscSingleThread(benchmark::State& state) {
+    using Ring = SPSCRing<Payload<Bytes>, RingSize, NoRingStats>;
+    auto ring = std::make_unique<Ring>();
+    Payload<Bytes> item{};
+    for (auto _ : state) {
+        for (size_t i = 0; i < BATCH; ++i) {
+            item.sequence = i;
+            ring->try_emplace(item);
+        }
+        for (size_t i = 0; i < BATCH; ++i) {
+            ring->try_pop(item);
+        }
+        benchmark::DoNotOptimize(item);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+    state.SetBytesProcessed(state.iterations() * BATCH * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_SpscSingleThread, 8, 1024);
+BENCHMARK_TEMPLATE(BM_SpscSingleThread, 64, 1024);
+BENCHMARK_TEMPLATE(BM_SpscSingleThread, 256, 1024);
+BENCHMARK_TEMPLATE(BM_SpscSingleThread, 64, 65536);
+
+// Round trip through two rings between two threads (cores, with
+// HFT_BENCH_CPUS); one iteration is one ping and its pong
+template<size_t Bytes, size_t RingSize>
+static void BM_SpscPingPong(benchmark::State& state) {
+    using Ring = SPSCRing<Payload<Bytes>, RingSize, NoRingStats>;
+    auto ping = std::make_unique<Ring>();
+    auto pong = std::make_unique<Ring>();
+    std::atomic<bool> done{false};
+
+    std::thread echo([&] {
+        bench::pin_role(1);
+        Payload<Bytes> item;
+        while (!done.load(std::memory_order_relaxed)) {
+            if (ping->try_pop(item)) {
+                while (!pong->try_emplace(item)) bench::relax();
+            } else {
+                bench::relax();
+            }
+        }
+    });
+    bench::pin_role(0);
+
+    const TSCTimer& timer = TSCTimer::instance();
+    LatencyHistogram hist;
+    Payload<Bytes> item{};
+    for (auto _ : state) {
+        const uint64_t start = timer.now();
+        while (!ping->try_emplace(item)) bench::relax();
+        while (!pong->try_pop(item)) bench::relax();
+        hist.record(timer.now() - start);
+        ++item.sequence;
+    }
+    done.store(true, std::memory_order_relaxed);
+    echo.join();
+    bench::report_percentiles(state, hist, "rtt_");
+}
+BENCHMARK_TEMPLATE(BM_SpscPingPong, 8, 1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscPingPong, 64, 1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscPingPong, 256, 1024)->UseRealTime();
+
+// Producer thread streams items as fast as the consumer drains them;
+// one iteration moves `range(0)` items
+template<size_t Bytes, size_t RingSize>
+static void BM_SpscCrossThreadThroughput(benchmark::State& state) {
+    using Ring = SPSCRing<Payload<Bytes>, RingSize, NoRingStats>;
+    auto ring = std::make_unique<Ring>();
+    const auto items = static_cast<uint64_t>(state.range(0));
+    std::atomic<uint64_t> target{0};
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        bench::pin_role(0);
+        Payload<Bytes> item{};
+        uint64_t sent = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            const uint64_t goal = target.load(std::memory_order_acquire);
+            while (sent < goal) {
+                item.sequence = sent;
+                if (ring->try_emplace(item)) {
+                    ++sent;
+                } else {
+                    bench::relax();
+                }
+            }
+            bench::relax();
+        }
+    });
+    bench::pin_role(1);
+
+    uint64_t received = 0;
+    for (auto _ : state) {
+        target.fetch_add(items, std::memory_order_release);
+        const uint64_t goal = received + items;
+        while (received < goal) {
+            const size_t n = ring->consume_all([](Payload<Bytes>& item) {
+                benchmark::DoNotOptimize(item);
+            }, 256);
+            received += n;
+            if (n == 0) bench::relax();
+        }
+    }
+    done.store(true, std::memory_order_relaxed);
+    producer.join();
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetBytesProcessed(state.iterations() * items * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_SpscCrossThreadThroughput, 8, 1024)->Arg(1 << 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscCrossThreadThroughput, 64, 1024)->Arg(1 << 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscCrossThreadThroughput, 64, 65536)->Arg(1 << 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscCrossThreadThroughput, 256, 1024)->Arg(1 << 16)->UseRealTime();
@@ -0,0 +1,66 @@
+#include "BenchUtil.h"
+#include "TSCClock.h"
+#include <chrono>
+#include <ctime>
+
+// Cost of taking a timestamp, the floor under every latency we measure
+
+static void BM_TscTimerNow(benchmark::State& state) {
+    const TSCTimer& timer = TSCTimer::instance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(timer.now());
+    }
+}
+BENCHMARK(BM_TscTimerNow);
+
+static void BM_Rdtsc(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(__rdtsc());
+    }
+}
+BENCHMARK(BM_Rdtsc);
+
+static void BM_Rdtscp(benchmark::State& state) {
+    uint32_t aux;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rdtscp(&aux));
+    }
+}
+BENCHMARK(BM_Rdtscp);
+
+static void BM_TscClockUtc(benchmark::State& state) {
+    const TSCClock& clock = TSCClock::instance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clock.now_utc_ns());
+    }
+}
+BENCHMARK(BM_TscClockUtc);
+
+static void BM_ClockGettime(benchmark::State& state) {
+    const auto id = static_cast<clockid_t>(state.range(0));
+    timespec ts;
+    for (auto _ : state) {
+        clock_gettime(id, &ts);
+        benchmark::DoNotOptimize(ts);
+    }
+}
+BENCHMARK(BM_ClockGettime)->Arg(CLOCK_REALTIME)->Arg(CLOCK_MONOTONIC)->ArgName("clock");
+
+static void BM_SteadyClockNow(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+    }
+}
+BENCHMARK(BM_SteadyClockNow);
+
+// Back-to-back now() deltas: the smallest interval the timer can resolve
+static void BM_TscTimerBackToBack(benchmark::State& state) {
+    const TSCTimer& timer = TSCTimer::instance();
+    LatencyHistogram hist;
+    for (auto _ : state) {
+        const uint64_t start = timer.now();
+        hist.record(timer.now() - start);
+    }
+    bench::report_percentiles(state, hist);
+}
+BENCHMARK(BM_TscTimerBackToBack);
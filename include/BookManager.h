@@ -0,0 +1,292 @@
+#pragma once
+
+#include "Types.h"
+#include "OrderPool.h"
+#include "OrderIdMap.h"
+#include "OrderBook.h"
+#include "Message.h"
+#include "HealthCounters.h"
+#include <memory>
+
+/**
+ * Multi-Symbol Book Manager
+ *
+ * Owns the shared OrderPool, the OrderId index and one OrderBook per
+ * registered symbol. Cancel, modify and execute requests arrive keyed only
+ * by OrderId; the index resolves them to a pool handle in O(1), and the
+ * order itself records which book it rests in. One BookSpec covers the
+ * pool, index and every book; BookRegistry combines managers of several.
+ *
+ * Usage:
+ *   BookManager books;                   // BasicBookManager<Spec> for other specs
+ *   books.add_symbol(symbol);            // At startup, before the session
+ *
+ *   books.add_order(symbol, 42, Side::BUY, 10025, 100);
+ *   books.execute_order(42, 40);
+ *   books.cancel_order(42);
+ *
+ *   // Or drive it from the normalized feed:
+ *   Message msg;
+ *   while (ring.try_pop(msg)) books.process(msg);
+ */
+template<BookSpecification Spec = DefaultBookSpec>
+class BasicBookManager {
+public:
+    using Book = BasicOrderBook<Spec>;
+    using Pool = BasicOrderPool<Spec>;
+    using Handle = typename Spec::handle_type;
+
+    static constexpr Handle INVALID_HANDLE = Spec::INVALID_HANDLE;
+
+    // max_orders is clamped to Spec::MAX_ORDERS, the index capacity. With
+    // an arena, the pool, index and every book's levels are allocated from
+    // it (heap once it is full); it must outlive the manager.
+    explicit BasicBookManager(size_t max_orders = Spec::MAX_ORDERS, HugePageArena* arena = nullptr);
+    ~BasicBookManager() = default;
+
+    // Non-copyable, non-movable (books hold references to the pool)
+    BasicBookManager(const BasicBookManager&) = delete;
+    BasicBookManager& operator=(const BasicBookManager&) = delete;
+    BasicBookManager(BasicBookManager&&) = delete;
+    BasicBookManager& operator=(BasicBookManager&&) = delete;
+
+    // Setup (allocates; call before the hot path starts)
+    bool add_symbol(SymbolId symbol);
+
+    // Order operations keyed by OrderId (single thread only)
+    bool add_order(SymbolId symbol, OrderId id, Side side, Price price, Quantity quantity) noexcept;
+    bool cancel_order(OrderId id, Quantity quantity = 0) noexcept;
+    bool execute_order(OrderId id, Quantity quantity) noexcept;
+    bool modify_order(OrderId id, Price new_price, Quantity new_quantity) noexcept;
+    bool replace_order(OrderId id, OrderId new_id, Price new_price, Quantity new_quantity) noexcept;
+
+    // Execute a resting order already resolved to its handle (matching
+    // walks level queues, so it skips the id lookup); returns the quantity
+    // left open, 0 once the order is filled and removed
+    Quantity fill_order(Handle handle, Quantity quantity) noexcept;
+
+    // Apply one normalized message; returns false if it was rejected
+    bool process(const Message& msg) noexcept;
+
+    // Copy pool and index gauges into the health block; process() does
+    // this every BookHealth::REFRESH_INTERVAL messages
+    void refresh_health() noexcept;
+
+    // Queries
+    Book* book(SymbolId symbol) noexcept {
+        return symbol < Config::MAX_SYMBOLS ? books_[symbol].get() : nullptr;
+    }
+    const Book* book(SymbolId symbol) const noexcept {
+        return symbol < Config::MAX_SYMBOLS ? books_[symbol].get() : nullptr;
+    }
+    Handle find_order(OrderId id) const noexcept { return index_.find(id); }
+
+    const Pool& pool() const noexcept { return pool_; }
+    size_t order_count() const noexcept { return index_.size(); }
+
+    // Performance monitoring
+    uint64_t unknown_orders() const noexcept { return health_.unknown.value(); }
+    uint64_t rejected_orders() const noexcept { return health_.rejected.value(); }
+    const OrderIdMap<Spec::MAX_ORDERS, Handle>& index() const noexcept { return index_; }
+
+    // Telemetry (any thread)
+    const BookHealth& health() const noexcept { return health_; }
+
+private:
+    HugePageArena* arena_;
+    Pool pool_;
+    OrderIdMap<Spec::MAX_ORDERS, Handle> index_;
+    std::unique_ptr<std::unique_ptr<Book>[]> books_;
+
+    BookHealth health_;
+    uint32_t refresh_countdown_ = BookHealth::REFRESH_INTERVAL;
+
+    // Resolve an id to its handle and owning book; counts misses
+    Book* locate(OrderId id, Handle& handle) noexcept;
+};
+
+using BookManager = BasicBookManager<DefaultBookSpec>;
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<BookSpecification Spec>
+BasicBookManager<Spec>::BasicBookManager(size_t max_orders, HugePageArena* arena)
+    : arena_(arena),
+      pool_(max_orders, arena),
+      index_(arena),
+      books_(std::make_unique<std::unique_ptr<Book>[]>(Config::MAX_SYMBOLS)) {}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::add_symbol(SymbolId symbol) {
+    if (symbol >= Config::MAX_SYMBOLS) {
+        return false;
+    }
+    if (!books_[symbol]) {
+        books_[symbol] = std::make_unique<Book>(symbol, pool_, arena_);
+    }
+    return true;
+}
+
+template<BookSpecification Spec>
+typename BasicBookManager<Spec>::Book*
+BasicBookManager<Spec>::locate(OrderId id, Handle& handle) noexcept {
+    handle = index_.find(id);
+    if (UNLIKELY(handle == INVALID_HANDLE)) {
+        health_.unknown.add();
+        return nullptr;
+    }
+    return books_[pool_.cold(handle).symbol].get();
+}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::add_order(SymbolId symbol, OrderId id, Side side,
+                                       Price price, Quantity quantity) noexcept {
+    Book* target = book(symbol);
+    if (UNLIKELY(target == nullptr || index_.contains(id))) {
+        health_.rejected.add();
+        return false;
+    }
+
+    const Handle handle = target->add_order(id, side, price, quantity);
+    if (UNLIKELY(handle == INVALID_HANDLE)) {
+        health_.rejected.add();
+        return false;
+    }
+
+    // The index holds as many entries as the pool, so this cannot fail
+    index_.insert(id, handle);
+    return true;
+}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::cancel_order(OrderId id, Quantity quantity) noexcept {
+    Handle handle;
+    Book* target = locate(id, handle);
+    if (UNLIKELY(target == nullptr)) {
+        return false;
+    }
+
+    // Zero quantity deletes the order outright; otherwise a partial cancel
+    if (quantity == 0) {
+        target->cancel_order(handle);
+        index_.erase(id);
+    } else if (target->reduce_order(handle, quantity) == 0) {
+        index_.erase(id);
+    }
+    return true;
+}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::execute_order(OrderId id, Quantity quantity) noexcept {
+    Handle handle;
+    Book* target = locate(id, handle);
+    if (UNLIKELY(target == nullptr)) {
+        return false;
+    }
+
+    if (target->execute_order(handle, quantity) == 0) {
+        index_.erase(id);
+    }
+    return true;
+}
+
+template<BookSpecification Spec>
+Quantity BasicBookManager<Spec>::fill_order(Handle handle, Quantity quantity) noexcept {
+    const auto& order = pool_.cold(handle);
+    const OrderId id = order.id;
+    const Quantity open = books_[order.symbol]->execute_order(handle, quantity);
+    if (open == 0) {
+        index_.erase(id);
+    }
+    return open;
+}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::modify_order(OrderId id, Price new_price,
+                                          Quantity new_quantity) noexcept {
+    Handle handle;
+    Book* target = locate(id, handle);
+    if (UNLIKELY(target == nullptr)) {
+        return false;
+    }
+
+    if (!target->modify_order(handle, new_price, new_quantity)) {
+        health_.rejected.add();
+        return false;
+    }
+    if (new_quantity == 0) {
+        index_.erase(id);
+    }
+    return true;
+}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::replace_order(OrderId id, OrderId new_id, Price new_price,
+                                           Quantity new_quantity) noexcept {
+    if (new_id == id) {
+        return modify_order(id, new_price, new_quantity);
+    }
+
+    Handle handle;
+    Book* target = locate(id, handle);
+    if (UNLIKELY(target == nullptr)) {
+        return false;
+    }
+
+    // A replace under a new id always loses priority: delete then re-add
+    const auto& original = pool_.cold(handle);
+    const SymbolId symbol = original.symbol;
+    const Side side = original.side;
+    target->cancel_order(handle);
+    index_.erase(id);
+    return add_order(symbol, new_id, side, new_price, new_quantity);
+}
+
+template<BookSpecification Spec>
+bool BasicBookManager<Spec>::process(const Message& msg) noexcept {
+    HFT_PROFILE_ZONE(ProfileZone::BOOK_PROCESS);
+
+    bool applied;
+    switch (msg.type) {
+        case MessageType::ADD_ORDER:
+            applied = add_order(msg.symbol, msg.order_id, msg.side, msg.price, msg.quantity);
+            break;
+        case MessageType::CANCEL_ORDER:
+            applied = cancel_order(msg.order_id, msg.quantity);
+            break;
+        case MessageType::MODIFY_ORDER:
+            applied = msg.new_order_id == 0
+                ? modify_order(msg.order_id, msg.price, msg.quantity)
+                : replace_order(msg.order_id, msg.new_order_id, msg.price, msg.quantity);
+            break;
+        case MessageType::EXECUTE_ORDER:
+            applied = execute_order(msg.order_id, msg.quantity);
+            break;
+        case MessageType::TRADE:
+        case MessageType::HEARTBEAT:
+            applied = true;  // No resting-book effect
+            break;
+        default:
+            return false;
+    }
+
+    if (LIKELY(applied)) {
+        health_.messages[static_cast<size_t>(msg.type)].add();
+    }
+    if (UNLIKELY(--refresh_countdown_ == 0)) {
+        refresh_health();
+    }
+    return applied;
+}
+
+template<BookSpecification Spec>
+void BasicBookManager<Spec>::refresh_health() noexcept {
+    refresh_countdown_ = BookHealth::REFRESH_INTERVAL;
+    health_.orders_in_use.set(pool_.in_use());
+    health_.pool_high_watermark.set(pool_.high_watermark());
+    health_.pool_failed_allocations.set(pool_.failed_allocations());
+    health_.index_longest_probe.set(index_.longest_probe());
+    health_.index_mean_probe_milli.set(static_cast<uint64_t>(index_.mean_probe() * 1000.0));
+}
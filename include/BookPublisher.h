@@ -0,0 +1,297 @@
+#pragma once
+
+#include "Types.h"
+#include "Message.h"
+#include "BookManager.h"
+#include "SPSCRing.h"
+#include "Seqlock.h"
+#include <array>
+#include <memory>
+
+/**
+ * New state of one price level after a book change. Absolute, not a
+ * difference, so consumers can apply it idempotently and conflating two
+ * updates keeps only the later. total_quantity == 0 removes the level.
+ * 32 bytes, two per cache line.
+ */
+struct LevelUpdate {
+    Timestamp timestamp;        // Of the message that caused the change
+    uint64_t sequence;          // Feed sequence of that message
+    Price price;
+    Quantity total_quantity;
+    uint32_t order_count;
+    SymbolId symbol;
+    Side side;
+};
+
+/**
+ * Best bid and offer of one symbol; price NO_BID/NO_ASK for an empty side
+ */
+struct TopOfBook {
+    Timestamp timestamp;
+    uint64_t sequence;
+    Price bid_price;
+    Quantity bid_quantity;
+    Price ask_price;
+    Quantity ask_quantity;
+};
+
+using LevelUpdateRing = SPSCRing<LevelUpdate, Config::OUTPUT_RING_SIZE, SingleWriterRingStats>;
+
+/**
+ * Book Output: Level Deltas and Top-of-Book Snapshots
+ *
+ * Wraps a BookManager on the book thread. Every applied message yields
+ * the new state of each level it touched, published into an output ring
+ * (SPSCRing, a BroadcastRing for several strategies, or a MarketDataBus
+ * for other processes), plus, when the touch changed, a Seqlock
+ * top-of-book per symbol that readers on other cores poll without locks.
+ * A ring with publish_snapshot() also receives each touched symbol's book
+ * once its updates are out.
+ *
+ * Key features:
+ * - Strategies consume level changes, not the raw feed, so their load
+ *   tracks book activity rather than message volume
+ * - Optional conflation: updates are held until flush() and repeated
+ *   changes to one level within the batch collapse to the last state;
+ *   the top-of-book is then also published once per batch
+ * - A full output ring never stalls the book; the update is dropped and
+ *   counted, and the snapshot stays authoritative
+ *
+ * Usage:
+ *   LevelUpdateRing updates;
+ *   BookPublisher<LevelUpdateRing> out(books, updates, true);   // Conflate
+ *
+ *   ring.consume_all([&](Message& msg) { out.process(msg); }, 64);
+ *   out.flush();                                  // End of batch
+ *
+ *   // Strategy core:
+ *   TopOfBook tob = out.top_of_book(symbol).load();
+ */
+template<typename Ring = LevelUpdateRing>
+class BookPublisher {
+public:
+    static constexpr size_t MAX_PENDING = 256;          // Conflation batch cap
+    static constexpr size_t PENDING_SLOTS = 1024;       // Power of 2, <= 25% load
+
+    BookPublisher(BookManager& books, Ring& ring, bool conflate = false);
+
+    // Non-copyable, non-movable (readers hold references to snapshots)
+    BookPublisher(const BookPublisher&) = delete;
+    BookPublisher& operator=(const BookPublisher&) = delete;
+    BookPublisher(BookPublisher&&) = delete;
+    BookPublisher& operator=(BookPublisher&&) = delete;
+
+    // Book thread only
+    bool process(const Message& msg) noexcept;
+    void flush() noexcept;
+
+    // Any thread
+    const Seqlock<TopOfBook>& top_of_book(SymbolId symbol) const noexcept { return snapshots_[symbol]; }
+
+    // Performance monitoring (book thread)
+    uint64_t published_updates() const noexcept { return published_; }
+    uint64_t conflated_updates() const noexcept { return conflated_; }
+    uint64_t dropped_updates() const noexcept { return dropped_; }
+
+private:
+    BookManager& books_;
+    Ring& ring_;
+    const bool conflate_;
+
+    std::unique_ptr<Seqlock<TopOfBook>[]> snapshots_;
+    std::unique_ptr<TopOfBook[]> last_top_;             // Writer's copy, for change detection
+
+    // Conflation state: pending updates in arrival order, indexed by
+    // (symbol, side, price) through a small open-addressing table
+    std::array<LevelUpdate, MAX_PENDING> pending_;
+    std::array<uint16_t, PENDING_SLOTS> pending_index_{};  // 0 = empty, else index + 1
+    size_t pending_count_ = 0;
+    std::array<SymbolId, MAX_PENDING * 2> dirty_symbols_;
+    std::unique_ptr<bool[]> dirty_;
+    struct Stamp {
+        Timestamp timestamp;
+        uint64_t sequence;
+    };
+    std::unique_ptr<Stamp[]> dirty_stamp_;              // Latest message per dirty symbol
+    size_t dirty_count_ = 0;
+
+    uint64_t published_ = 0;
+    uint64_t conflated_ = 0;
+    uint64_t dropped_ = 0;
+
+    void record_level(const Message& msg, SymbolId symbol, Side side, Price price) noexcept;
+    void record_top(const Message& msg, SymbolId symbol) noexcept;
+    void emit(const LevelUpdate& update) noexcept;
+    void publish_top(SymbolId symbol, Timestamp timestamp, uint64_t sequence) noexcept;
+
+    static size_t pending_slot(SymbolId symbol, Side side, Price price) noexcept {
+        const uint64_t key = (static_cast<uint64_t>(symbol) << 33) |
+                             (static_cast<uint64_t>(side) << 32) | price;
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 54);   // log2(PENDING_SLOTS) bits
+    }
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename Ring>
+BookPublisher<Ring>::BookPublisher(BookManager& books, Ring& ring, bool conflate)
+    : books_(books),
+      ring_(ring),
+      conflate_(conflate),
+      snapshots_(std::make_unique<Seqlock<TopOfBook>[]>(Config::MAX_SYMBOLS)),
+      last_top_(std::make_unique<TopOfBook[]>(Config::MAX_SYMBOLS)),
+      dirty_(std::make_unique<bool[]>(Config::MAX_SYMBOLS)),
+      dirty_stamp_(std::make_unique<Stamp[]>(Config::MAX_SYMBOLS)) {
+    static_assert(PENDING_SLOTS == 1024, "pending_slot() takes the top 10 hash bits");
+    for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+        last_top_[s] = TopOfBook{0, 0, OrderBook::NO_BID, 0, OrderBook::NO_ASK, 0};
+        snapshots_[s].store(last_top_[s]);
+    }
+}
+
+template<typename Ring>
+bool BookPublisher<Ring>::process(const Message& msg) noexcept {
+    // Levels an id-keyed message touches are known only before it applies
+    SymbolId symbol = msg.symbol;
+    Side side = msg.side;
+    Price old_price = 0;
+    if (msg.type != MessageType::ADD_ORDER) {
+        const OrderHandle handle = books_.find_order(msg.order_id);
+        if (handle != INVALID_ORDER_HANDLE) {
+            const Order& order = books_.pool()[handle];
+            symbol = order.symbol;
+            side = order.side;
+            old_price = order.price;
+        }
+    }
+
+    if (!books_.process(msg)) {
+        return false;
+    }
+
+    switch (msg.type) {
+        case MessageType::ADD_ORDER:
+            record_level(msg, symbol, side, msg.price);
+            break;
+        case MessageType::CANCEL_ORDER:
+        case MessageType::EXECUTE_ORDER:
+            record_level(msg, symbol, side, old_price);
+            break;
+        case MessageType::MODIFY_ORDER:
+            record_level(msg, symbol, side, old_price);
+            if (msg.price != old_price) {
+                record_level(msg, symbol, side, msg.price);
+            }
+            break;
+        case MessageType::TRADE:
+        case MessageType::HEARTBEAT:
+            return true;
+    }
+    record_top(msg, symbol);
+    return true;
+}
+
+template<typename Ring>
+void BookPublisher<Ring>::record_level(const Message& msg, SymbolId symbol, Side side,
+                                       Price price) noexcept {
+    const PriceLevel& lvl = books_.book(symbol)->level(side, price);
+    const LevelUpdate update{msg.timestamp, msg.sequence, price, lvl.total_quantity,
+                             lvl.order_count, symbol, side};
+    if (!conflate_) {
+        emit(update);
+        return;
+    }
+
+    for (size_t i = pending_slot(symbol, side, price);; i = (i + 1) & (PENDING_SLOTS - 1)) {
+        const uint16_t entry = pending_index_[i];
+        if (entry == 0) {
+            if (pending_count_ == MAX_PENDING) {
+                flush();   // Batch too large to hold; publish what we have
+                record_level(msg, symbol, side, price);
+                return;
+            }
+            pending_[pending_count_] = update;
+            pending_index_[i] = static_cast<uint16_t>(++pending_count_);
+            return;
+        }
+        LevelUpdate& held = pending_[entry - 1];
+        if (held.symbol == symbol && held.side == side && held.price == price) {
+            held = update;   // Later state of the same level supersedes
+            ++conflated_;
+            return;
+        }
+    }
+}
+
+template<typename Ring>
+void BookPublisher<Ring>::record_top(const Message& msg, SymbolId symbol) noexcept {
+    if (!conflate_) {
+        publish_top(symbol, msg.timestamp, msg.sequence);
+        return;
+    }
+    if (!dirty_[symbol]) {
+        if (UNLIKELY(dirty_count_ == dirty_symbols_.size())) {
+            publish_top(symbol, msg.timestamp, msg.sequence);
+            return;
+        }
+        dirty_[symbol] = true;
+        dirty_symbols_[dirty_count_++] = symbol;
+    }
+    dirty_stamp_[symbol] = Stamp{msg.timestamp, msg.sequence};
+}
+
+template<typename Ring>
+void BookPublisher<Ring>::flush() noexcept {
+    for (size_t i = 0; i < pending_count_; ++i) {
+        emit(pending_[i]);
+    }
+    for (size_t i = 0; i < dirty_count_; ++i) {
+        const SymbolId symbol = dirty_symbols_[i];
+        dirty_[symbol] = false;
+        publish_top(symbol, dirty_stamp_[symbol].timestamp, dirty_stamp_[symbol].sequence);
+    }
+    if (pending_count_ != 0) {
+        pending_index_.fill(0);
+    }
+    pending_count_ = 0;
+    dirty_count_ = 0;
+}
+
+template<typename Ring>
+void BookPublisher<Ring>::emit(const LevelUpdate& update) noexcept {
+    bool accepted;
+    if constexpr (requires { ring_.try_publish(update); }) {
+        accepted = ring_.try_publish(update);     // BroadcastRing
+    } else {
+        accepted = ring_.try_emplace(update);     // SPSCRing
+    }
+    if (LIKELY(accepted)) {
+        ++published_;
+    } else {
+        ++dropped_;
+    }
+}
+
+template<typename Ring>
+void BookPublisher<Ring>::publish_top(SymbolId symbol, Timestamp timestamp,
+                                      uint64_t sequence) noexcept {
+    const OrderBook* book = books_.book(symbol);
+    if constexpr (requires { ring_.publish_snapshot(symbol, *book, timestamp, sequence); }) {
+        ring_.publish_snapshot(symbol, *book, timestamp, sequence);     // MarketDataBus
+    }
+
+    TopOfBook top{timestamp, sequence,
+                  book->best_bid(), book->has_bid() ? book->quantity_at(Side::BUY, book->best_bid()) : 0,
+                  book->best_ask(), book->has_ask() ? book->quantity_at(Side::SELL, book->best_ask()) : 0};
+
+    TopOfBook& last = last_top_[symbol];
+    if (top.bid_price == last.bid_price && top.bid_quantity == last.bid_quantity &&
+        top.ask_price == last.ask_price && top.ask_quantity == last.ask_quantity) {
+        return;  // Deeper change only; readers keep their copy
+    }
+    last = top;
+    snapshots_[symbol].store(top);
+}
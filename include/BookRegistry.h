@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Types.h"
+#include "BookManager.h"
+#include "Message.h"
+#include <array>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Mixed-Specification Book Registry
+ *
+ * One BasicBookManager per BookSpec in the pack, each with its own pool
+ * and id index sized by its spec. Every symbol is assigned to one spec;
+ * messages are routed by symbol through a compile-time-unrolled compare
+ * chain on a one-byte tag, never a virtual call.
+ *
+ * Key features:
+ * - Each instantiation keeps its narrow types end to end: a compact
+ *   futures book touches only its own 12-byte levels and 16-bit links
+ * - visit() hands the symbol's manager to a generic lambda, so callers
+ *   write one body and get one specialisation per spec
+ * - Id-keyed messages go to the symbol's manager only when its index
+ *   holds the id; a missing, unassigned or stale symbol falls back to
+ *   probing each manager's index
+ *
+ * Usage:
+ *   using Futures = CompactBookSpec<1024, 16'384>;
+ *   BookRegistry<DefaultBookSpec, Futures> books;
+ *
+ *   books.add_symbol<DefaultBookSpec>(aapl);     // At startup
+ *   books.add_symbol<Futures>(es);
+ *
+ *   books.process(msg);
+ *   books.visit(es, [](auto& manager) { ... });
+ */
+template<BookSpecification... Specs>
+class BookRegistry {
+    static_assert(sizeof...(Specs) >= 1, "At least one spec required");
+    static_assert(sizeof...(Specs) < 255, "Spec tag is one byte");
+
+public:
+    static constexpr size_t SPEC_COUNT = sizeof...(Specs);
+    static constexpr uint8_t UNASSIGNED = 0xFF;
+
+    // Spec position in the pack, as stored per symbol
+    template<BookSpecification S>
+    static constexpr uint8_t spec_index() noexcept {
+        uint8_t index = UNASSIGNED;
+        uint8_t i = 0;
+        ((std::is_same_v<S, Specs> && index == UNASSIGNED ? (index = i, ++i) : ++i), ...);
+        return index;
+    }
+
+    // Each manager's pool is sized to its Spec::MAX_ORDERS
+    explicit BookRegistry(HugePageArena* arena = nullptr);
+    ~BookRegistry() = default;
+
+    // Non-copyable, non-movable (managers are referenced by their books)
+    BookRegistry(const BookRegistry&) = delete;
+    BookRegistry& operator=(const BookRegistry&) = delete;
+    BookRegistry(BookRegistry&&) = delete;
+    BookRegistry& operator=(BookRegistry&&) = delete;
+
+    // Setup (allocates): assign a symbol to spec S. Fails for an invalid
+    // symbol or one already assigned to a different spec.
+    template<BookSpecification S>
+    bool add_symbol(SymbolId symbol);
+
+    // Apply one normalized message; returns false if it was rejected
+    bool process(const Message& msg) noexcept;
+
+    // Call f(manager) with the manager owning symbol; false if unassigned,
+    // otherwise f's result (f must return something convertible to bool)
+    template<typename F>
+    bool visit(SymbolId symbol, F&& f) noexcept;
+
+    // Queries
+    template<BookSpecification S>
+    BasicBookManager<S>& manager() noexcept { return *std::get<spec_index<S>()>(managers_); }
+    template<BookSpecification S>
+    const BasicBookManager<S>& manager() const noexcept { return *std::get<spec_index<S>()>(managers_); }
+
+    uint8_t spec_of(SymbolId symbol) const noexcept {
+        return symbol < Config::MAX_SYMBOLS ? specs_[symbol] : UNASSIGNED;
+    }
+    size_t order_count() const noexcept;
+
+    // Performance monitoring
+    uint64_t unroutable_messages() const noexcept { return unroutable_messages_; }
+
+private:
+    std::tuple<std::unique_ptr<BasicBookManager<Specs>>...> managers_;
+    std::array<uint8_t, Config::MAX_SYMBOLS> specs_;
+    uint64_t unroutable_messages_ = 0;
+
+    template<typename F, size_t... I>
+    bool dispatch(uint8_t spec, F& f, std::index_sequence<I...>) noexcept;
+
+    bool route_by_id(const Message& msg) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<BookSpecification... Specs>
+BookRegistry<Specs...>::BookRegistry(HugePageArena* arena)
+    : managers_(std::make_unique<BasicBookManager<Specs>>(Specs::MAX_ORDERS, arena)...) {
+    specs_.fill(UNASSIGNED);
+}
+
+template<BookSpecification... Specs>
+template<BookSpecification S>
+bool BookRegistry<Specs...>::add_symbol(SymbolId symbol) {
+    constexpr uint8_t index = spec_index<S>();
+    static_assert(index != UNASSIGNED, "Spec is not part of this registry");
+
+    if (symbol >= Config::MAX_SYMBOLS ||
+        (specs_[symbol] != UNASSIGNED && specs_[symbol] != index)) {
+        return false;
+    }
+    if (!manager<S>().add_symbol(symbol)) {
+        return false;
+    }
+    specs_[symbol] = index;
+    return true;
+}
+
+template<BookSpecification... Specs>
+template<typename F, size_t... I>
+bool BookRegistry<Specs...>::dispatch(uint8_t spec, F& f, std::index_sequence<I...>) noexcept {
+    bool result = false;
+    ((spec == I && (result = static_cast<bool>(f(*std::get<I>(managers_))), true)) || ...);
+    return result;
+}
+
+template<BookSpecification... Specs>
+template<typename F>
+bool BookRegistry<Specs...>::visit(SymbolId symbol, F&& f) noexcept {
+    const uint8_t spec = spec_of(symbol);
+    if (UNLIKELY(spec == UNASSIGNED)) {
+        return false;
+    }
+    return dispatch(spec, f, std::index_sequence_for<Specs...>{});
+}
+
+template<BookSpecification... Specs>
+bool BookRegistry<Specs...>::process(const Message& msg) noexcept {
+    const uint8_t spec = spec_of(msg.symbol);
+    if (LIKELY(spec != UNASSIGNED)) {
+        // An id-keyed message's symbol is only a hint (see Message.h)
+        auto owns = [&msg](auto& manager) noexcept {
+            return manager.find_order(msg.order_id) != manager.INVALID_HANDLE;
+        };
+        if (!is_order_keyed(msg.type) || dispatch(spec, owns, std::index_sequence_for<Specs...>{})) {
+            auto apply = [&msg](auto& manager) noexcept { return manager.process(msg); };
+            return dispatch(spec, apply, std::index_sequence_for<Specs...>{});
+        }
+    }
+
+    switch (msg.type) {
+        case MessageType::CANCEL_ORDER:
+        case MessageType::MODIFY_ORDER:
+        case MessageType::EXECUTE_ORDER:
+            return route_by_id(msg);
+        case MessageType::TRADE:
+        case MessageType::HEARTBEAT:
+            return true;  // No resting-book effect
+        default:
+            ++unroutable_messages_;
+            return false;
+    }
+}
+
+template<BookSpecification... Specs>
+bool BookRegistry<Specs...>::route_by_id(const Message& msg) noexcept {
+    // Cold path: the first manager that knows the id owns the order
+    bool found = false;
+    bool result = false;
+    auto probe = [&](auto& manager) noexcept {
+        if (!found && manager->find_order(msg.order_id) != manager->INVALID_HANDLE) {
+            found = true;
+            result = manager->process(msg);
+        }
+    };
+    std::apply([&](auto&... managers) { (probe(managers), ...); }, managers_);
+
+    if (!found) {
+        ++unroutable_messages_;
+    }
+    return result;
+}
+
+template<BookSpecification... Specs>
+size_t BookRegistry<Specs...>::order_count() const noexcept {
+    return std::apply([](const auto&... managers) { return (size_t{0} + ... + managers->order_count()); },
+                      managers_);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Types.h"
+#include <concepts>
+#include <limits>
+
+// ============================================================================
+// BOOK SPECIFICATIONS
+// ============================================================================
+//
+// A book specification fixes, at compile time, everything the order book,
+// its level storage and its order pool size themselves by: the integer
+// widths of stored prices, quantities and pool handles, the valid tick
+// range, the per-side level window and how the pool lays out orders.
+// Instruments with small tick ranges get narrow types and a window
+// covering their whole range; the default spec reproduces the Config
+// constants.
+
+// How BasicOrderPool stores an order's hot fields (quantity, price, FIFO
+// links) relative to its cold ones (id, symbol, side). SPLIT pays off for
+// books whose owner walks queues (matching, queue position); feed books
+// that resolve every update by id touch both halves, so they default to
+// INTERLEAVED.
+enum class OrderLayout : uint8_t {
+    INTERLEAVED,    // One 32-byte record per order
+    SPLIT           // Parallel hot and cold arrays: queue walks and fills
+                    // stream 16-byte hot records, four per cache line
+};
+
+// Widest tick range a book can cover: the level occupancy bitmap has three
+// 64-way levels, so a range is a whole number of 64-tick words and at
+// most 64^3 = 262,144 ticks. A wider instrument (e.g. a high-priced ETF at
+// a fine tick) needs a coarser tick or MinPrice raised to cut the range.
+constexpr size_t MAX_BOOK_PRICE_LEVELS = 64 * 64 * 64;
+
+// Stored tick price: unsigned, no wider than the feed's Price
+template<typename T>
+concept TickType = std::unsigned_integral<T> && sizeof(T) <= sizeof(Price);
+
+// Stored share/contract quantity: unsigned, no wider than the feed's Quantity
+template<typename T>
+concept LotType = std::unsigned_integral<T> && sizeof(T) <= sizeof(Quantity);
+
+// Pool slot index; the type's maximum is reserved as the invalid handle
+template<typename T>
+concept HandleType = std::unsigned_integral<T> && sizeof(T) <= sizeof(uint32_t);
+
+/**
+ * Compile-time book parameters
+ *
+ * Prices outside [MinPrice, MaxPrice] are rejected. 0 and MaxPrice + 1
+ * serve as empty-side sentinels, so both must be representable and
+ * outside the range. The range holds a multiple of 64 ticks, at most
+ * MAX_BOOK_PRICE_LEVELS. Level totals and counts share the quantity and
+ * handle widths.
+ */
+template<TickType PriceT, LotType QuantityT, HandleType HandleT,
+         PriceT MinPrice, PriceT MaxPrice, size_t MaxOrders,
+         size_t WindowSize, size_t OverflowSlots,
+         OrderLayout Layout = OrderLayout::INTERLEAVED>
+struct BookSpec {
+    using price_type = PriceT;
+    using quantity_type = QuantityT;
+    using handle_type = HandleT;
+
+    static constexpr price_type MIN_PRICE = MinPrice;
+    static constexpr price_type MAX_PRICE = MaxPrice;
+    static constexpr size_t PRICE_LEVELS = size_t{MaxPrice} - MinPrice + 1;
+    static constexpr size_t MAX_ORDERS = MaxOrders;
+    static constexpr size_t WINDOW_SIZE = WindowSize;
+    static constexpr size_t OVERFLOW_SLOTS = OverflowSlots;
+    static constexpr handle_type INVALID_HANDLE = std::numeric_limits<handle_type>::max();
+    static constexpr OrderLayout ORDER_LAYOUT = Layout;
+
+    static_assert(MinPrice >= 1, "Price 0 is the NO_PRICE sentinel");
+    static_assert(MinPrice <= MaxPrice, "Empty price range");
+    static_assert(MaxPrice < std::numeric_limits<PriceT>::max(), "MaxPrice + 1 must fit the price type");
+    static_assert(PRICE_LEVELS % 64 == 0, "The price range must be a multiple of 64 ticks");
+    static_assert(PRICE_LEVELS <= MAX_BOOK_PRICE_LEVELS, "The price range exceeds MAX_BOOK_PRICE_LEVELS");
+    static_assert(MaxOrders >= 1 && MaxOrders < std::numeric_limits<HandleT>::max(),
+                  "Every slot needs a handle below INVALID_HANDLE");
+    static_assert(is_power_of_2(WindowSize), "WindowSize must be power of 2");
+    static_assert(WindowSize >= 8, "WindowSize must be at least 8");
+    static_assert(WindowSize <= PRICE_LEVELS, "Window larger than the price range");
+    static_assert(is_power_of_2(OverflowSlots), "OverflowSlots must be power of 2");
+};
+
+/**
+ * Anything shaped like a BookSpec: what BasicOrderBook, BasicLevelWindow,
+ * BasicOrderPool and BasicBookManager are constrained on
+ */
+template<typename S>
+concept BookSpecification = requires {
+    typename S::price_type;
+    typename S::quantity_type;
+    typename S::handle_type;
+    { S::MIN_PRICE } -> std::convertible_to<typename S::price_type>;
+    { S::MAX_PRICE } -> std::convertible_to<typename S::price_type>;
+    { S::PRICE_LEVELS } -> std::convertible_to<size_t>;
+    { S::MAX_ORDERS } -> std::convertible_to<size_t>;
+    { S::WINDOW_SIZE } -> std::convertible_to<size_t>;
+    { S::OVERFLOW_SLOTS } -> std::convertible_to<size_t>;
+    { S::INVALID_HANDLE } -> std::convertible_to<typename S::handle_type>;
+    { S::ORDER_LAYOUT } -> std::convertible_to<OrderLayout>;
+} && TickType<typename S::price_type>
+  && LotType<typename S::quantity_type>
+  && HandleType<typename S::handle_type>
+  && (S::MIN_PRICE >= 1)
+  && (S::MAX_PRICE < std::numeric_limits<typename S::price_type>::max())
+  && (S::PRICE_LEVELS % 64 == 0) && (S::PRICE_LEVELS <= MAX_BOOK_PRICE_LEVELS)
+  && (S::MAX_ORDERS < std::numeric_limits<typename S::handle_type>::max())
+  && is_power_of_2(S::WINDOW_SIZE) && (S::WINDOW_SIZE <= S::PRICE_LEVELS)
+  && is_power_of_2(S::OVERFLOW_SLOTS);
+
+// Equities at the Config sizes; OrderBook, OrderPool and BookManager
+using DefaultBookSpec = BookSpec<Price, Quantity, uint32_t,
+                                 Config::MIN_PRICE, Config::MAX_PRICE, Config::MAX_ORDERS,
+                                 Config::LEVEL_WINDOW_SIZE, Config::LEVEL_OVERFLOW_SLOTS>;
+
+// Narrow instruments (futures, low-priced names): 16-bit prices and
+// handles, and a window spanning all Levels ticks (a power of 2, at least
+// 64) so nothing overflows.
+// With 1024 levels each side's window is 12 KB and stays in L1.
+template<size_t Levels, size_t MaxOrders>
+using CompactBookSpec = BookSpec<uint16_t, Quantity, uint16_t,
+                                 1, static_cast<uint16_t>(Levels), MaxOrders, Levels, 16>;
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Types.h"
+#include "RingPolicies.h"
+#include <atomic>
+#include <algorithm>
+
+/**
+ * Lock-Free Single Producer Broadcast (SPMC) Ring Buffer
+ *
+ * Every consumer sees every item, Disruptor style: items stay in place and
+ * each consumer advances its own cursor over them.
+ *
+ * Key features:
+ * - One cache-line-isolated cursor per consumer, no shared consumer state
+ * - Producer is gated by the slowest consumer; it caches the minimum
+ *   cursor and rescans only when the cached value says the ring is full
+ * - Consumers read slots in place (no copy, no RMW)
+ * - Power-of-2 sizing; all Size slots are usable
+ *
+ * Usage:
+ *   BroadcastRing<BookUpdate, 1024, 3> ring;     // strategy, risk, recorder
+ *
+ *   // Producer thread:
+ *   ring.try_publish(update);
+ *
+ *   // Consumer thread i (0 <= i < 3):
+ *   ring.consume_all(i, [](const BookUpdate& u) { ... });
+ */
+template<typename T, size_t Size, size_t Consumers, typename Stats = AtomicRingStats>
+class BroadcastRing {
+    static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
+    static_assert(Size >= 2, "Size must be at least 2");
+    static_assert(Consumers >= 1, "At least one consumer required");
+
+public:
+    BroadcastRing() = default;
+    ~BroadcastRing() = default;
+
+    // Non-copyable, non-movable (contains atomics)
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+    BroadcastRing(BroadcastRing&&) = delete;
+    BroadcastRing& operator=(BroadcastRing&&) = delete;
+
+    // Producer interface (single thread only)
+    bool try_publish(const T& item) noexcept;
+    T* reserve() noexcept;
+    void commit() noexcept;
+
+    // Consumer interface (one thread per consumer index)
+    bool try_pop(size_t consumer, T& item) noexcept;
+    template<typename Callback>
+    size_t consume_all(size_t consumer, Callback&& callback, size_t max_items = Size) noexcept;
+
+    // Status queries (can be called from any thread)
+    uint64_t published() const noexcept { return published_.load(std::memory_order_acquire); }
+    uint64_t consumed(size_t consumer) const noexcept {
+        return cursors_[consumer].next.load(std::memory_order_acquire);
+    }
+    size_t lag(size_t consumer) const noexcept { return published() - consumed(consumer); }
+    size_t capacity() const noexcept { return Size; }
+    static constexpr size_t consumer_count() noexcept { return Consumers; }
+
+    // Performance monitoring (producer side; per-consumer progress is consumed())
+    uint64_t total_pushes() const noexcept { return stats_.pushes(); }
+    uint64_t failed_pushes() const noexcept { return stats_.failed_pushes(); }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cursor {
+        std::atomic<uint64_t> next{0};      // Next sequence this consumer reads
+        uint64_t cached_published = 0;     // Consumer's copy of published_
+    };
+
+    // Producer line: publish cursor plus its private gating cache
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published_{0};
+    uint64_t cached_min_consumed_ = 0;
+
+    // One line per consumer cursor
+    Cursor cursors_[Consumers];
+
+    alignas(CACHE_LINE_SIZE) T buffer_[Size];
+
+    [[no_unique_address]] Stats stats_;
+
+    // Bit mask for fast modulo operation
+    static constexpr size_t MASK = Size - 1;
+
+    // Producer-side gating: true if sequence seq may be written
+    bool has_room(uint64_t seq) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename T, size_t Size, size_t Consumers, typename Stats>
+bool BroadcastRing<T, Size, Consumers, Stats>::has_room(uint64_t seq) noexcept {
+    if (LIKELY(seq - cached_min_consumed_ < Size)) {
+        return true;
+    }
+
+    // Rescan the consumers only when the cached minimum says we are full
+    uint64_t min_consumed = cursors_[0].next.load(std::memory_order_acquire);
+    for (size_t i = 1; i < Consumers; ++i) {
+        min_consumed = std::min(min_consumed, cursors_[i].next.load(std::memory_order_acquire));
+    }
+    cached_min_consumed_ = min_consumed;
+    return seq - min_consumed < Size;
+}
+
+template<typename T, size_t Size, size_t Consumers, typename Stats>
+bool BroadcastRing<T, Size, Consumers, Stats>::try_publish(const T& item) noexcept {
+    T* slot = reserve();
+    if (UNLIKELY(slot == nullptr)) {
+        return false;
+    }
+    *slot = item;
+    commit();
+    return true;
+}
+
+template<typename T, size_t Size, size_t Consumers, typename Stats>
+T* BroadcastRing<T, Size, Consumers, Stats>::reserve() noexcept {
+    const uint64_t seq = published_.load(std::memory_order_relaxed);
+    if (UNLIKELY(!has_room(seq))) {
+        stats_.record_failed_push(1);
+        return nullptr;  // Slowest consumer is a full lap behind
+    }
+    return &buffer_[seq & MASK];
+}
+
+template<typename T, size_t Size, size_t Consumers, typename Stats>
+void BroadcastRing<T, Size, Consumers, Stats>::commit() noexcept {
+    const uint64_t seq = published_.load(std::memory_order_relaxed);
+    published_.store(seq + 1, std::memory_order_release);
+    stats_.record_push(1);
+}
+
+template<typename T, size_t Size, size_t Consumers, typename Stats>
+bool BroadcastRing<T, Size, Consumers, Stats>::try_pop(size_t consumer, T& item) noexcept {
+    Cursor& cursor = cursors_[consumer];
+    const uint64_t next = cursor.next.load(std::memory_order_relaxed);
+
+    if (UNLIKELY(next == cursor.cached_published)) {
+        cursor.cached_published = published_.load(std::memory_order_acquire);
+        if (next == cursor.cached_published) {
+            return false;  // Nothing new for this consumer
+        }
+    }
+
+    item = buffer_[next & MASK];
+    cursor.next.store(next + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t Size, size_t Consumers, typename Stats>
+template<typename Callback>
+size_t BroadcastRing<T, Size, Consumers, Stats>::consume_all(size_t consumer, Callback&& callback,
+                                                             size_t max_items) noexcept {
+    Cursor& cursor = cursors_[consumer];
+    const uint64_t next = cursor.next.load(std::memory_order_relaxed);
+
+    if (cursor.cached_published - next < max_items) {
+        cursor.cached_published = published_.load(std::memory_order_acquire);
+    }
+    const size_t count = std::min<uint64_t>(cursor.cached_published - next, max_items);
+
+    // Slots are shared with the other consumers: read-only access
+    for (size_t i = 0; i < count; ++i) {
+        callback(static_cast<const T&>(buffer_[(next + i) & MASK]));
+    }
+
+    if (count != 0) {
+        cursor.next.store(next + count, std::memory_order_release);
+    }
+    return count;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Types.h"
+#include "Message.h"
+#include "TSCTimer.h"
+#include <immintrin.h>
+#include <memory>
+#include <span>
+
+/**
+ * Capture file header. The file is this header followed by back-to-back
+ * 64-byte Message records exactly as they sit in memory, so a mapping of
+ * the file is an array of cache-line aligned Messages.
+ */
+struct alignas(CACHE_LINE_SIZE) CaptureHeader {
+    static constexpr char MAGIC[8] = {'H', 'F', 'T', 'C', 'A', 'P', '0', '1'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;       // sizeof(Message) at capture time
+    uint64_t created_ns;        // Wall clock when the file was created
+};
+
+static_assert(sizeof(CaptureHeader) == CACHE_LINE_SIZE, "Records must start cache-line aligned");
+
+/**
+ * Append-Only Message Recorder
+ *
+ * Key features:
+ * - Fixed 64-byte records: the normalized Message, timestamp included,
+ *   copied verbatim (no encoding step)
+ * - Records are batched in a user-space buffer and written with one
+ *   write() per BUFFER_RECORDS messages
+ * - Reopening an existing capture appends to it; a torn final record
+ *   left by a crash is cut off first
+ * - Meant for a recorder thread draining its own ring (drain()), so the
+ *   write syscalls never land on the book thread
+ *
+ * Usage:
+ *   CaptureRecorder recorder;
+ *   recorder.open("/data/itch-2026-10-14.cap");
+ *
+ *   while (running) recorder.drain(ring);     // Recorder thread
+ *   recorder.close();                         // Flushes
+ */
+class CaptureRecorder {
+public:
+    static constexpr size_t BUFFER_RECORDS = 1024;     // 64 KB per write()
+
+    CaptureRecorder();
+    ~CaptureRecorder();
+
+    // Non-copyable, non-movable (owns the file descriptor)
+    CaptureRecorder(const CaptureRecorder&) = delete;
+    CaptureRecorder& operator=(const CaptureRecorder&) = delete;
+
+    // Creates the file, or appends when it holds a valid capture; a
+    // truncate request or a foreign file starts it afresh
+    bool open(const char* path, bool truncate = false);
+    bool flush() noexcept;
+    void close() noexcept;
+    bool is_open() const noexcept { return fd_ >= 0; }
+
+    // Queue one record; false once a write has failed
+    bool record(const Message& msg) noexcept {
+        buffer_[buffered_++] = msg;
+        if (UNLIKELY(buffered_ == BUFFER_RECORDS)) {
+            return flush();
+        }
+        return !failed_;
+    }
+
+    // Record everything pending in a ring (any ring with consume_all)
+    template<typename Ring>
+    size_t drain(Ring& ring, size_t max_items = BUFFER_RECORDS) noexcept {
+        return ring.consume_all([this](const Message& msg) { record(msg); }, max_items);
+    }
+
+    // Status queries
+    uint64_t records() const noexcept { return records_ + buffered_; }
+    bool failed() const noexcept { return failed_; }
+
+private:
+    int fd_ = -1;
+    std::unique_ptr<Message[]> buffer_;
+    size_t buffered_ = 0;
+    uint64_t records_ = 0;        // Already in the file
+    bool failed_ = false;
+};
+
+/**
+ * Memory-Mapped Capture Replayer
+ *
+ * Key features:
+ * - The file is mapped read-only with MADV_SEQUENTIAL (aggressive
+ *   read-ahead, pages dropped behind the cursor): replay is a walk over
+ *   the mapping with no read() per message
+ * - Messages are handed to the sink straight from the mapping, no copy
+ * - Full-speed or paced: paced replay spins on the TSC until each
+ *   message's offset from the first, scaled by a speed factor, has
+ *   elapsed (timestamps are taken as nanoseconds)
+ * - A truncated tail record is ignored
+ *
+ * Usage:
+ *   CaptureReplayer replay;
+ *   if (!replay.open(path)) return;
+ *
+ *   replay.replay([&](const Message& msg) { books.process(msg); });
+ *   replay.replay_paced([&](const Message& msg) { ring.push(msg); }, timer);
+ */
+class CaptureReplayer {
+public:
+    CaptureReplayer() = default;
+    ~CaptureReplayer();
+
+    // Non-copyable, non-movable (owns the mapping)
+    CaptureReplayer(const CaptureReplayer&) = delete;
+    CaptureReplayer& operator=(const CaptureReplayer&) = delete;
+
+    bool open(const char* path);
+    void close() noexcept;
+
+    // Records in the mapping
+    std::span<const Message> messages() const noexcept { return {records_, count_}; }
+    size_t size() const noexcept { return count_; }
+    const CaptureHeader* header() const noexcept { return static_cast<const CaptureHeader*>(mapping_); }
+
+    // Feed every record to sink(const Message&); returns the number fed
+    template<typename Sink>
+    size_t replay(Sink&& sink) const;
+
+    // As replay(), releasing each record no earlier than its original
+    // offset from the first record divided by speed
+    template<typename Sink>
+    size_t replay_paced(Sink&& sink, const TSCTimer& timer, double speed = 1.0) const;
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_bytes_ = 0;
+    const Message* records_ = nullptr;
+    size_t count_ = 0;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename Sink>
+size_t CaptureReplayer::replay(Sink&& sink) const {
+    for (size_t i = 0; i < count_; ++i) {
+        sink(records_[i]);
+    }
+    return count_;
+}
+
+template<typename Sink>
+size_t CaptureReplayer::replay_paced(Sink&& sink, const TSCTimer& timer, double speed) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    const double cycles_per_ns = timer.get_frequency_ghz() / (speed > 0 ? speed : 1.0);
+    const Timestamp first = records_[0].timestamp;
+    const uint64_t start = timer.now();
+
+    for (size_t i = 0; i < count_; ++i) {
+        const Message& msg = records_[i];
+        // Out-of-order stamps are released at once rather than waited for
+        const Timestamp offset = msg.timestamp > first ? msg.timestamp - first : 0;
+        const uint64_t due = start + static_cast<uint64_t>(static_cast<double>(offset) * cycles_per_ns);
+        while (timer.now() < due) {
+            _mm_pause();
+        }
+        sink(msg);
+    }
+    return count_;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Types.h"
+#include "BookManager.h"
+#include "Message.h"
+#include <algorithm>
+#include <span>
+#include <sys/types.h>
+
+/**
+ * Checkpoint file header. The file is this header, a bitmap of the
+ * registered symbols, then one CheckpointOrder per resting order: book by
+ * book, bids then asks, each side best level first and each level in
+ * time priority, so adding the records back in file order rebuilds every
+ * queue exactly.
+ */
+struct alignas(CACHE_LINE_SIZE) CheckpointHeader {
+    static constexpr char MAGIC[8] = {'H', 'F', 'T', 'C', 'K', 'P', '0', '1'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;       // sizeof(CheckpointOrder)
+    uint64_t created_ns;        // Wall clock when the checkpoint was taken
+    uint64_t last_sequence;     // Feed sequence of the last message applied
+    uint64_t order_count;
+    uint32_t max_symbols;       // Bits in the symbol bitmap
+    uint32_t reserved;
+};
+
+struct CheckpointOrder {
+    OrderId id;
+    Price price;
+    Quantity quantity;
+    SymbolId symbol;
+    Side side;
+};
+
+static_assert(sizeof(CheckpointHeader) == CACHE_LINE_SIZE);
+
+// Registered-symbol bitmap, rounded to whole cache lines
+constexpr size_t CHECKPOINT_SYMBOL_BYTES =
+    (Config::MAX_SYMBOLS + 8 * CACHE_LINE_SIZE - 1) / (8 * CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+
+// Write books' state as of feed sequence last_sequence to path, through
+// path.tmp and an atomic rename, so path is always absent or complete.
+// Blocks for the whole write; Checkpointer runs it off the book thread.
+bool write_checkpoint(const BookManager& books, uint64_t last_sequence, const char* path) noexcept;
+
+/**
+ * Non-Blocking Book Checkpointer
+ *
+ * Key features:
+ * - begin() forks: the child writes the copy-on-write image of the books
+ *   as they stood at that instant and exits, while the book thread
+ *   carries on with the next ring batch after one fork() call
+ * - The fork cost is the page-table copy, plus one page copy on the
+ *   first write to each page afterwards; pool, index and levels in huge
+ *   pages (HugePageArena) keep the table small, at 2 MB per such copy
+ * - poll() reaps the child without blocking and counts the outcome
+ *
+ * Usage:
+ *   Checkpointer checkpoints;
+ *
+ *   // Book thread, between ring batches:
+ *   checkpoints.poll();
+ *   if (due && !checkpoints.in_progress()) {
+ *       checkpoints.begin(books, last_sequence, "/data/books.ckp");
+ *   }
+ */
+class Checkpointer {
+public:
+    Checkpointer() = default;
+    ~Checkpointer();
+
+    // Non-copyable, non-movable (owns the child process)
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    // Start a checkpoint in a child process; false while one is still
+    // running or if fork fails
+    bool begin(const BookManager& books, uint64_t last_sequence, const char* path) noexcept;
+
+    // Reap a finished child; returns true while one is still running
+    bool poll() noexcept;
+    // Block until the running checkpoint (if any) ends; true if it succeeded
+    bool wait() noexcept;
+
+    // Status queries
+    bool in_progress() const noexcept { return child_ > 0; }
+    uint64_t completed() const noexcept { return completed_; }
+    uint64_t failed() const noexcept { return failed_; }
+    uint64_t last_sequence() const noexcept { return last_sequence_; }   // Of the last completed
+
+private:
+    pid_t child_ = -1;
+    uint64_t pending_sequence_ = 0;
+    uint64_t last_sequence_ = 0;
+    uint64_t completed_ = 0;
+    uint64_t failed_ = 0;
+
+    void finish(int status) noexcept;
+};
+
+/**
+ * Memory-Mapped Checkpoint Loader
+ *
+ * Warm restart: map the last checkpoint, re-add its orders, then replay
+ * only the capture records after its sequence instead of the whole day.
+ *
+ * Usage:
+ *   CheckpointLoader checkpoint;
+ *   BookManager books;
+ *   if (checkpoint.open(path) && checkpoint.restore(books)) {
+ *       for (const Message& msg : CheckpointLoader::tail(replay.messages(),
+ *                                                        checkpoint.last_sequence())) {
+ *           books.process(msg);
+ *       }
+ *   }
+ */
+class CheckpointLoader {
+public:
+    CheckpointLoader() = default;
+    ~CheckpointLoader();
+
+    // Non-copyable, non-movable (owns the mapping)
+    CheckpointLoader(const CheckpointLoader&) = delete;
+    CheckpointLoader& operator=(const CheckpointLoader&) = delete;
+
+    // False for a missing, foreign, incompatible or truncated file
+    bool open(const char* path);
+    void close() noexcept;
+
+    // Register the checkpoint's symbols and add its orders to an empty
+    // manager (allocates the books); false if any order is rejected
+    bool restore(BookManager& books) const;
+
+    const CheckpointHeader* header() const noexcept { return static_cast<const CheckpointHeader*>(mapping_); }
+    uint64_t last_sequence() const noexcept { return header()->last_sequence; }
+    std::span<const CheckpointOrder> orders() const noexcept { return {orders_, header()->order_count}; }
+    bool has_symbol(SymbolId symbol) const noexcept;
+
+    // The messages of a capture (in feed sequence order) that come after
+    // a checkpoint taken at last_sequence
+    static std::span<const Message> tail(std::span<const Message> messages, uint64_t last_sequence) noexcept {
+        const auto first = std::partition_point(messages.begin(), messages.end(),
+            [last_sequence](const Message& msg) { return msg.sequence <= last_sequence; });
+        return messages.subspan(static_cast<size_t>(first - messages.begin()));
+    }
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_bytes_ = 0;
+    const uint8_t* symbols_ = nullptr;
+    const CheckpointOrder* orders_ = nullptr;
+};
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "Types.h"
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <span>
+
+// ============================================================================
+// MoldUDP64 FRAMING
+// ============================================================================
+
+namespace mold {
+    // Downstream packet header: session, first sequence, message count
+    constexpr size_t SESSION_SIZE = 10;
+    constexpr size_t SEQUENCE_OFFSET = 10;
+    constexpr size_t COUNT_OFFSET = 18;
+    constexpr size_t HEADER_SIZE = 20;
+
+    constexpr uint16_t END_OF_SESSION = 0xFFFF;     // Count value of the final packet
+
+    struct Header {
+        uint64_t sequence;      // Sequence of the packet's first message
+        uint16_t count;         // 0 for a heartbeat
+    };
+
+    inline bool parse_header(const uint8_t* data, size_t length, Header& out) noexcept {
+        if (UNLIKELY(length < HEADER_SIZE)) {
+            return false;
+        }
+        uint64_t sequence;
+        uint16_t count;
+        std::memcpy(&sequence, data + SEQUENCE_OFFSET, sizeof(sequence));
+        std::memcpy(&count, data + COUNT_OFFSET, sizeof(count));
+        out.sequence = __builtin_bswap64(sequence);
+        out.count = __builtin_bswap16(count);
+        return true;
+    }
+}
+
+/**
+ * A/B Line Arbiter (MoldUDP64)
+ *
+ * Merges the two redundant copies of a feed into one gap-free,
+ * duplicate-free message stream before anything reaches the parser.
+ *
+ * Key features:
+ * - First arrival wins: a packet advances the stream from whichever line
+ *   delivers it first; the copy from the other line is dropped as a
+ *   duplicate, and a partial overlap delivers only its new messages
+ * - A packet beyond a gap is stashed (fixed slots, no allocation) until
+ *   the other line fills the gap, then the stash drains in order
+ * - A gap that persists for gap_timeout packets, or finds the stash
+ *   full, is declared lost: the stream skips to the oldest packet held
+ *   (stashed, or the one that found the stash full) and the missing
+ *   messages are counted
+ * - Heartbeats that reveal a gap are stashed like data packets, so a loss
+ *   at the end of a burst is detected too
+ * - Each message goes to the parser with its own feed sequence
+ *   (set_sequence + parse_message), so the book sees feed sequences
+ *
+ * Usage:
+ *   LineArbiter<ItchParser<ItchRingSink<Ring>>> arbiter(parser);
+ *   arbiter.on_packet(LINE_A, data, length);    // From either line, any order
+ */
+template<typename Parser>
+class LineArbiter {
+public:
+    static constexpr size_t MAX_PACKET = 2048;      // Above any MoldUDP64 datagram
+    static constexpr size_t STASH_SLOTS = 64;
+    static constexpr uint8_t LINE_A = 0;
+    static constexpr uint8_t LINE_B = 1;
+
+    // expected_sequence 0 synchronises on the first packet seen
+    explicit LineArbiter(Parser& parser, uint32_t gap_timeout = 256,
+                         uint64_t expected_sequence = 0);
+
+    // Non-copyable, non-movable (holds a reference and large stash)
+    LineArbiter(const LineArbiter&) = delete;
+    LineArbiter& operator=(const LineArbiter&) = delete;
+
+    // One datagram from a line; returns the messages handed to the parser
+    size_t on_packet(uint8_t line, const uint8_t* data, size_t length) noexcept;
+
+    // Give up on the current gap now (e.g. from an idle timer)
+    size_t skip_gap() noexcept;
+
+    // Status queries
+    uint64_t next_sequence() const noexcept { return next_; }
+    bool in_gap() const noexcept { return stashed_ != 0; }
+    bool session_ended() const noexcept { return ended_; }
+
+    // Performance monitoring
+    uint64_t packets(uint8_t line) const noexcept { return packets_[line]; }
+    uint64_t first_arrivals(uint8_t line) const noexcept { return wins_[line]; }
+    uint64_t duplicate_packets() const noexcept { return duplicates_; }
+    uint64_t gaps() const noexcept { return gaps_; }
+    uint64_t recovered_gaps() const noexcept { return recovered_; }
+    uint64_t lost_messages() const noexcept { return lost_; }
+    uint64_t malformed_packets() const noexcept { return malformed_; }
+
+private:
+    struct StashSlot {
+        uint64_t sequence;
+        uint16_t count;
+        uint16_t length;
+        bool used;
+        uint8_t data[MAX_PACKET];
+    };
+
+    Parser& parser_;
+    const uint32_t gap_timeout_;
+    uint64_t next_;
+    bool synced_;
+    bool ended_ = false;
+
+    std::unique_ptr<StashSlot[]> stash_;
+    size_t stashed_ = 0;
+    uint32_t stalled_packets_ = 0;     // Packets seen since the gap opened
+
+    std::array<uint64_t, 2> packets_{};
+    std::array<uint64_t, 2> wins_{};
+    uint64_t duplicates_ = 0;
+    uint64_t gaps_ = 0;
+    uint64_t recovered_ = 0;
+    uint64_t lost_ = 0;
+    uint64_t malformed_ = 0;
+
+    size_t accept(uint8_t line, const uint8_t* data, size_t length,
+                  const mold::Header& header) noexcept;
+    size_t deliver(const uint8_t* data, size_t length, uint64_t sequence,
+                   uint16_t count) noexcept;
+    bool stash(const uint8_t* data, size_t length, const mold::Header& header) noexcept;
+    size_t drain_stash() noexcept;
+    size_t skip_to(uint64_t limit) noexcept;
+};
+
+/**
+ * What a receive backend provides: receive() pulls one batch without
+ * blocking and returns its size; packet(i) exposes datagram i of it until
+ * the next receive(). UdpReceiver (recvmmsg) implements this; an AF_XDP
+ * or ef_vi backend plugs in the same way.
+ */
+template<typename R>
+concept PacketReceiver = requires(R r, size_t i) {
+    { r.receive() } -> std::same_as<size_t>;
+    { r.packet(i) } -> std::same_as<std::span<const uint8_t>>;
+};
+
+/**
+ * Batched UDP Receiver (kernel stack)
+ *
+ * Key features:
+ * - recvmmsg() fills up to BATCH datagrams per syscall into buffers
+ *   allocated once at open()
+ * - Non-blocking; with SO_BUSY_POLL the kernel busy-polls the NIC queue
+ *   inside the call instead of waiting for an interrupt
+ * - Joins the multicast group when given one (binds unicast otherwise,
+ *   e.g. a replay sender on loopback)
+ * - Large SO_RCVBUF so bursts queue in the kernel instead of dropping
+ *
+ * Usage:
+ *   UdpReceiver line_a;
+ *   line_a.open("233.54.12.1", 26400, "10.1.0.5");
+ *
+ *   for (size_t n = line_a.receive(), i = 0; i < n; ++i) {
+ *       std::span<const uint8_t> datagram = line_a.packet(i);
+ *   }
+ */
+class UdpReceiver {
+public:
+    static constexpr size_t BATCH = 64;
+    static constexpr size_t PACKET_BYTES = 2048;
+
+    struct Options {
+        int busy_poll_us = 50;                    // 0 leaves SO_BUSY_POLL unset
+        int receive_buffer_bytes = 8 << 20;
+    };
+
+    UdpReceiver();
+    ~UdpReceiver();
+
+    // Non-copyable, non-movable (owns the socket and buffers)
+    UdpReceiver(const UdpReceiver&) = delete;
+    UdpReceiver& operator=(const UdpReceiver&) = delete;
+
+    // Setup (allocates, syscalls). port 0 picks an ephemeral port.
+    bool open(const char* address, uint16_t port, const char* interface_address,
+              const Options& options);
+    bool open(const char* address, uint16_t port, const char* interface_address = nullptr) {
+        return open(address, port, interface_address, Options{});
+    }
+    void close() noexcept;
+
+    // Hot path
+    size_t receive() noexcept;
+    std::span<const uint8_t> packet(size_t i) const noexcept;
+
+    // Status queries
+    bool is_open() const noexcept { return fd_ >= 0; }
+    uint16_t port() const noexcept { return port_; }
+    bool busy_polling() const noexcept { return busy_polling_; }
+
+    // Performance monitoring
+    uint64_t datagrams() const noexcept { return datagrams_; }
+    uint64_t truncated_datagrams() const noexcept { return truncated_; }
+    uint64_t receive_calls() const noexcept { return calls_; }
+
+private:
+    struct Batch;
+
+    int fd_ = -1;
+    uint16_t port_ = 0;
+    bool busy_polling_ = false;
+    std::unique_ptr<Batch> batch_;
+
+    uint64_t datagrams_ = 0;
+    uint64_t truncated_ = 0;
+    uint64_t calls_ = 0;
+};
+
+static_assert(PacketReceiver<UdpReceiver>);
+
+/**
+ * Market Data Receive Stage
+ *
+ * Polls the A and B lines, arbitrates them and parses the merged stream.
+ * With an ItchParser over an ItchRingSink the parser decodes each message
+ * straight into a reserved ring slot (reserve/commit), so the book thread
+ * only ever sees the gap-resolved, de-duplicated stream.
+ *
+ * Usage:
+ *   ItchRingSink<Ring> sink{ring};
+ *   ItchParser<ItchRingSink<Ring>> parser(sink);
+ *   FeedHandler<decltype(parser)> feed(parser, line_a, line_b);
+ *
+ *   while (running) feed.poll();                 // Pinned feed thread
+ */
+template<typename Parser, PacketReceiver Receiver = UdpReceiver>
+class FeedHandler {
+public:
+    FeedHandler(Parser& parser, Receiver& line_a, Receiver& line_b, uint32_t gap_timeout = 256)
+        : arbiter_(parser, gap_timeout), lines_{&line_a, &line_b} {}
+
+    // One batch from each line; returns the messages passed to the parser
+    size_t poll() noexcept {
+        size_t delivered = 0;
+        for (uint8_t line = 0; line < 2; ++line) {
+            Receiver& rx = *lines_[line];
+            const size_t n = rx.receive();
+            for (size_t i = 0; i < n; ++i) {
+                const std::span<const uint8_t> datagram = rx.packet(i);
+                delivered += arbiter_.on_packet(line, datagram.data(), datagram.size());
+            }
+        }
+        return delivered;
+    }
+
+    LineArbiter<Parser>& arbiter() noexcept { return arbiter_; }
+    const LineArbiter<Parser>& arbiter() const noexcept { return arbiter_; }
+
+private:
+    LineArbiter<Parser> arbiter_;
+    std::array<Receiver*, 2> lines_;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename Parser>
+LineArbiter<Parser>::LineArbiter(Parser& parser, uint32_t gap_timeout, uint64_t expected_sequence)
+    : parser_(parser),
+      gap_timeout_(gap_timeout == 0 ? 1 : gap_timeout),
+      next_(expected_sequence),
+      synced_(expected_sequence != 0),
+      stash_(std::make_unique<StashSlot[]>(STASH_SLOTS)) {
+    for (size_t i = 0; i < STASH_SLOTS; ++i) {
+        stash_[i].used = false;
+    }
+}
+
+template<typename Parser>
+size_t LineArbiter<Parser>::on_packet(uint8_t line, const uint8_t* data, size_t length) noexcept {
+    mold::Header header;
+    if (UNLIKELY(line > LINE_B || !mold::parse_header(data, length, header))) {
+        ++malformed_;
+        return 0;
+    }
+    ++packets_[line];
+
+    if (UNLIKELY(header.count == mold::END_OF_SESSION)) {
+        ended_ = true;
+        return 0;
+    }
+    if (UNLIKELY(!synced_)) {
+        next_ = header.sequence;
+        synced_ = true;
+    }
+    return accept(line, data, length, header);
+}
+
+template<typename Parser>
+size_t LineArbiter<Parser>::accept(uint8_t line, const uint8_t* data, size_t length,
+                                   const mold::Header& header) noexcept {
+    // Common case: in sequence, from whichever line is ahead
+    if (LIKELY(header.sequence <= next_)) {
+        const uint64_t end = header.sequence + header.count;
+        if (end <= next_) {
+            if (header.count != 0) ++duplicates_;
+            return 0;   // Duplicate copy, or a heartbeat with nothing missing
+        }
+        ++wins_[line];
+        size_t delivered = deliver(data, length, header.sequence, header.count);
+        if (UNLIKELY(stashed_ != 0)) {
+            delivered += drain_stash();
+            if (stashed_ == 0) {
+                ++recovered_;   // The other line filled every hole
+            }
+        }
+        return delivered;
+    }
+
+    // Ahead of the stream: hold it until the other line fills the gap
+    if (stashed_ == 0) {
+        ++gaps_;
+        stalled_packets_ = 0;
+    }
+    const bool held = stash(data, length, header);
+    if (!held) {
+        // Stash full: this packet may itself sit inside the gap, ahead of
+        // everything stashed, so only the messages before it are lost
+        size_t delivered = skip_to(header.sequence);
+        delivered += accept(line, data, length, header);       // In sequence, or room again
+        return delivered;
+    }
+    if (++stalled_packets_ >= gap_timeout_) {
+        return skip_gap();
+    }
+    return 0;
+}
+
+template<typename Parser>
+size_t LineArbiter<Parser>::deliver(const uint8_t* data, size_t length, uint64_t sequence,
+                                    uint16_t count) noexcept {
+    // Skip messages already delivered from the other line's copy
+    const uint64_t skip = next_ - sequence;
+    size_t offset = mold::HEADER_SIZE;
+    size_t delivered = 0;
+    uint16_t i = 0;
+    for (; i < count; ++i) {
+        if (UNLIKELY(offset + 2 > length)) break;
+        uint16_t be_length;
+        std::memcpy(&be_length, data + offset, sizeof(be_length));
+        const size_t msg_length = __builtin_bswap16(be_length);
+        if (UNLIKELY(offset + 2 + msg_length > length)) break;
+
+        if (i >= skip) {
+            parser_.set_sequence(sequence + i);
+            parser_.parse_message(data + offset + 2, msg_length);
+            ++delivered;
+        }
+        offset += 2 + msg_length;
+    }
+    if (UNLIKELY(i != count)) {
+        ++malformed_;
+        lost_ += count - i;   // Truncated datagram: the rest is unrecoverable
+    }
+    next_ = sequence + count;
+    return delivered;
+}
+
+template<typename Parser>
+bool LineArbiter<Parser>::stash(const uint8_t* data, size_t length,
+                                const mold::Header& header) noexcept {
+    if (length > MAX_PACKET) {
+        ++malformed_;
+        return true;   // Cannot be a valid datagram; treat as consumed
+    }
+    for (size_t i = 0; i < STASH_SLOTS; ++i) {
+        StashSlot& slot = stash_[i];
+        if (slot.used && slot.sequence == header.sequence && slot.count >= header.count) {
+            ++duplicates_;
+            return true;   // Same packet already held from the other line
+        }
+    }
+    for (size_t i = 0; i < STASH_SLOTS; ++i) {
+        StashSlot& slot = stash_[i];
+        if (!slot.used) {
+            slot.sequence = header.sequence;
+            slot.count = header.count;
+            slot.length = static_cast<uint16_t>(length);
+            slot.used = true;
+            std::memcpy(slot.data, data, length);
+            ++stashed_;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Parser>
+size_t LineArbiter<Parser>::drain_stash() noexcept {
+    size_t delivered = 0;
+    bool progressed = true;
+    while (progressed && stashed_ != 0) {
+        progressed = false;
+        for (size_t i = 0; i < STASH_SLOTS; ++i) {
+            StashSlot& slot = stash_[i];
+            if (!slot.used || slot.sequence > next_) {
+                continue;
+            }
+            if (slot.sequence + slot.count > next_) {
+                delivered += deliver(slot.data, slot.length, slot.sequence, slot.count);
+            }
+            slot.used = false;
+            --stashed_;
+            progressed = true;
+        }
+    }
+    return delivered;
+}
+
+template<typename Parser>
+size_t LineArbiter<Parser>::skip_gap() noexcept {
+    return skip_to(UINT64_MAX);
+}
+
+template<typename Parser>
+size_t LineArbiter<Parser>::skip_to(uint64_t limit) noexcept {
+    if (stashed_ == 0) {
+        return 0;
+    }
+    // Skip to the oldest stashed packet, or to limit if that comes first
+    uint64_t oldest = limit;
+    for (size_t i = 0; i < STASH_SLOTS; ++i) {
+        if (stash_[i].used && stash_[i].sequence < oldest) {
+            oldest = stash_[i].sequence;
+        }
+    }
+    lost_ += oldest - next_;
+    next_ = oldest;
+
+    stalled_packets_ = 0;   // Any later gap still held gets its own timeout
+    return drain_stash();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Types.h"
+#include <cstring>
+
+/**
+ * Shared plumbing of the binary file formats (Capture, Checkpoint): each
+ * file starts with a header carrying MAGIC, VERSION and its record size,
+ * is written with plain blocking write() calls and read back through one
+ * read-only mapping.
+ */
+
+// Write the whole buffer, retrying on EINTR and short writes; false on
+// any other error. Allocates nothing, so it is safe in a forked child.
+bool write_all(int fd, const void* data, size_t bytes) noexcept;
+
+// Map path read-only, sized to the file, with a sequential read-ahead
+// hint. Returns nullptr (and leaves bytes alone) if the file cannot be
+// opened or mapped or is shorter than min_bytes; release with munmap().
+void* map_file(const char* path, size_t min_bytes, size_t& bytes) noexcept;
+
+// Wall clock in nanoseconds, as stamped into created_ns
+uint64_t wall_clock_ns() noexcept;
+
+// Stamp a fresh header of format Header for records of record_size bytes
+template<typename Header>
+void init_file_header(Header& header, uint32_t record_size) noexcept {
+    std::memcpy(header.magic, Header::MAGIC, sizeof(header.magic));
+    header.version = Header::VERSION;
+    header.record_size = record_size;
+    header.created_ns = wall_clock_ns();
+}
+
+// True if header is format Header, this version, with record_size records
+template<typename Header>
+bool file_header_matches(const Header& header, uint32_t record_size) noexcept {
+    return std::memcmp(header.magic, Header::MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == Header::VERSION && header.record_size == record_size;
+}
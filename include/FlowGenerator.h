@@ -0,0 +1,374 @@
+#pragma once
+
+#include "Types.h"
+#include "Message.h"
+#include <array>
+#include <memory>
+#include <span>
+
+/**
+ * Batched xoshiro256+ generator
+ *
+ * LANES independent generators stepped together from structure-of-arrays
+ * state, so refill() is a plain loop over lanes the compiler vectorises
+ * (shifts, xors, adds and rotates only). Draws come from a fixed buffer
+ * refilled BUFFER values at a time.
+ */
+class BatchRng {
+public:
+    static constexpr size_t LANES = 8;
+    static constexpr size_t BUFFER = 512;
+
+    explicit BatchRng(uint64_t seed) noexcept;
+
+    uint64_t next() noexcept {
+        if (UNLIKELY(position_ == BUFFER)) {
+            refill();
+        }
+        return buffer_[position_++];
+    }
+
+    // Uniform in [0, n) for n < 2^32 (multiply-shift, no division)
+    uint32_t below(uint32_t n) noexcept {
+        return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+    }
+
+    void refill() noexcept;
+
+private:
+    alignas(CACHE_LINE_SIZE) uint64_t s0_[LANES];
+    uint64_t s1_[LANES];
+    uint64_t s2_[LANES];
+    uint64_t s3_[LANES];
+    alignas(CACHE_LINE_SIZE) uint64_t buffer_[BUFFER];
+    size_t position_ = BUFFER;
+};
+
+/**
+ * Message-rate phase of a session: lasts duration_ns at
+ * rate_multiplier times FlowConfig::messages_per_second
+ */
+struct BurstPhase {
+    Timestamp duration_ns = 0;
+    double rate_multiplier = 1.0;
+};
+
+/**
+ * Synthetic flow parameters. Event weights are relative; adds are forced
+ * below min_live_orders (at least one order stays live) and cancels at max_live_orders.
+ */
+struct FlowConfig {
+    uint64_t seed = 1;
+    size_t symbols = 1;                     // Ids 0 .. symbols-1, <= MAX_SYMBOLS
+    bool skewed_symbols = true;             // Low ids trade more, like a real universe
+
+    size_t max_live_orders = 100'000;
+    size_t min_live_orders = 1'000;
+
+    uint32_t add_weight = 50;
+    uint32_t cancel_weight = 35;
+    uint32_t modify_weight = 5;
+    uint32_t execute_weight = 10;
+
+    // Prices: adds land 1..depth ticks from their symbol's mid,
+    // concentrated near the touch; each mid takes a +-1 step every
+    // mid_step_interval messages on average
+    Price initial_mid = 10'000;
+    uint32_t depth = 50;
+    uint32_t mid_step_interval = 1'000;
+
+    Quantity lot_size = 100;
+    uint32_t max_lots = 10;
+
+    // Timestamps: jittered spacing at messages_per_second, scaled by the
+    // phases in order, then the base rate for the rest of the session
+    Timestamp start_time = 0;
+    double messages_per_second = 1e6;
+    std::array<BurstPhase, 8> phases{};
+    size_t phase_count = 0;
+
+    // Opening burst: 20x for the first minute, decaying to the base
+    // rate over fifteen
+    static FlowConfig market_open(size_t symbols, uint64_t seed = 1);
+};
+
+/**
+ * Deterministic Synthetic Order Flow
+ *
+ * Emits a valid normalized Message stream: every cancel, modify and
+ * execute refers to an order the stream added and has not removed, so a
+ * BookManager applies all of it (no unknown ids).
+ *
+ * Key features:
+ * - Same seed and config, same stream, byte for byte
+ * - All state preallocated by the constructor: next() never allocates
+ * - Vectorised batch RNG and multiply-shift bounding, a few ns per
+ *   message, well under the book's own cost
+ * - Writes straight into ring slots (fill) or into a span (generate)
+ * - drain() cancels whatever is still live, so a stream can end flat
+ *
+ * Usage:
+ *   FlowGenerator flow(FlowConfig::market_open(100, seed));
+ *
+ *   flow.fill(ring, 64);                          // Producer thread
+ *   flow.generate(std::span(buffer));             // Or a preallocated batch
+ */
+class FlowGenerator {
+public:
+    explicit FlowGenerator(const FlowConfig& config);
+
+    // Non-copyable (large owned state)
+    FlowGenerator(const FlowGenerator&) = delete;
+    FlowGenerator& operator=(const FlowGenerator&) = delete;
+
+    // Hot path
+    void next(Message& out) noexcept;
+    size_t generate(std::span<Message> out) noexcept;
+    template<typename Ring>
+    size_t fill(Ring& ring, size_t max_items) noexcept;
+
+    // One cancel per live order, then false
+    bool drain(Message& out) noexcept;
+
+    // Status queries
+    size_t live_orders() const noexcept { return live_count_; }
+    uint64_t generated() const noexcept { return sequence_; }
+    Price mid(SymbolId symbol) const noexcept { return mids_[symbol]; }
+    Timestamp now() const noexcept { return clock_; }
+    const FlowConfig& config() const noexcept { return config_; }
+
+private:
+    struct LiveOrder {
+        OrderId id;
+        Price price;
+        Quantity quantity;
+        SymbolId symbol;
+        Side side;
+    };
+
+    FlowConfig config_;
+    BatchRng rng_;
+    std::unique_ptr<LiveOrder[]> live_;
+    size_t live_count_ = 0;
+    std::unique_ptr<Price[]> mids_;
+
+    OrderId next_id_ = 1;
+    uint64_t sequence_ = 0;
+    Timestamp clock_;
+    uint32_t total_weight_;
+    Price min_mid_;
+    Price max_mid_;
+
+    // Timestamp pacing
+    size_t phase_ = 0;
+    Timestamp phase_end_;
+    double mean_gap_ns_;
+
+    void stamp(Message& out, MessageType type) noexcept;
+    void advance_clock() noexcept;
+    SymbolId pick_symbol() noexcept;
+    Price pick_price(SymbolId symbol, Side side) noexcept;
+    void walk_mid(SymbolId symbol) noexcept;
+
+    void emit_add(Message& out) noexcept;
+    void emit_cancel(Message& out, size_t index) noexcept;
+    void emit_modify(Message& out, size_t index) noexcept;
+    void emit_execute(Message& out, size_t index) noexcept;
+    void remove(size_t index) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+inline void BatchRng::refill() noexcept {
+    for (size_t step = 0; step < BUFFER; step += LANES) {
+        for (size_t l = 0; l < LANES; ++l) {
+            buffer_[step + l] = s0_[l] + s3_[l];
+            const uint64_t t = s1_[l] << 17;
+            s2_[l] ^= s0_[l];
+            s3_[l] ^= s1_[l];
+            s1_[l] ^= s2_[l];
+            s0_[l] ^= s3_[l];
+            s2_[l] ^= t;
+            s3_[l] = (s3_[l] << 45) | (s3_[l] >> 19);
+        }
+    }
+    position_ = 0;
+}
+
+inline void FlowGenerator::next(Message& out) noexcept {
+    uint32_t roll = rng_.below(total_weight_);
+    if (live_count_ < config_.min_live_orders) {
+        roll = 0;                                   // Build the book up first
+    } else if (live_count_ >= config_.max_live_orders && roll < config_.add_weight) {
+        roll = config_.add_weight;                  // Full: cancel instead
+    }
+
+    if (roll < config_.add_weight) {
+        emit_add(out);
+        return;
+    }
+    roll -= config_.add_weight;
+    const size_t index = rng_.below(static_cast<uint32_t>(live_count_));
+    if (roll < config_.cancel_weight) {
+        emit_cancel(out, index);
+    } else if (roll < config_.cancel_weight + config_.modify_weight) {
+        emit_modify(out, index);
+    } else {
+        emit_execute(out, index);
+    }
+}
+
+inline size_t FlowGenerator::generate(std::span<Message> out) noexcept {
+    for (Message& msg : out) {
+        next(msg);
+    }
+    return out.size();
+}
+
+template<typename Ring>
+size_t FlowGenerator::fill(Ring& ring, size_t max_items) noexcept {
+    size_t produced = 0;
+    while (produced < max_items) {
+        Message* slot = ring.reserve();
+        if (slot == nullptr) {
+            break;
+        }
+        next(*slot);
+        ring.commit();
+        ++produced;
+    }
+    return produced;
+}
+
+inline bool FlowGenerator::drain(Message& out) noexcept {
+    if (live_count_ == 0) {
+        return false;
+    }
+    const LiveOrder& order = live_[live_count_ - 1];
+    stamp(out, MessageType::CANCEL_ORDER);
+    out.order_id = order.id;
+    out.symbol = order.symbol;
+    out.side = order.side;
+    out.price = order.price;
+    --live_count_;
+    return true;
+}
+
+inline void FlowGenerator::stamp(Message& out, MessageType type) noexcept {
+    out = Message{};
+    out.type = type;
+    out.sequence = ++sequence_;
+    advance_clock();
+    out.timestamp = clock_;
+}
+
+inline void FlowGenerator::advance_clock() noexcept {
+    // Uniform jitter on [0.5, 1.5) of the phase's mean gap
+    const double jitter = 0.5 + static_cast<double>(rng_.next() >> 11) * 0x1.0p-53;
+    clock_ += static_cast<Timestamp>(mean_gap_ns_ * jitter);
+    if (UNLIKELY(clock_ >= phase_end_)) {
+        ++phase_;
+        const double multiplier = phase_ < config_.phase_count
+            ? config_.phases[phase_].rate_multiplier : 1.0;
+        mean_gap_ns_ = 1e9 / (config_.messages_per_second * multiplier);
+        phase_end_ = phase_ < config_.phase_count
+            ? phase_end_ + config_.phases[phase_].duration_ns : ~Timestamp{0};
+    }
+}
+
+inline SymbolId FlowGenerator::pick_symbol() noexcept {
+    const auto n = static_cast<uint32_t>(config_.symbols);
+    const uint32_t a = rng_.below(n);
+    if (!config_.skewed_symbols) {
+        return static_cast<SymbolId>(a);
+    }
+    const uint32_t b = rng_.below(n);
+    return static_cast<SymbolId>(a < b ? a : b);   // Density falls linearly with id
+}
+
+inline Price FlowGenerator::pick_price(SymbolId symbol, Side side) noexcept {
+    // Minimum of two uniforms: most adds sit near the touch
+    const uint32_t a = rng_.below(config_.depth);
+    const uint32_t b = rng_.below(config_.depth);
+    const Price offset = 1 + (a < b ? a : b);
+    return side == Side::BUY ? mids_[symbol] - offset : mids_[symbol] + offset;
+}
+
+inline void FlowGenerator::walk_mid(SymbolId symbol) noexcept {
+    if (rng_.below(config_.mid_step_interval) != 0) {
+        return;
+    }
+    Price& mid = mids_[symbol];
+    if (rng_.next() & 1) {
+        if (mid < max_mid_) ++mid;
+    } else {
+        if (mid > min_mid_) --mid;
+    }
+}
+
+inline void FlowGenerator::emit_add(Message& out) noexcept {
+    const SymbolId symbol = pick_symbol();
+    walk_mid(symbol);
+
+    stamp(out, MessageType::ADD_ORDER);
+    out.symbol = symbol;
+    out.order_id = next_id_++;
+    out.side = (rng_.next() & 1) ? Side::BUY : Side::SELL;
+    out.price = pick_price(symbol, out.side);
+    out.quantity = config_.lot_size * (1 + rng_.below(config_.max_lots));
+
+    live_[live_count_++] = LiveOrder{out.order_id, out.price, out.quantity, symbol, out.side};
+}
+
+inline void FlowGenerator::emit_cancel(Message& out, size_t index) noexcept {
+    LiveOrder& order = live_[index];
+    stamp(out, MessageType::CANCEL_ORDER);
+    out.order_id = order.id;
+    out.symbol = order.symbol;
+    out.side = order.side;
+    out.price = order.price;
+
+    // One in four cancels is partial when the order has lots to spare
+    if (order.quantity > config_.lot_size && (rng_.next() & 3) == 0) {
+        out.quantity = config_.lot_size;
+        order.quantity -= config_.lot_size;
+        return;
+    }
+    remove(index);
+}
+
+inline void FlowGenerator::emit_modify(Message& out, size_t index) noexcept {
+    LiveOrder& order = live_[index];
+    stamp(out, MessageType::MODIFY_ORDER);
+    out.order_id = order.id;
+    out.symbol = order.symbol;
+    out.side = order.side;
+    out.price = pick_price(order.symbol, order.side);
+    out.quantity = config_.lot_size * (1 + rng_.below(config_.max_lots));
+    order.price = out.price;
+    order.quantity = out.quantity;
+}
+
+inline void FlowGenerator::emit_execute(Message& out, size_t index) noexcept {
+    LiveOrder& order = live_[index];
+    stamp(out, MessageType::EXECUTE_ORDER);
+    out.order_id = order.id;
+    out.symbol = order.symbol;
+    out.side = order.side;
+    out.price = order.price;
+
+    // Whole lots, up to the open quantity
+    const uint32_t lots = static_cast<uint32_t>((order.quantity + config_.lot_size - 1) / config_.lot_size);
+    const Quantity quantity = config_.lot_size * (1 + rng_.below(lots));
+    out.quantity = quantity < order.quantity ? quantity : order.quantity;
+    order.quantity -= out.quantity;
+    if (order.quantity == 0) {
+        remove(index);
+    }
+}
+
+inline void FlowGenerator::remove(size_t index) noexcept {
+    live_[index] = live_[--live_count_];
+}
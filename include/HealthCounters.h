@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Types.h"
+#include <array>
+#include <atomic>
+
+/**
+ * Single-writer health counter or gauge. The owning thread updates it
+ * with a relaxed load + store (no locked RMW); a telemetry thread reads
+ * it at any time and sees a torn-free, possibly slightly stale value.
+ */
+class HealthCounter {
+public:
+    void add(uint64_t n = 1) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    void set(uint64_t value) noexcept { value_.store(value, std::memory_order_relaxed); }
+    uint64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * Book thread health block, read by TelemetryExporter
+ *
+ * Per-message counters sit on the first line; the second holds the rare
+ * counters and gauges copied from the pool and index every
+ * REFRESH_INTERVAL messages, so the book thread never computes anything
+ * for telemetry and a scrape costs it at most two line transfers.
+ */
+struct alignas(CACHE_LINE_SIZE) BookHealth {
+    static constexpr size_t TYPE_COUNT = static_cast<size_t>(MessageType::HEARTBEAT) + 1;
+    static constexpr uint32_t REFRESH_INTERVAL = 256;
+
+    std::array<HealthCounter, TYPE_COUNT> messages;     // Applied, by type; rejects not counted
+    HealthCounter rejected;
+
+    alignas(CACHE_LINE_SIZE) HealthCounter unknown;     // Ids not in the index
+    HealthCounter orders_in_use;
+    HealthCounter pool_high_watermark;
+    HealthCounter pool_failed_allocations;
+    HealthCounter index_longest_probe;
+    HealthCounter index_mean_probe_milli;               // Mean probe x 1000
+};
+
+static_assert(sizeof(BookHealth) == 2 * CACHE_LINE_SIZE);
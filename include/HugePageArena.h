@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Types.h"
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/**
+ * What actually backs a HugePageArena, best first
+ */
+enum class PageBacking : uint8_t {
+    HUGETLB_1GB,    // MAP_HUGETLB from the 1 GB hugetlbfs pool
+    HUGETLB_2MB,    // MAP_HUGETLB from the 2 MB hugetlbfs pool
+    TRANSPARENT,    // 2 MB aligned mapping with MADV_HUGEPAGE (THP)
+    NORMAL,         // 4 KB pages; THP unavailable or disabled
+    NONE            // Mapping failed; every allocation returns nullptr
+};
+
+const char* page_backing_name(PageBacking backing) noexcept;
+
+/**
+ * Huge-Page Backed Bump Arena
+ *
+ * Key features:
+ * - One mapping, reserved up front, backed by the largest pages the
+ *   host grants: hugetlbfs 1 GB or 2 MB pages, else a 2 MB aligned
+ *   transparent-huge-page region, else normal pages
+ * - Bump allocation with alignment; no per-object free. Memory returns
+ *   all at once when the arena is destroyed
+ * - Prefaulted at construction, so no hot-path access faults
+ * - No-throw: exhaustion returns nullptr and is counted. Consumers
+ *   (rings, pool, books, index) then fall back to the heap.
+ *
+ * The arena runs no destructors, so only trivially destructible types
+ * may live in it. It must outlive everything that allocates from it.
+ *
+ * Usage:
+ *   HugePageArena arena(512ull << 20);              // 2 MB pages
+ *   BookManager books(Config::MAX_ORDERS, &arena);  // Pool, index, levels
+ *   SPSCRing<Message, 65536, AtomicRingStats, ArenaRingStorage> ring(arena);
+ */
+class HugePageArena {
+public:
+    static constexpr size_t HUGE_PAGE_2MB = size_t{2} << 20;
+    static constexpr size_t HUGE_PAGE_1GB = size_t{1} << 30;
+
+    // page_size: HUGE_PAGE_2MB or HUGE_PAGE_1GB (falls back to 2 MB first)
+    explicit HugePageArena(size_t bytes, size_t page_size = HUGE_PAGE_2MB) noexcept;
+    ~HugePageArena();
+
+    // Non-copyable, non-movable (allocations point into the mapping)
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+    HugePageArena(HugePageArena&&) = delete;
+    HugePageArena& operator=(HugePageArena&&) = delete;
+
+    // Allocation (single thread; setup time)
+    void* allocate(size_t bytes, size_t alignment = CACHE_LINE_SIZE) noexcept;
+
+    // count value-initialized Ts; nullptr when the arena is out of room
+    template<typename T>
+    T* allocate_array(size_t count) noexcept;
+
+    // Status queries
+    PageBacking backing() const noexcept { return backing_; }
+    size_t page_size() const noexcept { return page_size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    size_t used() const noexcept { return used_; }
+    size_t available() const noexcept { return capacity_ - used_; }
+    uint64_t failed_allocations() const noexcept { return failed_allocations_; }
+
+private:
+    char* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t page_size_ = 0;
+    size_t mapping_bytes_ = 0;
+    void* mapping_ = nullptr;
+    PageBacking backing_ = PageBacking::NONE;
+    uint64_t failed_allocations_ = 0;
+
+    bool map_hugetlb(size_t bytes, size_t page_size) noexcept;
+    bool map_transparent(size_t bytes) noexcept;
+};
+
+/**
+ * Array of T taken from a HugePageArena when one is given, otherwise (or
+ * when the arena is full) from the heap. The storage type the pool, index
+ * and book levels hold instead of a bare unique_ptr<T[]>.
+ */
+template<typename T>
+class ArenaArray {
+public:
+    ArenaArray(size_t count, HugePageArena* arena) {
+        if (arena != nullptr) {
+            data_ = arena->allocate_array<T>(count);
+        }
+        if (data_ == nullptr) {
+            owned_ = std::make_unique<T[]>(count);
+            data_ = owned_.get();
+        }
+    }
+
+    T& operator[](size_t i) noexcept { return data_[i]; }
+    const T& operator[](size_t i) const noexcept { return data_[i]; }
+    T* get() const noexcept { return data_; }
+    bool in_arena() const noexcept { return owned_ == nullptr; }
+
+private:
+    T* data_ = nullptr;
+    std::unique_ptr<T[]> owned_;
+};
+
+/**
+ * SPSCRing storage policy: the Size slots come from a HugePageArena
+ * (heap if it is full) instead of being embedded in the ring. The slot
+ * pointer sits on its own read-only line shared by both sides.
+ */
+template<typename T, size_t Size>
+class ArenaRingStorage {
+public:
+    explicit ArenaRingStorage(HugePageArena& arena) : slots_(Size, &arena) {}
+
+    T* data() noexcept { return slots_.get(); }
+    const T* data() const noexcept { return slots_.get(); }
+    bool in_arena() const noexcept { return slots_.in_arena(); }
+
+private:
+    alignas(CACHE_LINE_SIZE) ArenaArray<T> slots_;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+inline void* HugePageArena::allocate(size_t bytes, size_t alignment) noexcept {
+    const size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+    if (UNLIKELY(base_ == nullptr || offset > capacity_ || bytes > capacity_ - offset)) {
+        ++failed_allocations_;
+        return nullptr;
+    }
+    used_ = offset + bytes;
+    return base_ + offset;
+}
+
+template<typename T>
+T* HugePageArena::allocate_array(size_t count) noexcept {
+    static_assert(std::is_trivially_destructible_v<T>, "The arena never runs destructors");
+    static_assert(std::is_nothrow_default_constructible_v<T>, "Construction must not throw");
+
+    constexpr size_t alignment = alignof(T) > CACHE_LINE_SIZE ? alignof(T) : CACHE_LINE_SIZE;
+    if (count > capacity_ / sizeof(T)) {
+        ++failed_allocations_;
+        return nullptr;
+    }
+    T* data = static_cast<T*>(allocate(count * sizeof(T), alignment));
+    if (data != nullptr) {
+        for (size_t i = 0; i < count; ++i) {
+            new (data + i) T();
+        }
+    }
+    return data;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Types.h"
+#include "TSCTimer.h"
+#include <array>
+#include <atomic>
+#include <iosfwd>
+
+/**
+ * Tail percentiles of a histogram, in nanoseconds
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    double mean_ns = 0;
+    double p50_ns = 0;
+    double p99_ns = 0;
+    double p999_ns = 0;
+    double p9999_ns = 0;
+    double max_ns = 0;
+};
+
+/**
+ * HDR-Style Log-Linear Latency Histogram
+ *
+ * Key features:
+ * - Records raw TSC cycle deltas: no allocation, formatting or I/O, just
+ *   a leading-zero count, a shift and a counter bump
+ * - 2^SUB_BUCKET_BITS linear sub-buckets per power of two: values below
+ *   128 cycles are exact, larger ones within 1/64 (~1.6%) relative error
+ * - Fixed 30 KB footprint covering the full 64-bit range
+ * - Single writer, any reader: counters use relaxed store of load + 1
+ *   (no locked RMW), so another thread can merge or report while the
+ *   owner keeps recording
+ * - Per-thread histograms merge into an aggregate for reporting
+ *
+ * Usage:
+ *   LatencyHistogram hist;
+ *
+ *   uint64_t start = timer.now();
+ *   book.process(msg);
+ *   hist.record(timer.now() - start);
+ *
+ *   LatencySummary s = hist.summary(timer);    // p50 .. p99.99, max in ns
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 7;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t HALF_SUB_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+    static constexpr size_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * HALF_SUB_BUCKET_COUNT;
+
+    LatencyHistogram() noexcept { reset(); }
+
+    // Non-copyable (contains atomics); merge() combines histograms
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Owner thread only
+    void record(uint64_t cycles) noexcept;
+    void reset() noexcept;
+
+    // Aggregation: add other's counts into this histogram. This histogram
+    // must not be recorded into concurrently; other may be.
+    void merge(const LatencyHistogram& other) noexcept;
+
+    // Queries (any thread)
+    uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    uint64_t min_cycles() const noexcept;
+    uint64_t max_cycles() const noexcept { return max_.load(std::memory_order_relaxed); }
+    double mean_cycles() const noexcept;
+    uint64_t percentile_cycles(double percentile) const noexcept;
+
+    LatencySummary summary(const TSCTimer& timer) const noexcept;
+    void print(const char* name, const TSCTimer& timer, std::ostream& out) const;
+
+    // Bucket mapping (exposed for tests and exporters)
+    static size_t bucket_index(uint64_t value) noexcept;
+    static uint64_t bucket_upper_bound(size_t index) noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * One histogram per MessageType, for per-type tail latency
+ */
+struct MessageLatencyRecorder {
+    static constexpr size_t TYPE_COUNT = static_cast<size_t>(MessageType::HEARTBEAT) + 1;
+
+    std::array<LatencyHistogram, TYPE_COUNT> by_type;
+
+    void record(MessageType type, uint64_t cycles) noexcept {
+        by_type[static_cast<size_t>(type)].record(cycles);
+    }
+    const LatencyHistogram& operator[](MessageType type) const noexcept {
+        return by_type[static_cast<size_t>(type)];
+    }
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+inline size_t LatencyHistogram::bucket_index(uint64_t value) noexcept {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+
+    // Above the linear range each power of two gets HALF_SUB_BUCKET_COUNT
+    // buckets, indexed by the bits just below the most significant one
+    const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    const unsigned shift = msb - SUB_BUCKET_BITS + 1;
+    const size_t mantissa = static_cast<size_t>(value >> shift);   // [HALF, FULL)
+    return SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT +
+           (mantissa - HALF_SUB_BUCKET_COUNT);
+}
+
+inline uint64_t LatencyHistogram::bucket_upper_bound(size_t index) noexcept {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const size_t k = index - SUB_BUCKET_COUNT;
+    const unsigned shift = static_cast<unsigned>(k / HALF_SUB_BUCKET_COUNT) + 1;
+    const uint64_t mantissa = k % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+inline void LatencyHistogram::record(uint64_t cycles) noexcept {
+    bump(buckets_[bucket_index(cycles)], 1);
+    bump(count_, 1);
+    bump(sum_, cycles);
+    if (UNLIKELY(cycles < min_.load(std::memory_order_relaxed))) {
+        min_.store(cycles, std::memory_order_relaxed);
+    }
+    if (UNLIKELY(cycles > max_.load(std::memory_order_relaxed))) {
+        max_.store(cycles, std::memory_order_relaxed);
+    }
+}
+
+inline uint64_t LatencyHistogram::min_cycles() const noexcept {
+    return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+inline double LatencyHistogram::mean_cycles() const noexcept {
+    const uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / n;
+}
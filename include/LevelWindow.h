@@ -0,0 +1,383 @@
+#pragma once
+
+#include "Types.h"
+#include "Order.h"
+#include "HugePageArena.h"
+#include "OccupancyBitmap.h"
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Aggregated state of a single price level
+ *
+ * Orders at the level form an intrusive doubly-linked FIFO of pool
+ * handles: head is the oldest order (first in time priority), tail the
+ * newest. 16 bytes with 32-bit handles, so four levels share a cache
+ * line; 12 with 16-bit ones.
+ */
+template<HandleType Handle, LotType Lot>
+struct BasicPriceLevel {
+    static constexpr Handle INVALID = std::numeric_limits<Handle>::max();
+
+    Handle head = INVALID;
+    Handle tail = INVALID;
+    Lot total_quantity = 0;
+    Handle order_count = 0;         // Bounded by the pool, so the handle width suffices
+
+    bool empty() const noexcept { return head == INVALID; }
+};
+
+using PriceLevel = BasicPriceLevel<OrderHandle, Quantity>;
+
+static_assert(sizeof(PriceLevel) == 16, "Four levels per cache line");
+
+/**
+ * Windowed Sparse Price-Level Storage (one book side)
+ *
+ * Key features:
+ * - Dense window of WINDOW_SIZE levels covering [base, base + WINDOW_SIZE),
+ *   kept around the touch: lookups there are one compare and one index
+ * - Levels outside the window live in a small open-addressing overflow
+ *   table (linear probing, backward-shift deletion, <= 50% load)
+ * - The window is circular (slot = price & MASK), so recentering by d
+ *   ticks only moves the d levels that change sides, never the rest
+ * - Recentering happens when the touch leaves the middle three quarters
+ *   of the window; if the overflow has no room for the spill, the window
+ *   stays put and the move is counted, lookups stay correct
+ * - An OccupancyBitmap over the whole price range, window and overflow
+ *   alike, finds the next non-empty level in a few word operations
+ *   however thin the book or far the level
+ * - Roughly 64 KB per side at the Config sizes, against 1 MB for a dense
+ *   array over the whole price range
+ * - Price range, window size and stored widths come from the BookSpec;
+ *   a window spanning a compact spec's whole range never recenters
+ *
+ * Level pointers are invalidated by acquire(), release_if_empty() and
+ * recenter(); orders refer to levels by (side, price), never by address.
+ *
+ * Usage:
+ *   LevelWindow<> bids;                        // Or BasicLevelWindow<Spec>
+ *
+ *   PriceLevel* lvl = bids.acquire(10025);     // nullptr if overflow full
+ *   ...
+ *   bids.release_if_empty(10025);
+ *   Price next = bids.highest_below(10025);    // NO_PRICE if none
+ *   bids.maybe_recenter(new_best_bid);
+ */
+template<BookSpecification Spec = DefaultBookSpec>
+class BasicLevelWindow {
+public:
+    using price_type = typename Spec::price_type;
+    using Level = BasicPriceLevel<typename Spec::handle_type, typename Spec::quantity_type>;
+
+    static constexpr price_type NO_PRICE = 0;    // Below Spec::MIN_PRICE
+    static constexpr size_t WINDOW_SIZE = Spec::WINDOW_SIZE;
+    static constexpr size_t OVERFLOW_CAPACITY = Spec::OVERFLOW_SLOTS / 2;
+
+    explicit BasicLevelWindow(HugePageArena* arena = nullptr);
+    ~BasicLevelWindow() = default;
+
+    // Non-copyable, non-movable (large owned arrays)
+    BasicLevelWindow(const BasicLevelWindow&) = delete;
+    BasicLevelWindow& operator=(const BasicLevelWindow&) = delete;
+    BasicLevelWindow(BasicLevelWindow&&) = delete;
+    BasicLevelWindow& operator=(BasicLevelWindow&&) = delete;
+
+    // Level access (single thread only). at() requires the level to exist,
+    // i.e. to hold at least one order or to have just been acquired.
+    const Level& get(price_type price) const noexcept;
+    Level& at(price_type price) noexcept;
+    Level* acquire(price_type price) noexcept;
+    bool can_acquire(price_type price) const noexcept;
+    void release_if_empty(price_type price) noexcept;
+
+    // Touch recovery: nearest non-empty level strictly beyond price, or
+    // NO_PRICE. A level counts as non-empty from acquire() until
+    // release_if_empty() finds it empty.
+    price_type highest_below(price_type price) const noexcept;
+    price_type lowest_above(price_type price) const noexcept;
+
+    // Keep the window centred on the touch
+    void maybe_recenter(price_type touch) noexcept;
+    bool recenter(price_type touch) noexcept;
+
+    bool in_window(price_type price) const noexcept {
+        return static_cast<price_type>(price - base_) < WINDOW_SIZE;
+    }
+
+    // Status queries
+    price_type base() const noexcept { return base_; }
+    size_t overflow_size() const noexcept { return overflow_size_; }
+
+    // Performance monitoring
+    uint64_t recenters() const noexcept { return recenters_; }
+    uint64_t failed_recenters() const noexcept { return failed_recenters_; }
+
+private:
+    struct OverflowSlot {
+        price_type price = NO_PRICE;      // NO_PRICE marks an empty slot
+        Level level;
+
+        bool occupied() const noexcept { return price != NO_PRICE; }
+    };
+
+    static constexpr size_t MASK = WINDOW_SIZE - 1;
+    static constexpr size_t OVERFLOW_MASK = Spec::OVERFLOW_SLOTS - 1;
+    static constexpr unsigned OVERFLOW_SHIFT = 64 - __builtin_ctzll(Spec::OVERFLOW_SLOTS);
+    static constexpr price_type MAX_BASE = Spec::MAX_PRICE - WINDOW_SIZE + 1;
+
+    using Occupancy = OccupancyBitmap<Spec::PRICE_LEVELS>;
+
+    static inline const Level EMPTY_LEVEL{};
+
+    ArenaArray<Level> window_;
+    ArenaArray<OverflowSlot> overflow_;
+    Occupancy occupied_;            // Bit (price - MIN_PRICE) per non-empty level
+    price_type base_ = Spec::MIN_PRICE;
+    size_t overflow_size_ = 0;
+    uint64_t recenters_ = 0;
+    uint64_t failed_recenters_ = 0;
+
+    Level& slot(price_type price) noexcept { return window_[price & MASK]; }
+    const Level& slot(price_type price) const noexcept { return window_[price & MASK]; }
+
+    static price_type centred_base(price_type touch) noexcept {
+        const price_type half = WINDOW_SIZE / 2;
+        if (touch < Spec::MIN_PRICE + half) return Spec::MIN_PRICE;
+        const price_type base = touch - half;
+        return base > MAX_BASE ? MAX_BASE : base;
+    }
+
+    // Overflow table
+    static size_t home_slot(price_type price) noexcept {
+        return static_cast<size_t>((price * 0x9E3779B97F4A7C15ULL) >> OVERFLOW_SHIFT) & OVERFLOW_MASK;
+    }
+    static size_t next_slot(size_t current) noexcept {
+        return (current + 1) & OVERFLOW_MASK;
+    }
+    OverflowSlot* overflow_find(price_type price) noexcept;
+    const OverflowSlot* overflow_find(price_type price) const noexcept;
+    Level* overflow_insert(price_type price, const Level& level) noexcept;
+    void overflow_erase(price_type price) noexcept;
+};
+
+// Fixed-range window over the Config prices; LevelWindow<> is the default
+// spec's, and tests size small windows through the two arguments
+template<size_t WindowSize = Config::LEVEL_WINDOW_SIZE,
+         size_t OverflowSlots = Config::LEVEL_OVERFLOW_SLOTS>
+using LevelWindow = BasicLevelWindow<BookSpec<Price, Quantity, OrderHandle,
+                                              Config::MIN_PRICE, Config::MAX_PRICE, Config::MAX_ORDERS,
+                                              WindowSize, OverflowSlots>>;
+
+static_assert(std::is_same_v<LevelWindow<>, BasicLevelWindow<DefaultBookSpec>>);
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<BookSpecification Spec>
+BasicLevelWindow<Spec>::BasicLevelWindow(HugePageArena* arena)
+    : window_(WINDOW_SIZE, arena), overflow_(Spec::OVERFLOW_SLOTS, arena), occupied_(arena) {}
+
+template<BookSpecification Spec>
+const typename BasicLevelWindow<Spec>::Level&
+BasicLevelWindow<Spec>::get(price_type price) const noexcept {
+    if (LIKELY(in_window(price))) {
+        return slot(price);
+    }
+    const OverflowSlot* entry = overflow_find(price);
+    return entry != nullptr ? entry->level : EMPTY_LEVEL;
+}
+
+template<BookSpecification Spec>
+typename BasicLevelWindow<Spec>::Level&
+BasicLevelWindow<Spec>::at(price_type price) noexcept {
+    if (LIKELY(in_window(price))) {
+        return slot(price);
+    }
+    return overflow_find(price)->level;
+}
+
+template<BookSpecification Spec>
+typename BasicLevelWindow<Spec>::Level*
+BasicLevelWindow<Spec>::acquire(price_type price) noexcept {
+    Level* level;
+    if (LIKELY(in_window(price))) {
+        level = &slot(price);
+    } else if (OverflowSlot* entry = overflow_find(price)) {
+        level = &entry->level;
+    } else {
+        level = overflow_insert(price, Level{});
+        if (UNLIKELY(level == nullptr)) {
+            return nullptr;
+        }
+    }
+    occupied_.set(price - Spec::MIN_PRICE);
+    return level;
+}
+
+template<BookSpecification Spec>
+bool BasicLevelWindow<Spec>::can_acquire(price_type price) const noexcept {
+    return in_window(price) || overflow_size_ < OVERFLOW_CAPACITY || overflow_find(price) != nullptr;
+}
+
+template<BookSpecification Spec>
+void BasicLevelWindow<Spec>::release_if_empty(price_type price) noexcept {
+    if (LIKELY(in_window(price))) {
+        if (slot(price).empty()) {
+            occupied_.clear(price - Spec::MIN_PRICE);
+        }
+        return;
+    }
+    if (overflow_find(price)->level.empty()) {
+        overflow_erase(price);
+        occupied_.clear(price - Spec::MIN_PRICE);
+    }
+}
+
+template<BookSpecification Spec>
+typename BasicLevelWindow<Spec>::price_type
+BasicLevelWindow<Spec>::highest_below(price_type price) const noexcept {
+    if (price <= Spec::MIN_PRICE) {
+        return NO_PRICE;
+    }
+    const price_type from = (price > Spec::MAX_PRICE ? Spec::MAX_PRICE : price - 1);
+    const size_t i = occupied_.find_prev(from - Spec::MIN_PRICE);
+    return i == Occupancy::NPOS ? NO_PRICE : static_cast<price_type>(i + Spec::MIN_PRICE);
+}
+
+template<BookSpecification Spec>
+typename BasicLevelWindow<Spec>::price_type
+BasicLevelWindow<Spec>::lowest_above(price_type price) const noexcept {
+    if (price >= Spec::MAX_PRICE) {
+        return NO_PRICE;
+    }
+    const price_type from = (price < Spec::MIN_PRICE ? Spec::MIN_PRICE : price + 1);
+    const size_t i = occupied_.find_next(from - Spec::MIN_PRICE);
+    return i == Occupancy::NPOS ? NO_PRICE : static_cast<price_type>(i + Spec::MIN_PRICE);
+}
+
+template<BookSpecification Spec>
+void BasicLevelWindow<Spec>::maybe_recenter(price_type touch) noexcept {
+    // Leave the window alone while the touch is in its middle three quarters
+    const price_type offset = touch - base_;
+    if (offset >= WINDOW_SIZE / 8 && offset < WINDOW_SIZE - WINDOW_SIZE / 8) {
+        return;
+    }
+    recenter(touch);
+}
+
+template<BookSpecification Spec>
+bool BasicLevelWindow<Spec>::recenter(price_type touch) noexcept {
+    const price_type new_base = centred_base(touch);
+    if (new_base == base_) {
+        return true;
+    }
+
+    // Prices leaving the window; each shares its circular slot with the
+    // entering price new_base + ((q - new_base) & MASK)
+    const price_type old_base = base_;
+    const price_type shift = new_base > old_base ? new_base - old_base : old_base - new_base;
+    price_type first = old_base;
+    price_type count = WINDOW_SIZE;
+    if (shift < WINDOW_SIZE) {
+        count = shift;
+        first = new_base > old_base ? old_base : new_base + WINDOW_SIZE;
+    }
+    auto entering = [new_base](price_type q) {
+        return static_cast<price_type>(new_base + ((q - new_base) & MASK));
+    };
+
+    // Spilled levels need overflow room unless the level entering their
+    // slot frees one
+    size_t needed = 0;
+    for (price_type q = first; q < first + count; ++q) {
+        if (!slot(q).empty() && overflow_find(entering(q)) == nullptr) {
+            ++needed;
+        }
+    }
+    if (needed > OVERFLOW_CAPACITY - overflow_size_) {
+        ++failed_recenters_;
+        return false;
+    }
+
+    for (price_type q = first; q < first + count; ++q) {
+        Level& lvl = slot(q);
+        Level incoming{};
+        const price_type e = entering(q);
+        if (OverflowSlot* entry = overflow_find(e)) {
+            incoming = entry->level;
+            overflow_erase(e);
+        }
+        if (!lvl.empty()) {
+            overflow_insert(q, lvl);
+        }
+        lvl = incoming;
+    }
+
+    base_ = new_base;
+    ++recenters_;
+    return true;
+}
+
+template<BookSpecification Spec>
+typename BasicLevelWindow<Spec>::OverflowSlot*
+BasicLevelWindow<Spec>::overflow_find(price_type price) noexcept {
+    return const_cast<OverflowSlot*>(std::as_const(*this).overflow_find(price));
+}
+
+template<BookSpecification Spec>
+const typename BasicLevelWindow<Spec>::OverflowSlot*
+BasicLevelWindow<Spec>::overflow_find(price_type price) const noexcept {
+    for (size_t i = home_slot(price);; i = next_slot(i)) {
+        const OverflowSlot& entry = overflow_[i];
+        if (!entry.occupied()) {
+            return nullptr;
+        }
+        if (entry.price == price) {
+            return &entry;
+        }
+    }
+}
+
+template<BookSpecification Spec>
+typename BasicLevelWindow<Spec>::Level*
+BasicLevelWindow<Spec>::overflow_insert(price_type price, const Level& level) noexcept {
+    if (UNLIKELY(overflow_size_ >= OVERFLOW_CAPACITY)) {
+        return nullptr;  // Table at its sized load factor
+    }
+    for (size_t i = home_slot(price);; i = next_slot(i)) {
+        OverflowSlot& entry = overflow_[i];
+        if (!entry.occupied()) {
+            entry.price = price;
+            entry.level = level;
+            ++overflow_size_;
+            return &entry.level;
+        }
+    }
+}
+
+template<BookSpecification Spec>
+void BasicLevelWindow<Spec>::overflow_erase(price_type price) noexcept {
+    size_t hole = home_slot(price);
+    while (overflow_[hole].price != price) {
+        hole = next_slot(hole);
+    }
+
+    // Backward-shift deletion, as in OrderIdMap
+    for (size_t i = next_slot(hole);; i = next_slot(i)) {
+        OverflowSlot& entry = overflow_[i];
+        if (!entry.occupied()) {
+            break;
+        }
+        const size_t home = home_slot(entry.price);
+        if (((i - home) & OVERFLOW_MASK) >= ((i - hole) & OVERFLOW_MASK)) {
+            overflow_[hole] = entry;
+            hole = i;
+        }
+    }
+
+    overflow_[hole] = OverflowSlot{};
+    --overflow_size_;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Types.h"
+#include "RingPolicies.h"
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * Lock-Free Multi Producer Single Consumer Ring Buffer
+ *
+ * Key features:
+ * - Bounded ring with a per-slot sequence number (Vyukov): producers
+ *   claim a slot with one CAS on head_, then publish it by storing the
+ *   slot's sequence, so a slow producer never blocks the others' slots
+ * - Single consumer reads with no RMW at all
+ * - Head, tail and counters on separate cache lines, as in SPSCRing
+ * - Power-of-2 sizing; all Size slots are usable
+ *
+ * Usage:
+ *   MPSCRing<Message, 1024> ring;
+ *
+ *   // Any number of producer threads (e.g. A and B feed lines):
+ *   ring.try_emplace(message);
+ *
+ *   // One consumer thread:
+ *   Message msg;
+ *   if (ring.try_pop(msg)) { ... }
+ */
+template<typename T, size_t Size, typename Stats = AtomicRingStats>
+class MPSCRing {
+    static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
+    static_assert(Size >= 2, "Size must be at least 2");
+    static_assert(!std::is_same_v<Stats, SingleWriterRingStats>,
+                  "Push counters have several writers; use AtomicRingStats or NoRingStats");
+
+public:
+    MPSCRing();
+    ~MPSCRing() = default;
+
+    // Non-copyable, non-movable (contains atomics)
+    MPSCRing(const MPSCRing&) = delete;
+    MPSCRing& operator=(const MPSCRing&) = delete;
+    MPSCRing(MPSCRing&&) = delete;
+    MPSCRing& operator=(MPSCRing&&) = delete;
+
+    // Producer interface (any thread)
+    bool try_emplace(const T& item) noexcept;
+    bool try_emplace(T&& item) noexcept;
+
+    // Consumer interface (single thread only)
+    bool try_pop(T& item) noexcept;
+    template<typename Callback>
+    size_t consume_all(Callback&& callback, size_t max_items = Size) noexcept;
+
+    // Status queries (can be called from any thread; approximate while
+    // producers are mid-publish)
+    bool empty() const noexcept { return size() == 0; }
+    size_t size() const noexcept;
+    size_t capacity() const noexcept { return Size; }
+
+    // Performance monitoring
+    uint64_t total_pushes() const noexcept { return stats_.pushes(); }
+    uint64_t total_pops() const noexcept { return stats_.pops(); }
+    uint64_t failed_pushes() const noexcept { return stats_.failed_pushes(); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;   // == position when free, position + 1 when full
+        T data;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};     // Producers claim here
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};     // Consumer reads here
+    alignas(CACHE_LINE_SIZE) Slot buffer_[Size];
+
+    [[no_unique_address]] Stats stats_;
+
+    // Bit mask for fast modulo operation
+    static constexpr size_t MASK = Size - 1;
+
+    // Claim the next slot; nullptr when full. pos receives its position.
+    Slot* claim(size_t& pos) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename T, size_t Size, typename Stats>
+MPSCRing<T, Size, Stats>::MPSCRing() {
+    for (size_t i = 0; i < Size; ++i) {
+        buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, size_t Size, typename Stats>
+typename MPSCRing<T, Size, Stats>::Slot* MPSCRing<T, Size, Stats>::claim(size_t& pos) noexcept {
+    pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = buffer_[pos & MASK];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // Slot free at our position: race other producers for it
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (diff < 0) {
+            stats_.record_failed_push(1);
+            return nullptr;  // Buffer full: consumer has not freed this lap
+        } else {
+            pos = head_.load(std::memory_order_relaxed);  // Lost the race; retry
+        }
+    }
+}
+
+template<typename T, size_t Size, typename Stats>
+bool MPSCRing<T, Size, Stats>::try_emplace(const T& item) noexcept {
+    size_t pos;
+    Slot* slot = claim(pos);
+    if (UNLIKELY(slot == nullptr)) {
+        return false;
+    }
+
+    slot->data = item;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    stats_.record_push(1);
+    return true;
+}
+
+template<typename T, size_t Size, typename Stats>
+bool MPSCRing<T, Size, Stats>::try_emplace(T&& item) noexcept {
+    size_t pos;
+    Slot* slot = claim(pos);
+    if (UNLIKELY(slot == nullptr)) {
+        return false;
+    }
+
+    slot->data = std::move(item);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    stats_.record_push(1);
+    return true;
+}
+
+template<typename T, size_t Size, typename Stats>
+bool MPSCRing<T, Size, Stats>::try_pop(T& item) noexcept {
+    const size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot& slot = buffer_[pos & MASK];
+
+    // Empty, or the claiming producer has not published yet
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;
+    }
+
+    item = std::move(slot.data);
+
+    // Hand the slot to producers for the next lap
+    slot.sequence.store(pos + Size, std::memory_order_release);
+    tail_.store(pos + 1, std::memory_order_relaxed);
+    stats_.record_pop(1);
+    return true;
+}
+
+template<typename T, size_t Size, typename Stats>
+template<typename Callback>
+size_t MPSCRing<T, Size, Stats>::consume_all(Callback&& callback, size_t max_items) noexcept {
+    const size_t start = tail_.load(std::memory_order_relaxed);
+    size_t pos = start;
+
+    // Stop at the first unpublished slot to preserve claim order
+    while (pos - start < max_items) {
+        Slot& slot = buffer_[pos & MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+        callback(slot.data);
+        slot.sequence.store(pos + Size, std::memory_order_release);
+        ++pos;
+    }
+
+    const size_t count = pos - start;
+    if (count != 0) {
+        tail_.store(pos, std::memory_order_relaxed);
+        stats_.record_pop(count);
+    }
+    return count;
+}
+
+template<typename T, size_t Size, typename Stats>
+size_t MPSCRing<T, Size, Stats>::size() const noexcept {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t head = head_.load(std::memory_order_acquire);
+    return head > tail ? std::min(head - tail, Size) : 0;
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "Types.h"
+#include "BookPublisher.h"
+#include "OrderBook.h"
+#include "Seqlock.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+// ============================================================================
+// SHARED SEGMENT LAYOUT
+// ============================================================================
+//
+// One POSIX shared-memory object per bus, written by the book process and
+// mapped read-only by every consumer process:
+//
+//   line 0      BusHeader: magic, version, layout sizes, state
+//   line 1      publish cursor (the only line the producer bounces)
+//   ring        Config::BUS_RING_SIZE LevelUpdate slots, two per line
+//   snapshots   one Seqlock<BookSnapshot> per symbol
+//
+// The ring is a broadcast ring without consumer gating: the producer never
+// learns who is attached and overwrites the oldest slot when it laps, so
+// a stalled consumer cannot slow the book. Consumers keep their cursor in
+// their own process and detect being lapped from the publish cursor.
+
+/**
+ * Book state of one symbol for consumers that attach late or were lapped:
+ * the best DEPTH levels per side as of the feed message `sequence`
+ */
+struct BookSnapshot {
+    static constexpr size_t DEPTH = 8;
+
+    Timestamp timestamp;
+    uint64_t sequence;          // Feed sequence of the last message applied
+    uint32_t bid_count;
+    uint32_t ask_count;
+    std::array<DepthLevel, DEPTH> bids;     // Best first
+    std::array<DepthLevel, DEPTH> asks;
+};
+
+struct alignas(CACHE_LINE_SIZE) BusHeader {
+    static constexpr char MAGIC[8] = {'H', 'F', 'T', 'B', 'U', 'S', '0', '1'};
+    static constexpr uint32_t VERSION = 1;
+
+    enum State : uint32_t { INITIALIZING = 0, LIVE = 1, CLOSED = 2 };
+
+    char magic[8];
+    uint32_t version;
+    uint32_t update_size;       // sizeof(LevelUpdate)
+    uint32_t snapshot_size;     // sizeof(BookSnapshot)
+    uint32_t max_symbols;
+    uint64_t ring_slots;
+    uint64_t session;           // Producer start, wall-clock ns: changes on restart
+    int32_t producer_pid;
+    std::atomic<uint32_t> state;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "Atomics shared between processes must be address-free");
+static_assert(sizeof(BusHeader) == CACHE_LINE_SIZE);
+
+/**
+ * One ring slot: a LevelUpdate held as relaxed atomic words, as in
+ * Seqlock, so a consumer racing the producer copies a torn value it then
+ * discards instead of racing undefined behaviour
+ */
+struct BusSlot {
+    static constexpr size_t WORDS = sizeof(LevelUpdate) / sizeof(uint64_t);
+    std::atomic<uint64_t> words[WORDS];
+};
+
+static_assert(sizeof(LevelUpdate) % sizeof(uint64_t) == 0 && std::is_trivially_copyable_v<LevelUpdate>);
+static_assert(CACHE_LINE_SIZE % sizeof(BusSlot) == 0, "Slots must not straddle cache lines");
+
+struct MarketDataSegment {
+    static constexpr size_t SLOTS = Config::BUS_RING_SIZE;
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "Ring size must be power of 2");
+
+    BusHeader header;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published;     // Producer writes
+    alignas(CACHE_LINE_SIZE) BusSlot ring[SLOTS];
+    Seqlock<BookSnapshot> snapshots[Config::MAX_SYMBOLS];
+};
+
+/**
+ * Shared-Memory Market Data Bus: Producer Side
+ *
+ * Publishes the book's level deltas and per-symbol depth snapshots into a
+ * POSIX shared-memory segment for strategy, risk and recorder processes,
+ * replacing a socket hop per consumer with a store into mapped memory.
+ *
+ * Key features:
+ * - Drop-in BookPublisher ring: try_publish() takes each LevelUpdate,
+ *   publish_snapshot() each touched symbol's book after the update
+ * - Never blocks and never fails: consumers are not tracked, a lapped
+ *   consumer detects it and resyncs from the snapshots
+ * - The header carries magic, version and layout sizes, checked by every
+ *   consumer at attach; a restarted producer creates a fresh object, so
+ *   consumers still mapping the old one see it CLOSED (or a dead pid)
+ *
+ * Usage:
+ *   MarketDataBus bus;
+ *   bus.create("/md.book0");
+ *   BookPublisher<MarketDataBus> out(books, bus, true);    // Conflate
+ *
+ *   ring.consume_all([&](Message& msg) { out.process(msg); }, 64);
+ *   out.flush();                                  // Deltas + snapshots
+ *
+ *   bus.close();                                  // Consumers see CLOSED
+ */
+class MarketDataBus {
+public:
+    static constexpr size_t SLOTS = MarketDataSegment::SLOTS;
+
+    MarketDataBus() = default;
+    ~MarketDataBus();
+
+    // Non-copyable, non-movable (owns the mapping)
+    MarketDataBus(const MarketDataBus&) = delete;
+    MarketDataBus& operator=(const MarketDataBus&) = delete;
+
+    // Setup (syscalls): replaces any segment of that name, which stays
+    // valid for consumers still mapping it until they detach
+    bool create(const char* name);
+    void close(bool unlink = true) noexcept;
+    bool is_open() const noexcept { return segment_ != nullptr; }
+
+    // Producer interface (single thread only)
+    bool try_publish(const LevelUpdate& update) noexcept;
+    void publish_snapshot(SymbolId symbol, const OrderBook& book,
+                          Timestamp timestamp, uint64_t sequence) noexcept;
+
+    // Status queries
+    uint64_t published() const noexcept { return published_; }
+    uint64_t session() const noexcept { return segment_ ? segment_->header.session : 0; }
+
+private:
+    MarketDataSegment* segment_ = nullptr;
+    uint64_t published_ = 0;        // Producer's copy of segment_->published
+    char name_[64] = {};
+};
+
+/**
+ * Shared-Memory Market Data Bus: Consumer Side
+ *
+ * Maps a bus read-only: a consumer never writes shared memory, so any
+ * number of processes attach without touching the producer's lines.
+ *
+ * Key features:
+ * - attach() validates the header and starts at the live cursor; the
+ *   snapshots give the book state to start from
+ * - consume_all() hands over updates in publish order, gap free; when
+ *   the producer has lapped the cursor it stops, counts an overrun and
+ *   sets lapped() until resync()
+ * - After resync(), updates for a symbol whose feed sequence is at or
+ *   below that symbol's snapshot sequence are already in the snapshot
+ *
+ * Usage:
+ *   MarketDataBusReader bus;
+ *   if (!bus.attach("/md.book0")) return;         // Retry: producer not live
+ *
+ *   bus.consume_all([&](const LevelUpdate& u) { depth.apply(u); });
+ *   if (bus.lapped()) {
+ *       bus.resync();
+ *       depth.load(bus.snapshot(symbol));
+ *   }
+ */
+class MarketDataBusReader {
+public:
+    static constexpr size_t SLOTS = MarketDataSegment::SLOTS;
+    static constexpr size_t BATCH = 64;     // Updates copied per cursor check
+
+    MarketDataBusReader() = default;
+    ~MarketDataBusReader();
+
+    // Non-copyable, non-movable (owns the mapping)
+    MarketDataBusReader(const MarketDataBusReader&) = delete;
+    MarketDataBusReader& operator=(const MarketDataBusReader&) = delete;
+
+    // Setup (syscalls): false when absent, not yet live or incompatible
+    bool attach(const char* name);
+    void detach() noexcept;
+    bool is_attached() const noexcept { return segment_ != nullptr; }
+
+    // Consumer interface (single thread only)
+    template<typename Callback>
+    size_t consume_all(Callback&& callback, size_t max_items = SLOTS) noexcept;
+    void resync() noexcept;
+
+    BookSnapshot snapshot(SymbolId symbol) const noexcept { return segment_->snapshots[symbol].load(); }
+    bool try_snapshot(SymbolId symbol, BookSnapshot& out) const noexcept {
+        return segment_->snapshots[symbol].try_load(out);
+    }
+
+    // Status queries
+    bool lapped() const noexcept { return lapped_; }
+    uint64_t overruns() const noexcept { return overruns_; }
+    uint64_t position() const noexcept { return next_; }
+    uint64_t lag() const noexcept { return segment_->published.load(std::memory_order_acquire) - next_; }
+    uint64_t session() const noexcept { return segment_->header.session; }
+    bool producer_alive() const noexcept;
+
+private:
+    const MarketDataSegment* segment_ = nullptr;
+    uint64_t next_ = 0;             // Next bus position to read
+    bool lapped_ = false;
+    uint64_t overruns_ = 0;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+inline bool MarketDataBus::try_publish(const LevelUpdate& update) noexcept {
+    uint64_t words[BusSlot::WORDS];
+    std::memcpy(words, &update, sizeof(update));
+
+    // The slot being overwritten held position published_ - SLOTS, which
+    // readers already treat as lost once they see published_. The fence
+    // makes any reader that sees one of the new words also see that.
+    BusSlot& slot = segment_->ring[published_ & (SLOTS - 1)];
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < BusSlot::WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    segment_->published.store(++published_, std::memory_order_release);
+    return true;
+}
+
+inline void MarketDataBus::publish_snapshot(SymbolId symbol, const OrderBook& book,
+                                            Timestamp timestamp, uint64_t sequence) noexcept {
+    BookSnapshot snapshot;
+    snapshot.timestamp = timestamp;
+    snapshot.sequence = sequence;
+    snapshot.bid_count = static_cast<uint32_t>(book.depth(Side::BUY, snapshot.bids));
+    snapshot.ask_count = static_cast<uint32_t>(book.depth(Side::SELL, snapshot.asks));
+    for (size_t i = snapshot.bid_count; i < BookSnapshot::DEPTH; ++i) snapshot.bids[i] = DepthLevel{};
+    for (size_t i = snapshot.ask_count; i < BookSnapshot::DEPTH; ++i) snapshot.asks[i] = DepthLevel{};
+    segment_->snapshots[symbol].store(snapshot);
+}
+
+template<typename Callback>
+size_t MarketDataBusReader::consume_all(Callback&& callback, size_t max_items) noexcept {
+    if (UNLIKELY(lapped_)) {
+        return 0;  // Gap: resync() first
+    }
+
+    size_t consumed = 0;
+    LevelUpdate batch[BATCH];
+    while (consumed < max_items) {
+        const uint64_t published = segment_->published.load(std::memory_order_acquire);
+        if (UNLIKELY(published - next_ >= SLOTS)) {
+            lapped_ = true;
+            ++overruns_;
+            break;
+        }
+        const size_t count = std::min<uint64_t>({published - next_, max_items - consumed, BATCH});
+        if (count == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const BusSlot& slot = segment_->ring[(next_ + i) & (SLOTS - 1)];
+            uint64_t words[BusSlot::WORDS];
+            for (size_t w = 0; w < BusSlot::WORDS; ++w) {
+                words[w] = slot.words[w].load(std::memory_order_relaxed);
+            }
+            std::memcpy(&batch[i], words, sizeof(LevelUpdate));
+        }
+
+        // Slot next_ (the oldest copied) is intact while the producer has
+        // not published position next_ + SLOTS - 1 and moved on to reuse it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (UNLIKELY(segment_->published.load(std::memory_order_relaxed) - next_ >= SLOTS)) {
+            lapped_ = true;
+            ++overruns_;
+            break;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            callback(static_cast<const LevelUpdate&>(batch[i]));
+        }
+        next_ += count;
+        consumed += count;
+    }
+    return consumed;
+}
+
+inline void MarketDataBusReader::resync() noexcept {
+    next_ = segment_->published.load(std::memory_order_acquire);
+    lapped_ = false;
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "Types.h"
+#include "Message.h"
+#include "BookManager.h"
+#include "SPSCRing.h"
+#include <algorithm>
+
+/**
+ * Time-in-force and execution constraints of an incoming order, as a
+ * compile-time policy so each variant's checks fold away
+ *
+ * REST_REMAINDER  unfilled quantity rests in the book (else cancelled: IOC)
+ * ALL_OR_NONE     trade only if the whole quantity fills now (FOK)
+ * POST_ONLY       reject instead of trading if the order would cross
+ */
+template<bool RestRemainder, bool AllOrNone, bool PostOnly>
+struct OrderPolicy {
+    static_assert(!(AllOrNone && RestRemainder), "All-or-none orders never rest");
+    static_assert(!(PostOnly && !RestRemainder), "Post-only orders must be allowed to rest");
+
+    static constexpr bool REST_REMAINDER = RestRemainder;
+    static constexpr bool ALL_OR_NONE = AllOrNone;
+    static constexpr bool POST_ONLY = PostOnly;
+};
+
+using LimitOrder = OrderPolicy<true, false, false>;
+using ImmediateOrCancel = OrderPolicy<false, false, false>;
+using FillOrKill = OrderPolicy<false, true, false>;
+using PostOnlyOrder = OrderPolicy<true, false, true>;
+
+/**
+ * Outcome of one submitted order. Quantity neither filled nor rested was
+ * cancelled (IOC remainder) or never accepted.
+ */
+struct MatchResult {
+    Quantity filled = 0;
+    Quantity rested = 0;
+    bool accepted = false;
+};
+
+using MatchOutputRing = SPSCRing<Message, Config::OUTPUT_RING_SIZE, SingleWriterRingStats>;
+
+/**
+ * Price-Time Priority Matching Engine
+ *
+ * Venue mode on top of the reconstruction structures: the same
+ * BookManager, OrderPool and level windows hold the resting orders, and
+ * an incoming order that crosses executes against the opposite touch,
+ * oldest order first, level by level, before any remainder rests.
+ *
+ * Key features:
+ * - Order type chosen per call through an OrderPolicy template argument;
+ *   IOC/FOK/post-only checks are resolved at compile time
+ * - Fills walk level FIFOs by pool handle, no id lookups on the way
+ * - Output is a normalized Message feed: per fill an EXECUTE_ORDER for
+ *   the resting order and a TRADE for the aggressor (sharing a match id
+ *   in new_order_id), ADD_ORDER for a rested remainder, and the applied
+ *   CANCEL/MODIFY. BookManager::process on that feed rebuilds the book.
+ * - Output sequence numbers are the engine's own, gap-free while the
+ *   ring keeps up; a full ring drops the event and counts it
+ *
+ * Usage:
+ *   MatchOutputRing out;
+ *   MatchingEngine<MatchOutputRing> venue(books, out);
+ *
+ *   venue.submit<ImmediateOrCancel>(symbol, id, Side::BUY, 10025, 300, ts);
+ *   venue.process(msg);                          // ADD as a plain limit order
+ */
+template<typename Ring = MatchOutputRing>
+class MatchingEngine {
+public:
+    MatchingEngine(BookManager& books, Ring& ring) : books_(books), ring_(ring) {}
+
+    // Non-copyable, non-movable (holds references)
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    // Order entry (single thread only)
+    template<typename Policy = LimitOrder>
+    MatchResult submit(SymbolId symbol, OrderId id, Side side, Price price,
+                       Quantity quantity, Timestamp timestamp = 0) noexcept;
+
+    // ADD_ORDER matches as a LimitOrder; CANCEL and MODIFY apply to resting
+    // orders (a reprice that crosses matches again, losing priority).
+    // Executions and trades come only from matching, so inbound
+    // EXECUTE_ORDER/TRADE messages are rejected.
+    bool process(const Message& msg) noexcept;
+
+    // Performance monitoring
+    uint64_t matches() const noexcept { return match_id_; }
+    uint64_t matched_volume() const noexcept { return matched_volume_; }
+    uint64_t rejected_orders() const noexcept { return rejected_; }
+    uint64_t killed_orders() const noexcept { return killed_; }
+    uint64_t dropped_events() const noexcept { return dropped_; }
+    uint64_t output_sequence() const noexcept { return sequence_; }
+
+private:
+    BookManager& books_;
+    Ring& ring_;
+
+    uint64_t sequence_ = 0;
+    uint64_t match_id_ = 0;
+    uint64_t matched_volume_ = 0;
+    uint64_t rejected_ = 0;
+    uint64_t killed_ = 0;
+    uint64_t dropped_ = 0;
+
+    static bool crosses(const OrderBook& book, Side side, Price price) noexcept {
+        return side == Side::BUY ? book.has_ask() && book.best_ask() <= price
+                                 : book.has_bid() && book.best_bid() >= price;
+    }
+    static Quantity crossing_quantity(const OrderBook& book, Side side, Price price,
+                                      Quantity wanted) noexcept;
+
+    void emit(MessageType type, Timestamp timestamp, SymbolId symbol, OrderId id,
+              OrderId match, Side side, Price price, Quantity quantity) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename Ring>
+template<typename Policy>
+MatchResult MatchingEngine<Ring>::submit(SymbolId symbol, OrderId id, Side side, Price price,
+                                         Quantity quantity, Timestamp timestamp) noexcept {
+    MatchResult result;
+    OrderBook* book = books_.book(symbol);
+    if (UNLIKELY(book == nullptr || !OrderBook::is_valid_quantity(quantity) ||
+                 !OrderBook::is_valid_price(price) || books_.find_order(id) != INVALID_ORDER_HANDLE)) {
+        ++rejected_;
+        return result;
+    }
+
+    if constexpr (Policy::POST_ONLY) {
+        if (crosses(*book, side, price)) {
+            ++rejected_;
+            return result;
+        }
+    }
+    if constexpr (Policy::ALL_OR_NONE) {
+        if (crossing_quantity(*book, side, price, quantity) < quantity) {
+            ++killed_;
+            result.accepted = true;   // Accepted, then killed whole
+            return result;
+        }
+    }
+
+    // Take liquidity: the opposite touch, oldest order first
+    const Side passive = side == Side::BUY ? Side::SELL : Side::BUY;
+    Quantity remaining = quantity;
+    while (remaining != 0 && crosses(*book, side, price)) {
+        const Price level_price = side == Side::BUY ? book->best_ask() : book->best_bid();
+        const OrderHandle maker = book->level(passive, level_price).head;
+        const Order& resting = books_.pool()[maker];
+        const Quantity fill = std::min(remaining, resting.quantity);
+
+        ++match_id_;
+        emit(MessageType::EXECUTE_ORDER, timestamp, symbol, resting.id, match_id_,
+             passive, level_price, fill);
+        emit(MessageType::TRADE, timestamp, symbol, id, match_id_, side, level_price, fill);
+
+        books_.fill_order(maker, fill);
+        remaining -= fill;
+    }
+    result.filled = quantity - remaining;
+    matched_volume_ += result.filled;
+    result.accepted = true;
+
+    if constexpr (Policy::REST_REMAINDER) {
+        if (remaining != 0) {
+            if (LIKELY(books_.add_order(symbol, id, side, price, remaining))) {
+                result.rested = remaining;
+                emit(MessageType::ADD_ORDER, timestamp, symbol, id, 0, side, price, remaining);
+            } else {
+                ++rejected_;   // Pool or level storage exhausted; fills stand
+            }
+        }
+    }
+    return result;
+}
+
+template<typename Ring>
+bool MatchingEngine<Ring>::process(const Message& msg) noexcept {
+    switch (msg.type) {
+        case MessageType::ADD_ORDER:
+            return submit<LimitOrder>(msg.symbol, msg.order_id, msg.side, msg.price,
+                                      msg.quantity, msg.timestamp).accepted;
+
+        case MessageType::CANCEL_ORDER: {
+            const OrderHandle handle = books_.find_order(msg.order_id);
+            if (handle == INVALID_ORDER_HANDLE) {
+                ++rejected_;
+                return false;
+            }
+            const Order order = books_.pool()[handle];
+            books_.cancel_order(msg.order_id, msg.quantity);
+            emit(MessageType::CANCEL_ORDER, msg.timestamp, order.symbol, order.id, 0,
+                 order.side, order.price, msg.quantity);
+            return true;
+        }
+
+        case MessageType::MODIFY_ORDER: {
+            const OrderHandle handle = books_.find_order(msg.order_id);
+            if (handle == INVALID_ORDER_HANDLE) {
+                ++rejected_;
+                return false;
+            }
+            const Order order = books_.pool()[handle];
+            const OrderBook& book = *books_.book(order.symbol);
+            if (msg.quantity != 0 && crosses(book, order.side, msg.price)) {
+                // Vet the new terms as submit<LimitOrder>() will, so a
+                // rejected reprice leaves the resting order untouched
+                const OrderId id = msg.new_order_id != 0 ? msg.new_order_id : order.id;
+                if (UNLIKELY(!OrderBook::is_valid_quantity(msg.quantity) ||
+                             !OrderBook::is_valid_price(msg.price) ||
+                             (id != order.id && books_.find_order(id) != INVALID_ORDER_HANDLE))) {
+                    ++rejected_;
+                    return false;
+                }
+                // Cancel, then enter the new terms as a fresh aggressor
+                books_.cancel_order(order.id);
+                emit(MessageType::CANCEL_ORDER, msg.timestamp, order.symbol, order.id, 0,
+                     order.side, order.price, 0);
+                return submit<LimitOrder>(order.symbol, id, order.side, msg.price,
+                                          msg.quantity, msg.timestamp).accepted;
+            }
+            if (!books_.process(msg)) {
+                ++rejected_;
+                return false;
+            }
+            Message out = msg;
+            out.symbol = order.symbol;
+            out.side = order.side;
+            out.sequence = ++sequence_;
+            if (UNLIKELY(!ring_.try_emplace(out))) {
+                ++dropped_;
+            }
+            return true;
+        }
+
+        case MessageType::EXECUTE_ORDER:
+        case MessageType::TRADE:
+            ++rejected_;
+            return false;
+
+        case MessageType::HEARTBEAT:
+            return true;
+    }
+    return false;
+}
+
+template<typename Ring>
+Quantity MatchingEngine<Ring>::crossing_quantity(const OrderBook& book, Side side, Price price,
+                                                 Quantity wanted) noexcept {
+    // Sum opposite levels inside the limit, stopping once wanted is covered
+    Quantity available = 0;
+    if (side == Side::BUY) {
+        for (Price p = book.has_ask() ? book.best_ask() : LevelWindow<>::NO_PRICE;
+             p != LevelWindow<>::NO_PRICE && p <= price && available < wanted;
+             p = book.ask_levels().lowest_above(p)) {
+            available += book.level(Side::SELL, p).total_quantity;
+        }
+    } else {
+        for (Price p = book.has_bid() ? book.best_bid() : LevelWindow<>::NO_PRICE;
+             p != LevelWindow<>::NO_PRICE && p >= price && available < wanted;
+             p = book.bid_levels().highest_below(p)) {
+            available += book.level(Side::BUY, p).total_quantity;
+        }
+    }
+    return available;
+}
+
+template<typename Ring>
+void MatchingEngine<Ring>::emit(MessageType type, Timestamp timestamp, SymbolId symbol,
+                                OrderId id, OrderId match, Side side, Price price,
+                                Quantity quantity) noexcept {
+    Message out{};
+    out.timestamp = timestamp;
+    out.sequence = ++sequence_;
+    out.order_id = id;
+    out.new_order_id = match;
+    out.price = price;
+    out.quantity = quantity;
+    out.symbol = symbol;
+    out.type = type;
+    out.side = side;
+    if (UNLIKELY(!ring_.try_emplace(out))) {
+        ++dropped_;
+    }
+}
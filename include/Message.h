@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Types.h"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Normalized Market Data Message
+ *
+ * One fixed layout for every MessageType, so the feed handler, the rings
+ * and the book all move the same trivially copyable record. Fields are
+ * ordered widest-first so the payload packs with no interior padding,
+ * and the struct is cache-line aligned so each message in a ring or
+ * buffer occupies exactly one line.
+ *
+ * Field use by type:
+ *   ADD_ORDER      symbol, order_id, side, price, quantity
+ *   CANCEL_ORDER   order_id, quantity (shares cancelled; 0 deletes the order)
+ *   MODIFY_ORDER   order_id, new_order_id (0 keeps the id), price, quantity
+ *   EXECUTE_ORDER  order_id, quantity (shares executed), price (if known),
+ *                  new_order_id (match id)
+ *   TRADE          symbol, side, price, quantity, new_order_id (match id)
+ *   HEARTBEAT      timestamp, sequence only
+ *
+ * CANCEL, MODIFY and EXECUTE name their order by id alone; a symbol on
+ * them is a hint that may be missing or stale, so routers resolve the
+ * owning book from the order id (see is_order_keyed()).
+ */
+struct alignas(CACHE_LINE_SIZE) Message {
+    Timestamp timestamp;
+    uint64_t sequence;
+    OrderId order_id;
+    OrderId new_order_id;
+    Price price;
+    Quantity quantity;
+    SymbolId symbol;
+    MessageType type;
+    Side side;
+};
+
+// Bytes of a Message on the wire: the payload without the alignment tail
+constexpr size_t MESSAGE_WIRE_SIZE = offsetof(Message, side) + sizeof(Side);
+
+static_assert(std::is_trivial_v<Message>, "Message must be trivially copyable and constructible");
+static_assert(std::is_standard_layout_v<Message>, "Message layout must be fixed");
+static_assert(sizeof(Message) == CACHE_LINE_SIZE, "Message must fit one cache line");
+static_assert(MESSAGE_WIRE_SIZE == 44, "Message payload must stay tightly packed");
+
+// ============================================================================
+// WIRE ENCODING
+// ============================================================================
+
+inline bool is_valid_message(const Message& msg) noexcept {
+    const auto type = static_cast<uint8_t>(msg.type);
+    return type >= static_cast<uint8_t>(MessageType::ADD_ORDER) &&
+           type <= static_cast<uint8_t>(MessageType::HEARTBEAT) &&
+           static_cast<uint8_t>(msg.side) <= static_cast<uint8_t>(Side::SELL);
+}
+
+// CANCEL, MODIFY and EXECUTE act on a resting order found by order_id
+constexpr bool is_order_keyed(MessageType type) noexcept {
+    return type == MessageType::CANCEL_ORDER || type == MessageType::MODIFY_ORDER ||
+           type == MessageType::EXECUTE_ORDER;
+}
+
+/**
+ * Decode one message straight out of a receive buffer into its final
+ * destination (e.g. a ring slot). The wire format is the in-memory payload
+ * in host (little-endian) byte order, so decoding is a single fixed-size
+ * copy with no intermediate buffer or per-field parsing.
+ *
+ * Returns the number of bytes consumed, or 0 when the buffer is too short
+ * or holds an invalid message.
+ */
+inline size_t decode_message(const uint8_t* data, size_t length, Message& out) noexcept {
+    if (UNLIKELY(length < MESSAGE_WIRE_SIZE)) {
+        return 0;
+    }
+    std::memcpy(&out, data, MESSAGE_WIRE_SIZE);
+    return LIKELY(is_valid_message(out)) ? MESSAGE_WIRE_SIZE : 0;
+}
+
+/**
+ * Encode one message into a send buffer. Returns the number of bytes
+ * written, or 0 when the buffer is too short.
+ */
+inline size_t encode_message(const Message& msg, uint8_t* data, size_t length) noexcept {
+    if (UNLIKELY(length < MESSAGE_WIRE_SIZE)) {
+        return 0;
+    }
+    std::memcpy(data, &msg, MESSAGE_WIRE_SIZE);
+    return MESSAGE_WIRE_SIZE;
+}
+
+/**
+ * Decode a buffer of back-to-back wire messages, handing each to the
+ * callback as it is decoded. Stops at the first truncated or invalid
+ * message and returns the number of bytes consumed.
+ */
+template<typename Callback>
+size_t decode_messages(const uint8_t* data, size_t length, Callback&& callback) noexcept {
+    size_t offset = 0;
+    Message msg;
+    while (offset + MESSAGE_WIRE_SIZE <= length) {
+        if (UNLIKELY(decode_message(data + offset, length - offset, msg) == 0)) {
+            break;
+        }
+        callback(msg);
+        offset += MESSAGE_WIRE_SIZE;
+    }
+    return offset;
+}
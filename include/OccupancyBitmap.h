@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Types.h"
+#include "HugePageArena.h"
+#include <algorithm>
+
+/**
+ * Hierarchical Occupancy Bitmap
+ *
+ * One bit per index, plus two summary levels: bit w of summary_ is set
+ * when leaf word w has any bit set, and bit g of top_ when summary word g
+ * does. A nearest-set-bit search is therefore at most three masked word
+ * tests, each resolved by one leading/trailing zero count (lzcnt/tzcnt
+ * under -march=native, bsr/bsf otherwise), whatever the distance.
+ *
+ * Key features:
+ * - find_prev/find_next in constant time, no scan over empty words
+ * - set/clear touch one word per level; clear only walks up when a
+ *   word becomes zero
+ * - Up to 64^3 = 262144 bits; 8 KB of leaf words for 65536
+ * - Leaf words come from a HugePageArena when given one
+ *
+ * Usage:
+ *   OccupancyBitmap<65536> levels;
+ *
+ *   levels.set(price - MIN_PRICE);
+ *   size_t next = levels.find_prev(i);    // Highest set bit <= i, or NPOS
+ */
+template<size_t Bits>
+class OccupancyBitmap {
+    static_assert(Bits % 64 == 0, "Bits must be a multiple of 64");
+    static_assert(Bits <= 64 * 64 * 64, "Three levels cover at most 64^3 bits");
+
+public:
+    static constexpr size_t NPOS = ~size_t{0};
+    static constexpr size_t BIT_COUNT = Bits;
+
+    explicit OccupancyBitmap(HugePageArena* arena = nullptr) : words_(WORDS, arena) {
+        reset();
+    }
+
+    // Non-copyable, non-movable (owns a large leaf array)
+    OccupancyBitmap(const OccupancyBitmap&) = delete;
+    OccupancyBitmap& operator=(const OccupancyBitmap&) = delete;
+
+    // Single thread only
+    void set(size_t i) noexcept;
+    void clear(size_t i) noexcept;
+    void reset() noexcept;
+
+    bool test(size_t i) const noexcept { return (words_[i >> 6] >> (i & 63)) & 1; }
+    bool any() const noexcept { return top_ != 0; }
+
+    // Nearest set bit at or beyond i (i < Bits); NPOS if there is none
+    size_t find_prev(size_t i) const noexcept;
+    size_t find_next(size_t i) const noexcept;
+
+private:
+    static constexpr size_t WORDS = Bits / 64;
+    static constexpr size_t GROUPS = (WORDS + 63) / 64;
+
+    ArenaArray<uint64_t> words_;
+    uint64_t summary_[GROUPS];
+    uint64_t top_ = 0;
+
+    static size_t highest(uint64_t word) noexcept { return 63 - static_cast<size_t>(__builtin_clzll(word)); }
+    static size_t lowest(uint64_t word) noexcept { return static_cast<size_t>(__builtin_ctzll(word)); }
+
+    // Masks of the bits strictly below / above bit b
+    static uint64_t below(size_t b) noexcept { return (uint64_t{1} << b) - 1; }
+    static uint64_t above(size_t b) noexcept { return ~((uint64_t{2} << b) - 1); }  // 2 << 63 wraps to 0
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<size_t Bits>
+inline void OccupancyBitmap<Bits>::set(size_t i) noexcept {
+    const size_t w = i >> 6;
+    words_[w] |= uint64_t{1} << (i & 63);
+    summary_[w >> 6] |= uint64_t{1} << (w & 63);
+    top_ |= uint64_t{1} << (w >> 6);
+}
+
+template<size_t Bits>
+inline void OccupancyBitmap<Bits>::clear(size_t i) noexcept {
+    const size_t w = i >> 6;
+    if ((words_[w] &= ~(uint64_t{1} << (i & 63))) != 0) {
+        return;
+    }
+    const size_t g = w >> 6;
+    if ((summary_[g] &= ~(uint64_t{1} << (w & 63))) == 0) {
+        top_ &= ~(uint64_t{1} << g);
+    }
+}
+
+template<size_t Bits>
+void OccupancyBitmap<Bits>::reset() noexcept {
+    std::fill(words_.get(), words_.get() + WORDS, uint64_t{0});
+    std::fill(summary_, summary_ + GROUPS, uint64_t{0});
+    top_ = 0;
+}
+
+template<size_t Bits>
+inline size_t OccupancyBitmap<Bits>::find_prev(size_t i) const noexcept {
+    size_t w = i >> 6;
+    const uint64_t word = words_[w] & (below(i & 63) | (uint64_t{1} << (i & 63)));
+    if (LIKELY(word != 0)) {
+        return (w << 6) | highest(word);
+    }
+
+    size_t g = w >> 6;
+    uint64_t group = summary_[g] & below(w & 63);
+    if (group == 0) {
+        const uint64_t groups = top_ & below(g);
+        if (groups == 0) {
+            return NPOS;
+        }
+        g = highest(groups);
+        group = summary_[g];
+    }
+    w = (g << 6) | highest(group);
+    return (w << 6) | highest(words_[w]);
+}
+
+template<size_t Bits>
+inline size_t OccupancyBitmap<Bits>::find_next(size_t i) const noexcept {
+    size_t w = i >> 6;
+    const uint64_t word = words_[w] & ~below(i & 63);
+    if (LIKELY(word != 0)) {
+        return (w << 6) | lowest(word);
+    }
+
+    size_t g = w >> 6;
+    uint64_t group = summary_[g] & above(w & 63);
+    if (group == 0) {
+        const uint64_t groups = top_ & above(g);
+        if (groups == 0) {
+            return NPOS;
+        }
+        g = lowest(groups);
+        group = summary_[g];
+    }
+    w = (g << 6) | lowest(group);
+    return (w << 6) | lowest(words_[w]);
+}
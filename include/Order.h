@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Types.h"
+#include "BookSpec.h"
+
+// 32-bit slot index into an OrderPool; halves link size versus pointers
+using OrderHandle = DefaultBookSpec::handle_type;
+constexpr OrderHandle INVALID_ORDER_HANDLE = DefaultBookSpec::INVALID_HANDLE;
+
+/**
+ * Hot part of a resting order: everything fills, cancels and FIFO walks
+ * read or write. 16 bytes at the default widths.
+ */
+template<BookSpecification Spec>
+struct OrderLinks {
+    using Handle = typename Spec::handle_type;
+
+    typename Spec::quantity_type quantity = 0;  // Remaining open quantity
+    typename Spec::price_type price = 0;
+    Handle next = Spec::INVALID_HANDLE;         // Next (newer) order, or free-list link
+    Handle prev = Spec::INVALID_HANDLE;         // Previous (older) order
+};
+
+/**
+ * Cold part: identity, read when an order is reported or resolved to
+ * its book and side
+ */
+template<BookSpecification Spec>
+struct OrderInfo {
+    OrderId id = 0;
+    SymbolId symbol = 0;
+    Side side = Side::BUY;
+};
+
+/**
+ * Resting Order Node
+ *
+ * Orders are linked intrusively into the FIFO queue of their price level
+ * through pool handles, so the book never allocates on the add/cancel/
+ * execute path. Aligned to 32 bytes so two orders share a cache line and
+ * no order ever straddles one; narrower spec types only free padding.
+ *
+ * This is the interleaved record, and the value a split pool assembles
+ * from its two arrays when a whole order is read.
+ */
+template<BookSpecification Spec>
+struct alignas(32) BasicOrder : OrderLinks<Spec>, OrderInfo<Spec> {};
+
+using Order = BasicOrder<DefaultBookSpec>;
+
+static_assert(sizeof(Order) == 32, "Order must stay half a cache line");
+static_assert(sizeof(OrderLinks<DefaultBookSpec>) == 16, "Four hot records per cache line");
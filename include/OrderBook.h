@@ -0,0 +1,429 @@
+#pragma once
+
+#include "Types.h"
+#include "Order.h"
+#include "OrderPool.h"
+#include "LevelWindow.h"
+#include "HugePageArena.h"
+#include "Profiler.h"
+#include <limits>
+#include <span>
+
+/**
+ * One aggregated level of a depth snapshot
+ */
+struct DepthLevel {
+    Price price;
+    Quantity quantity;
+    uint32_t order_count;
+};
+
+/**
+ * Per-Symbol Limit Order Book
+ *
+ * Key features:
+ * - Each side's levels live in a LevelWindow: a dense window directly
+ *   indexed by price tick around the touch, plus a sparse overflow table
+ *   for far-from-touch levels, no tree or heap
+ * - Intrusive FIFO per level gives O(1) add, cancel and execute
+ * - Cached best bid/ask; only emptying the touch walks the level array
+ * - Order slots come from a shared OrderPool; never allocates after
+ *   construction
+ * - Level storage can come from a HugePageArena to cut TLB misses
+ * - Orders beyond the window are rejected only once the side's overflow
+ *   table is full (LevelWindow::OVERFLOW_CAPACITY far levels)
+ * - Tick range and stored widths fixed by the BookSpec. The interface
+ *   takes feed-width Price and Quantity and rejects what does not fit
+ *   before narrowing, so every spec is driven by the same messages.
+ *
+ * Usage:
+ *   OrderPool pool;
+ *   OrderBook book(symbol, pool);      // BasicOrderBook<Spec> for other specs
+ *
+ *   OrderHandle h = book.add_order(42, Side::BUY, 10025, 100);
+ *   book.execute_order(h, 40);
+ *   book.cancel_order(h);              // Slot returns to the pool
+ */
+template<BookSpecification Spec = DefaultBookSpec>
+class BasicOrderBook {
+public:
+    using price_type = typename Spec::price_type;
+    using quantity_type = typename Spec::quantity_type;
+    using Handle = typename Spec::handle_type;
+    using Pool = BasicOrderPool<Spec>;
+    using Levels = BasicLevelWindow<Spec>;
+    using Level = typename Levels::Level;
+
+    static constexpr Handle INVALID_HANDLE = Spec::INVALID_HANDLE;
+
+    // Sentinels returned by best_bid()/best_ask() when a side is empty
+    static constexpr Price NO_BID = Spec::MIN_PRICE - 1;
+    static constexpr Price NO_ASK = Spec::MAX_PRICE + 1;
+
+    BasicOrderBook(SymbolId symbol, Pool& pool, HugePageArena* arena = nullptr);
+    ~BasicOrderBook() = default;
+
+    // Non-copyable, non-movable (owns the levels resting orders link into)
+    BasicOrderBook(const BasicOrderBook&) = delete;
+    BasicOrderBook& operator=(const BasicOrderBook&) = delete;
+    BasicOrderBook(BasicOrderBook&&) = delete;
+    BasicOrderBook& operator=(BasicOrderBook&&) = delete;
+
+    // Order operations (single thread only). Orders that leave the book,
+    // whether cancelled or fully executed, are released back to the pool.
+    Handle add_order(OrderId id, Side side, Price price, Quantity quantity) noexcept;
+    void cancel_order(Handle handle) noexcept;
+    Quantity reduce_order(Handle handle, Quantity quantity) noexcept;
+    Quantity execute_order(Handle handle, Quantity quantity) noexcept;
+    Quantity execute_order(Handle handle, Quantity quantity, Side side) noexcept;  // Side known: no cold read
+    bool modify_order(Handle handle, Price new_price, Quantity new_quantity) noexcept;
+
+    // Book queries
+    Price best_bid() const noexcept { return best_bid_; }
+    Price best_ask() const noexcept { return best_ask_; }
+    bool has_bid() const noexcept { return best_bid_ != NO_BID; }
+    bool has_ask() const noexcept { return best_ask_ != NO_ASK; }
+
+    const Level& level(Side side, Price price) const noexcept;
+    Quantity quantity_at(Side side, Price price) const noexcept;
+
+    // Best levels of one side, best first; returns how many were filled
+    size_t depth(Side side, std::span<DepthLevel> out) const noexcept;
+    decltype(auto) order(Handle handle) const noexcept { return pool_[handle]; }
+
+    // Queue walks over hot fields only: total open quantity queued ahead
+    // of an order at its level, and each order of a level oldest first as
+    // visit(handle, quantity) (visit may execute or cancel that order)
+    Quantity quantity_ahead(Handle handle) const noexcept;
+    template<typename Visitor>
+    void for_each_order(Side side, Price price, Visitor&& visit) const noexcept;
+
+    size_t order_count() const noexcept { return order_count_; }
+    uint64_t executed_volume() const noexcept { return executed_volume_; }
+    uint64_t rejected_orders() const noexcept { return rejected_orders_; }
+    SymbolId symbol() const noexcept { return symbol_; }
+
+    const Levels& bid_levels() const noexcept { return bids_; }
+    const Levels& ask_levels() const noexcept { return asks_; }
+
+    static constexpr bool is_valid_price(Price price) noexcept {
+        return price >= Spec::MIN_PRICE && price <= Spec::MAX_PRICE;
+    }
+    static constexpr bool is_valid_quantity(Quantity quantity) noexcept {
+        return quantity != 0 && quantity <= std::numeric_limits<quantity_type>::max();
+    }
+
+private:
+    Pool& pool_;
+    Levels bids_;
+    Levels asks_;
+
+    price_type best_bid_ = NO_BID;
+    price_type best_ask_ = NO_ASK;
+    size_t order_count_ = 0;
+    uint64_t executed_volume_ = 0;
+    uint64_t rejected_orders_ = 0;
+    SymbolId symbol_;
+
+    // Helper functions
+    Levels& levels(Side side) noexcept {
+        return side == Side::BUY ? bids_ : asks_;
+    }
+
+    Quantity reduce(Handle handle, Quantity quantity, Side side) noexcept;
+    bool link(Handle handle, Side side) noexcept;
+    // recenter = false leaves the window where it is (see modify_order)
+    void unlink(Handle handle, Side side, bool recenter = true) noexcept;
+    void update_touch_on_add(Side side, price_type price) noexcept;
+    void on_level_emptied(Side side, price_type price, bool recenter) noexcept;
+    void recenter_on_touch(Side side) noexcept;
+};
+
+using OrderBook = BasicOrderBook<DefaultBookSpec>;
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<BookSpecification Spec>
+BasicOrderBook<Spec>::BasicOrderBook(SymbolId symbol, Pool& pool, HugePageArena* arena)
+    : pool_(pool),
+      bids_(arena),
+      asks_(arena),
+      symbol_(symbol) {}
+
+template<BookSpecification Spec>
+typename BasicOrderBook<Spec>::Handle
+BasicOrderBook<Spec>::add_order(OrderId id, Side side, Price price, Quantity quantity) noexcept {
+    HFT_PROFILE_ZONE(ProfileZone::BOOK_ADD);
+
+    if (UNLIKELY(!is_valid_price(price) || !is_valid_quantity(quantity))) {
+        ++rejected_orders_;
+        return INVALID_HANDLE;
+    }
+
+    const Handle handle = pool_.allocate();
+    if (UNLIKELY(handle == INVALID_HANDLE)) {
+        ++rejected_orders_;
+        return INVALID_HANDLE;  // Pool exhausted
+    }
+
+    auto& info = pool_.cold(handle);
+    info.id = id;
+    info.symbol = symbol_;
+    info.side = side;
+    auto& order = pool_.hot(handle);
+    order.price = static_cast<price_type>(price);
+    order.quantity = static_cast<quantity_type>(quantity);
+
+    if (UNLIKELY(!link(handle, side))) {
+        pool_.release(handle);
+        ++rejected_orders_;
+        return INVALID_HANDLE;  // Far level and the overflow table is full
+    }
+    update_touch_on_add(side, order.price);
+    return handle;
+}
+
+template<BookSpecification Spec>
+void BasicOrderBook<Spec>::cancel_order(Handle handle) noexcept {
+    HFT_PROFILE_ZONE(ProfileZone::BOOK_CANCEL);
+
+    unlink(handle, pool_.cold(handle).side);
+    pool_.release(handle);
+}
+
+template<BookSpecification Spec>
+Quantity BasicOrderBook<Spec>::reduce_order(Handle handle, Quantity quantity) noexcept {
+    return reduce(handle, quantity, pool_.cold(handle).side);
+}
+
+template<BookSpecification Spec>
+Quantity BasicOrderBook<Spec>::execute_order(Handle handle, Quantity quantity) noexcept {
+    return execute_order(handle, quantity, pool_.cold(handle).side);
+}
+
+template<BookSpecification Spec>
+Quantity BasicOrderBook<Spec>::execute_order(Handle handle, Quantity quantity, Side side) noexcept {
+    HFT_PROFILE_ZONE(ProfileZone::BOOK_EXECUTE);
+
+    const Quantity open = pool_.hot(handle).quantity;
+    executed_volume_ += quantity < open ? quantity : open;
+    return reduce(handle, quantity, side);
+}
+
+template<BookSpecification Spec>
+Quantity BasicOrderBook<Spec>::reduce(Handle handle, Quantity quantity, Side side) noexcept {
+    auto& order = pool_.hot(handle);
+    if (quantity >= order.quantity) {
+        unlink(handle, side);
+        pool_.release(handle);
+        return 0;
+    }
+
+    // Partial reduction keeps time priority; quantity < order.quantity fits
+    order.quantity -= static_cast<quantity_type>(quantity);
+    levels(side).at(order.price).total_quantity -= static_cast<quantity_type>(quantity);
+    return order.quantity;
+}
+
+template<BookSpecification Spec>
+bool BasicOrderBook<Spec>::modify_order(Handle handle, Price new_price,
+                                        Quantity new_quantity) noexcept {
+    HFT_PROFILE_ZONE(ProfileZone::BOOK_MODIFY);
+
+    if (UNLIKELY(!is_valid_price(new_price))) {
+        ++rejected_orders_;
+        return false;
+    }
+
+    if (new_quantity == 0) {
+        cancel_order(handle);
+        return true;
+    }
+    if (UNLIKELY(!is_valid_quantity(new_quantity))) {
+        ++rejected_orders_;
+        return false;
+    }
+
+    // Same price and smaller size keeps priority; anything else requeues
+    auto& order = pool_.hot(handle);
+    const auto price = static_cast<price_type>(new_price);
+    if (price == order.price && new_quantity <= order.quantity) {
+        reduce_order(handle, order.quantity - new_quantity);
+        return true;
+    }
+    const Side side = pool_.cold(handle).side;
+    if (UNLIKELY(!levels(side).can_acquire(price))) {
+        ++rejected_orders_;
+        return false;  // Order stays as it was
+    }
+
+    // can_acquire holds only while the window stays put: emptying the old
+    // level may move the touch, and re-centring on it before the relink
+    // could push price out of the window with the overflow full. Unlink
+    // only frees overflow room, so link cannot fail; should it anyway,
+    // the order goes back to its old price (where unlink just freed room)
+    // rather than being lost.
+    const price_type old_price = order.price;
+    const quantity_type old_quantity = order.quantity;
+    unlink(handle, side, false);
+    order.price = price;
+    order.quantity = static_cast<quantity_type>(new_quantity);
+    const bool moved = link(handle, side);
+    if (UNLIKELY(!moved)) {
+        order.price = old_price;
+        order.quantity = old_quantity;
+        link(handle, side);
+        ++rejected_orders_;
+    }
+    update_touch_on_add(side, order.price);
+    recenter_on_touch(side);
+    return moved;
+}
+
+template<BookSpecification Spec>
+const typename BasicOrderBook<Spec>::Level&
+BasicOrderBook<Spec>::level(Side side, Price price) const noexcept {
+    return (side == Side::BUY ? bids_ : asks_).get(static_cast<price_type>(price));
+}
+
+template<BookSpecification Spec>
+Quantity BasicOrderBook<Spec>::quantity_at(Side side, Price price) const noexcept {
+    return is_valid_price(price) ? level(side, price).total_quantity : 0;
+}
+
+template<BookSpecification Spec>
+size_t BasicOrderBook<Spec>::depth(Side side, std::span<DepthLevel> out) const noexcept {
+    const Levels& side_levels = side == Side::BUY ? bids_ : asks_;
+    price_type price = side == Side::BUY ? best_bid_ : best_ask_;
+    if (price == NO_BID || price == NO_ASK) {
+        return 0;
+    }
+
+    size_t filled = 0;
+    while (filled < out.size() && price != Levels::NO_PRICE) {
+        const Level& lvl = side_levels.get(price);
+        out[filled++] = DepthLevel{price, lvl.total_quantity, lvl.order_count};
+        price = side == Side::BUY ? side_levels.highest_below(price)
+                                  : side_levels.lowest_above(price);
+    }
+    return filled;
+}
+
+template<BookSpecification Spec>
+Quantity BasicOrderBook<Spec>::quantity_ahead(Handle handle) const noexcept {
+    Quantity ahead = 0;
+    for (Handle h = pool_.hot(handle).prev; h != INVALID_HANDLE; h = pool_.hot(h).prev) {
+        ahead += pool_.hot(h).quantity;
+    }
+    return ahead;
+}
+
+template<BookSpecification Spec>
+template<typename Visitor>
+void BasicOrderBook<Spec>::for_each_order(Side side, Price price, Visitor&& visit) const noexcept {
+    if (!is_valid_price(price)) {
+        return;
+    }
+    for (Handle h = level(side, price).head; h != INVALID_HANDLE;) {
+        const auto& order = pool_.hot(h);
+        const Handle next = order.next;     // visit may execute h away
+        visit(h, static_cast<Quantity>(order.quantity));
+        h = next;
+    }
+}
+
+template<BookSpecification Spec>
+bool BasicOrderBook<Spec>::link(Handle handle, Side side) noexcept {
+    auto& order = pool_.hot(handle);
+    Level* level = levels(side).acquire(order.price);
+    if (UNLIKELY(level == nullptr)) {
+        return false;
+    }
+    Level& lvl = *level;
+
+    // Append at the tail: newest order has lowest time priority
+    order.next = INVALID_HANDLE;
+    order.prev = lvl.tail;
+    if (lvl.tail != INVALID_HANDLE) {
+        pool_.hot(lvl.tail).next = handle;
+    } else {
+        lvl.head = handle;
+    }
+    lvl.tail = handle;
+
+    lvl.total_quantity += order.quantity;
+    ++lvl.order_count;
+    ++order_count_;
+    return true;
+}
+
+template<BookSpecification Spec>
+void BasicOrderBook<Spec>::unlink(Handle handle, Side side, bool recenter) noexcept {
+    auto& order = pool_.hot(handle);
+    Level& lvl = levels(side).at(order.price);
+
+    if (order.prev != INVALID_HANDLE) {
+        pool_.hot(order.prev).next = order.next;
+    } else {
+        lvl.head = order.next;
+    }
+    if (order.next != INVALID_HANDLE) {
+        pool_.hot(order.next).prev = order.prev;
+    } else {
+        lvl.tail = order.prev;
+    }
+    order.next = INVALID_HANDLE;
+    order.prev = INVALID_HANDLE;
+
+    lvl.total_quantity -= order.quantity;
+    --lvl.order_count;
+    --order_count_;
+
+    if (lvl.empty()) {
+        levels(side).release_if_empty(order.price);
+        on_level_emptied(side, order.price, recenter);
+    }
+}
+
+template<BookSpecification Spec>
+void BasicOrderBook<Spec>::update_touch_on_add(Side side, price_type price) noexcept {
+    if (side == Side::BUY) {
+        if (price > best_bid_) {
+            best_bid_ = price;
+            bids_.maybe_recenter(price);
+        }
+    } else {
+        if (price < best_ask_) {
+            best_ask_ = price;
+            asks_.maybe_recenter(price);
+        }
+    }
+}
+
+template<BookSpecification Spec>
+void BasicOrderBook<Spec>::on_level_emptied(Side side, price_type price, bool recenter) noexcept {
+    // Only the touch needs recovering; deeper levels leave the cache valid
+    if (side == Side::BUY) {
+        if (price != best_bid_) return;
+        const price_type p = bids_.highest_below(price);
+        best_bid_ = p == Levels::NO_PRICE ? NO_BID : p;
+    } else {
+        if (price != best_ask_) return;
+        const price_type p = asks_.lowest_above(price);
+        best_ask_ = p == Levels::NO_PRICE ? NO_ASK : p;
+    }
+    if (recenter) {
+        recenter_on_touch(side);
+    }
+}
+
+template<BookSpecification Spec>
+void BasicOrderBook<Spec>::recenter_on_touch(Side side) noexcept {
+    if (side == Side::BUY) {
+        if (has_bid()) bids_.maybe_recenter(best_bid_);
+    } else {
+        if (has_ask()) asks_.maybe_recenter(best_ask_);
+    }
+}
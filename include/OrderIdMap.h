@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Types.h"
+#include "Order.h"
+#include "HugePageArena.h"
+#include <limits>
+
+/**
+ * Open-Addressing OrderId -> OrderHandle Index
+ *
+ * Key features:
+ * - Flat slot array sized at compile time, never rehashes
+ * - Power-of-2 slot count at <= 50% load keeps linear probes short
+ * - Fibonacci hashing spreads the sequential ids exchanges assign
+ * - Tombstone-free deletion via backward shift, so probe chains never
+ *   degrade over a trading day of cancels
+ * - Value width follows the pool's handle type; its maximum marks empty
+ *
+ * Usage:
+ *   OrderIdMap<> index;                  // Config::MAX_ORDERS entries
+ *
+ *   index.insert(order_id, handle);
+ *   OrderHandle h = index.find(order_id);
+ *   index.erase(order_id);
+ */
+template<size_t MaxEntries = Config::MAX_ORDERS, HandleType Handle = OrderHandle>
+class OrderIdMap {
+    static_assert(MaxEntries > 0, "MaxEntries must be positive");
+
+    static constexpr size_t next_power_of_2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    static constexpr Handle INVALID_HANDLE = std::numeric_limits<Handle>::max();
+    static constexpr size_t SLOT_COUNT = next_power_of_2(MaxEntries * 2);
+
+    explicit OrderIdMap(HugePageArena* arena = nullptr);
+    ~OrderIdMap() = default;
+
+    // Non-copyable, non-movable (large owned slot array)
+    OrderIdMap(const OrderIdMap&) = delete;
+    OrderIdMap& operator=(const OrderIdMap&) = delete;
+    OrderIdMap(OrderIdMap&&) = delete;
+    OrderIdMap& operator=(OrderIdMap&&) = delete;
+
+    // Mutators (single thread only)
+    bool insert(OrderId id, Handle handle) noexcept;
+    bool erase(OrderId id) noexcept;
+    void clear() noexcept;
+
+    // Lookup; returns INVALID_HANDLE when absent
+    Handle find(OrderId id) const noexcept;
+    bool contains(OrderId id) const noexcept { return find(id) != INVALID_HANDLE; }
+
+    // Status queries
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t capacity() const noexcept { return MaxEntries; }
+
+    // Probe statistics: slots stepped past by inserts (their lookups walk
+    // the same chain), as the longest seen and the mean over all inserts
+    size_t longest_probe() const noexcept { return longest_probe_; }
+    double mean_probe() const noexcept {
+        return inserts_ == 0 ? 0.0 : static_cast<double>(probe_total_) / inserts_;
+    }
+
+private:
+    struct Slot {
+        OrderId key = 0;
+        Handle value = INVALID_HANDLE;      // INVALID marks an empty slot
+
+        bool occupied() const noexcept { return value != INVALID_HANDLE; }
+    };
+
+    ArenaArray<Slot> slots_;
+    size_t size_ = 0;
+    size_t longest_probe_ = 0;
+    uint64_t probe_total_ = 0;
+    uint64_t inserts_ = 0;
+
+    // Bit mask for fast modulo operation
+    static constexpr size_t MASK = SLOT_COUNT - 1;
+    static constexpr unsigned SHIFT = 64 - __builtin_ctzll(SLOT_COUNT);
+
+    // Helper functions
+    static size_t home_slot(OrderId id) noexcept {
+        // Fibonacci hashing: the top bits of id * 2^64/phi
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ULL) >> SHIFT) & MASK;
+    }
+
+    static size_t next_slot(size_t current) noexcept {
+        return (current + 1) & MASK;
+    }
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<size_t MaxEntries, HandleType Handle>
+OrderIdMap<MaxEntries, Handle>::OrderIdMap(HugePageArena* arena)
+    : slots_(SLOT_COUNT, arena) {}
+
+template<size_t MaxEntries, HandleType Handle>
+bool OrderIdMap<MaxEntries, Handle>::insert(OrderId id, Handle handle) noexcept {
+    if (UNLIKELY(size_ >= MaxEntries)) {
+        return false;  // Map at its sized load factor
+    }
+
+    const size_t home = home_slot(id);
+    for (size_t i = home;; i = next_slot(i)) {
+        Slot& slot = slots_[i];
+        if (!slot.occupied()) {
+            slot.key = id;
+            slot.value = handle;
+            ++size_;
+
+            const size_t probe = (i - home) & MASK;
+            probe_total_ += probe;
+            ++inserts_;
+            if (UNLIKELY(probe > longest_probe_)) {
+                longest_probe_ = probe;
+            }
+            return true;
+        }
+        if (UNLIKELY(slot.key == id)) {
+            return false;  // Duplicate id
+        }
+    }
+}
+
+template<size_t MaxEntries, HandleType Handle>
+Handle OrderIdMap<MaxEntries, Handle>::find(OrderId id) const noexcept {
+    for (size_t i = home_slot(id);; i = next_slot(i)) {
+        const Slot& slot = slots_[i];
+        if (!slot.occupied()) {
+            return INVALID_HANDLE;
+        }
+        if (slot.key == id) {
+            return slot.value;
+        }
+    }
+}
+
+template<size_t MaxEntries, HandleType Handle>
+bool OrderIdMap<MaxEntries, Handle>::erase(OrderId id) noexcept {
+    size_t hole = home_slot(id);
+    for (;; hole = next_slot(hole)) {
+        const Slot& slot = slots_[hole];
+        if (!slot.occupied()) {
+            return false;
+        }
+        if (slot.key == id) {
+            break;
+        }
+    }
+
+    // Backward-shift deletion: pull later chain members into the hole
+    // whenever the hole lies between their home slot and their position
+    for (size_t i = next_slot(hole);; i = next_slot(i)) {
+        Slot& slot = slots_[i];
+        if (!slot.occupied()) {
+            break;
+        }
+        const size_t home = home_slot(slot.key);
+        const size_t distance_from_home = (i - home) & MASK;
+        const size_t distance_to_hole = (i - hole) & MASK;
+        if (distance_from_home >= distance_to_hole) {
+            slots_[hole] = slot;
+            hole = i;
+        }
+    }
+
+    slots_[hole] = Slot{};
+    --size_;
+    return true;
+}
+
+template<size_t MaxEntries, HandleType Handle>
+void OrderIdMap<MaxEntries, Handle>::clear() noexcept {
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        slots_[i] = Slot{};
+    }
+    size_ = 0;
+    longest_probe_ = 0;
+    probe_total_ = 0;
+    inserts_ = 0;
+}
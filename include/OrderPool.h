@@ -0,0 +1,198 @@
+#pragma once
+
+#include "Types.h"
+#include "Order.h"
+#include "HugePageArena.h"
+#include <new>
+
+/**
+ * Fixed-Capacity Order Object Pool
+ *
+ * Key features:
+ * - All slots allocated and touched once at construction, never after
+ * - O(1) allocate/release through an intrusive free list
+ * - Orders addressed by 32-bit OrderHandle rather than pointer
+ * - No-throw: exhaustion returns INVALID_HANDLE and is counted
+ * - Slots can come from a HugePageArena to cut TLB misses
+ * - Handle width from the BookSpec: a 16-bit spec addresses up to 65534
+ *   orders with half-size links
+ * - Layout from the BookSpec: SPLIT keeps hot fields (quantity, price,
+ *   links) and cold ones (id, symbol, side) in parallel arrays of one
+ *   allocation, so fills and FIFO walks touch half the bytes;
+ *   INTERLEAVED keeps one 32-byte record per order
+ *
+ * The book reads and writes through hot() and cold(), which cost nothing
+ * extra in either layout. operator[] returns a whole order for readers
+ * outside the book: a reference when interleaved, an assembled copy when
+ * split.
+ *
+ * Usage:
+ *   OrderPool pool;                      // Config::MAX_ORDERS slots
+ *
+ *   OrderHandle h = pool.allocate();
+ *   if (h == INVALID_ORDER_HANDLE) { ... }   // Pool exhausted
+ *   pool.hot(h).quantity = 100;
+ *   pool.cold(h).id = 42;
+ *   pool.release(h);
+ */
+template<BookSpecification Spec = DefaultBookSpec>
+class BasicOrderPool {
+public:
+    using Handle = typename Spec::handle_type;
+    using Slot = BasicOrder<Spec>;
+    using Hot = OrderLinks<Spec>;
+    using Cold = OrderInfo<Spec>;
+
+    static constexpr Handle INVALID_HANDLE = Spec::INVALID_HANDLE;
+    static constexpr bool SPLIT = Spec::ORDER_LAYOUT == OrderLayout::SPLIT;
+
+    // capacity is clamped to Spec::MAX_ORDERS, the handle range
+    explicit BasicOrderPool(size_t capacity = Spec::MAX_ORDERS, HugePageArena* arena = nullptr);
+    ~BasicOrderPool() = default;
+
+    // Non-copyable, non-movable (handles index into owned storage)
+    BasicOrderPool(const BasicOrderPool&) = delete;
+    BasicOrderPool& operator=(const BasicOrderPool&) = delete;
+    BasicOrderPool(BasicOrderPool&&) = delete;
+    BasicOrderPool& operator=(BasicOrderPool&&) = delete;
+
+    // Allocation interface (single thread only)
+    Handle allocate() noexcept;
+    void release(Handle handle) noexcept;
+
+    // Field access (single thread only)
+    Hot& hot(Handle handle) noexcept;
+    const Hot& hot(Handle handle) const noexcept;
+    Cold& cold(Handle handle) noexcept;
+    const Cold& cold(Handle handle) const noexcept;
+
+    // Whole-order read
+    decltype(auto) operator[](Handle handle) const noexcept;
+
+    // Status queries
+    size_t capacity() const noexcept { return capacity_; }
+    size_t in_use() const noexcept { return in_use_; }
+    size_t available() const noexcept { return capacity_ - in_use_; }
+    bool exhausted() const noexcept { return free_head_ == INVALID_HANDLE; }
+
+    // Slot storage, one region in both layouts, for NUMA binding and
+    // mlock (see ThreadRuntime)
+    void* storage() noexcept { return storage_.get(); }
+    const void* storage() const noexcept { return storage_.get(); }
+    size_t storage_bytes() const noexcept { return storage_lines(capacity_) * CACHE_LINE_SIZE; }
+
+    // Performance monitoring
+    size_t high_watermark() const noexcept { return high_watermark_; }
+    uint64_t failed_allocations() const noexcept { return failed_allocations_; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) StorageLine {
+        std::byte bytes[CACHE_LINE_SIZE];
+    };
+
+    static constexpr size_t lines_for(size_t bytes) noexcept {
+        return (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE;
+    }
+    static constexpr size_t storage_lines(size_t capacity) noexcept {
+        // Hot array first, cold array from the next line on
+        return SPLIT ? lines_for(capacity * sizeof(Hot)) + lines_for(capacity * sizeof(Cold))
+                     : lines_for(capacity * sizeof(Slot));
+    }
+
+    size_t capacity_;
+    ArenaArray<StorageLine> storage_;
+    Slot* slots_ = nullptr;         // INTERLEAVED
+    Hot* hot_ = nullptr;            // SPLIT
+    Cold* cold_ = nullptr;          // SPLIT
+    Handle free_head_ = INVALID_HANDLE;
+    size_t in_use_ = 0;
+    size_t high_watermark_ = 0;
+    uint64_t failed_allocations_ = 0;
+};
+
+using OrderPool = BasicOrderPool<DefaultBookSpec>;
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<BookSpecification Spec>
+BasicOrderPool<Spec>::BasicOrderPool(size_t capacity, HugePageArena* arena)
+    : capacity_(capacity < Spec::MAX_ORDERS ? capacity : Spec::MAX_ORDERS),
+      storage_(storage_lines(capacity_), arena) {
+    std::byte* base = storage_.get()->bytes;
+    if constexpr (SPLIT) {
+        hot_ = new (base) Hot[capacity_];
+        cold_ = new (base + lines_for(capacity_ * sizeof(Hot)) * CACHE_LINE_SIZE) Cold[capacity_];
+    } else {
+        slots_ = new (base) Slot[capacity_];
+    }
+
+    // Thread the free list through every slot; this also prefaults the pages
+    for (size_t i = capacity_; i-- > 0;) {
+        hot(static_cast<Handle>(i)).next = free_head_;
+        free_head_ = static_cast<Handle>(i);
+    }
+}
+
+template<BookSpecification Spec>
+typename BasicOrderPool<Spec>::Hot& BasicOrderPool<Spec>::hot(Handle handle) noexcept {
+    if constexpr (SPLIT) return hot_[handle];
+    else return slots_[handle];
+}
+
+template<BookSpecification Spec>
+const typename BasicOrderPool<Spec>::Hot& BasicOrderPool<Spec>::hot(Handle handle) const noexcept {
+    if constexpr (SPLIT) return hot_[handle];
+    else return slots_[handle];
+}
+
+template<BookSpecification Spec>
+typename BasicOrderPool<Spec>::Cold& BasicOrderPool<Spec>::cold(Handle handle) noexcept {
+    if constexpr (SPLIT) return cold_[handle];
+    else return slots_[handle];
+}
+
+template<BookSpecification Spec>
+const typename BasicOrderPool<Spec>::Cold& BasicOrderPool<Spec>::cold(Handle handle) const noexcept {
+    if constexpr (SPLIT) return cold_[handle];
+    else return slots_[handle];
+}
+
+template<BookSpecification Spec>
+decltype(auto) BasicOrderPool<Spec>::operator[](Handle handle) const noexcept {
+    if constexpr (SPLIT) {
+        Slot order;
+        static_cast<Hot&>(order) = hot_[handle];
+        static_cast<Cold&>(order) = cold_[handle];
+        return order;
+    } else {
+        return static_cast<const Slot&>(slots_[handle]);
+    }
+}
+
+template<BookSpecification Spec>
+typename BasicOrderPool<Spec>::Handle BasicOrderPool<Spec>::allocate() noexcept {
+    const Handle handle = free_head_;
+    if (UNLIKELY(handle == INVALID_HANDLE)) {
+        ++failed_allocations_;
+        return INVALID_HANDLE;
+    }
+
+    Hot& order = hot(handle);
+    free_head_ = order.next;
+    order.next = INVALID_HANDLE;
+    order.prev = INVALID_HANDLE;
+
+    if (++in_use_ > high_watermark_) {
+        high_watermark_ = in_use_;
+    }
+    return handle;
+}
+
+template<BookSpecification Spec>
+void BasicOrderPool<Spec>::release(Handle handle) noexcept {
+    hot(handle).next = free_head_;
+    free_head_ = handle;
+    --in_use_;
+}
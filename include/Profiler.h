@@ -0,0 +1,155 @@
+#pragma once
+
+#include "Types.h"
+#include "TSCTimer.h"
+#include "SPSCRing.h"
+#include "LatencyHistogram.h"
+#include <array>
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <thread>
+
+/**
+ * Instrumentation zones. Each zone gets its own histogram in the Profiler.
+ */
+enum class ProfileZone : uint16_t {
+    BOOK_ADD = 0,
+    BOOK_CANCEL,
+    BOOK_EXECUTE,
+    BOOK_MODIFY,
+    BOOK_PROCESS,
+    FEED_PARSE,
+    COUNT
+};
+
+const char* profile_zone_name(ProfileZone zone) noexcept;
+
+/**
+ * One timed zone execution, as written to the per-thread ring
+ */
+struct ZoneSample {
+    uint64_t cycles;
+    ProfileZone zone;
+};
+
+/**
+ * Process-Wide Zone Profiler
+ *
+ * Key features:
+ * - Each instrumented thread owns an SPSCRing of ZoneSamples; the hot path
+ *   only does two rdtscp and one ring push, never formats or prints
+ * - A background thread drains every ring into per-zone LatencyHistograms
+ * - Runtime on/off switch, so compiled-in zones cost one relaxed load and
+ *   a predictable branch while disabled
+ * - Zones placed with HFT_PROFILE_ZONE compile to nothing unless the build
+ *   defines HFT_ENABLE_PROFILING (CMake option of the same name)
+ *
+ * Usage:
+ *   Profiler::instance().register_thread();    // Once per thread, at startup
+ *   Profiler::instance().start();              // Drain + enable
+ *
+ *   void OrderBook::add_order(...) {
+ *       HFT_PROFILE_ZONE(ProfileZone::BOOK_ADD);
+ *       ...
+ *   }
+ *
+ *   Profiler::instance().stop();
+ *   Profiler::instance().report(timer, std::cout);
+ */
+class Profiler {
+public:
+    static constexpr size_t RING_SIZE = 8192;
+    static constexpr size_t MAX_THREADS = 64;
+    static constexpr size_t ZONE_COUNT = static_cast<size_t>(ProfileZone::COUNT);
+
+    using ZoneRing = SPSCRing<ZoneSample, RING_SIZE, SingleWriterRingStats>;
+
+    static Profiler& instance();
+
+    // Non-copyable, non-movable (owns thread rings and the drain thread)
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Setup (allocates): give the calling thread its sample ring
+    bool register_thread();
+
+    // Background drain thread, which also toggles recording
+    void start();
+    void stop();
+
+    // Runtime switch for compiled-in zones
+    static void set_enabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+    static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    // Hot path: called by ScopedZoneTimer
+    static void record(ProfileZone zone, uint64_t cycles) noexcept {
+        if (ZoneRing* ring = thread_ring_) {
+            ring->try_emplace(ZoneSample{cycles, zone});
+        }
+    }
+
+    // Move pending samples into the histograms (the drain thread calls this)
+    size_t drain() noexcept;
+
+    // Reporting (any thread)
+    const LatencyHistogram& histogram(ProfileZone zone) const noexcept {
+        return histograms_[static_cast<size_t>(zone)];
+    }
+    uint64_t dropped_samples() const noexcept;
+    void report(const TSCTimer& timer, std::ostream& out) const;
+
+private:
+    Profiler() = default;
+    ~Profiler();
+
+    std::array<std::unique_ptr<ZoneRing>, MAX_THREADS> rings_;
+    std::atomic<size_t> ring_count_{0};
+    std::array<LatencyHistogram, ZONE_COUNT> histograms_;
+
+    std::thread drain_thread_;
+    std::atomic<bool> running_{false};
+
+    static inline std::atomic<bool> enabled_{false};
+    static inline thread_local ZoneRing* thread_ring_ = nullptr;
+};
+
+/**
+ * RAII zone timer: measures its scope in TSC cycles and hands the delta
+ * to the calling thread's profiler ring. Does nothing while profiling is
+ * disabled or the thread is unregistered.
+ */
+class ScopedZoneTimer {
+public:
+    explicit ScopedZoneTimer(ProfileZone zone) noexcept
+        : zone_(zone), start_cycles_(Profiler::enabled() ? read_tsc() : 0) {}
+
+    ~ScopedZoneTimer() {
+        if (start_cycles_ != 0) {
+            Profiler::record(zone_, read_tsc() - start_cycles_);
+        }
+    }
+
+    ScopedZoneTimer(const ScopedZoneTimer&) = delete;
+    ScopedZoneTimer& operator=(const ScopedZoneTimer&) = delete;
+
+private:
+    ProfileZone zone_;
+    uint64_t start_cycles_;
+
+    static uint64_t read_tsc() noexcept {
+        uint32_t aux;
+        return rdtscp(&aux);
+    }
+};
+
+// Zone macro: compiled out entirely unless HFT_ENABLE_PROFILING is defined
+#define HFT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HFT_PROFILE_CONCAT(a, b) HFT_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef HFT_ENABLE_PROFILING
+    #define HFT_PROFILE_ZONE(zone) \
+        ScopedZoneTimer HFT_PROFILE_CONCAT(hft_profile_zone_, __LINE__)(zone)
+#else
+    #define HFT_PROFILE_ZONE(zone) ((void)0)
+#endif
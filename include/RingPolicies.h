@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Types.h"
+#include <atomic>
+#include <immintrin.h>
+
+// ============================================================================
+// STATISTICS POLICIES
+// ============================================================================
+//
+// Rings record push/pop counts through a Stats template policy so the cost
+// can be chosen per ring. Producer-written and consumer-written counters
+// live on separate cache lines in the policies that keep them. The single
+// consumer also reports the backlog it finds each time it reloads the
+// producer index, so the policy can keep an occupancy high-watermark.
+
+/**
+ * No statistics: every hook compiles away and the policy takes no space.
+ */
+struct NoRingStats {
+    void record_push(uint64_t) noexcept {}
+    void record_pop(uint64_t) noexcept {}
+    void record_failed_push(uint64_t) noexcept {}
+    void record_backlog(uint64_t) noexcept {}
+
+    uint64_t pushes() const noexcept { return 0; }
+    uint64_t pops() const noexcept { return 0; }
+    uint64_t failed_pushes() const noexcept { return 0; }
+    uint64_t max_backlog() const noexcept { return 0; }
+};
+
+/**
+ * Single-writer counters: each counter has exactly one writing thread, so
+ * a relaxed load + store replaces the locked RMW of fetch_add. Readers on
+ * other threads still see torn-free (if slightly stale) values.
+ */
+struct SingleWriterRingStats {
+    void record_push(uint64_t n) noexcept { bump(push_count_, n); }
+    void record_pop(uint64_t n) noexcept { bump(pop_count_, n); }
+    void record_failed_push(uint64_t n) noexcept { bump(failed_push_count_, n); }
+    void record_backlog(uint64_t n) noexcept { raise(max_backlog_, n); }
+
+    uint64_t pushes() const noexcept { return push_count_.load(std::memory_order_relaxed); }
+    uint64_t pops() const noexcept { return pop_count_.load(std::memory_order_relaxed); }
+    uint64_t failed_pushes() const noexcept { return failed_push_count_.load(std::memory_order_relaxed); }
+    uint64_t max_backlog() const noexcept { return max_backlog_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> push_count_{0};     // Producer writes
+    std::atomic<uint64_t> failed_push_count_{0};                        // Producer writes
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> pop_count_{0};      // Consumer writes
+    std::atomic<uint64_t> max_backlog_{0};                              // Consumer writes
+
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    static void raise(std::atomic<uint64_t>& peak, uint64_t n) noexcept {
+        if (UNLIKELY(n > peak.load(std::memory_order_relaxed))) {
+            peak.store(n, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Atomic RMW counters: fetch_add on every update. Safe with any number of
+ * writers; the original SPSCRing behaviour.
+ */
+struct AtomicRingStats {
+    void record_push(uint64_t n) noexcept { push_count_.fetch_add(n, std::memory_order_relaxed); }
+    void record_pop(uint64_t n) noexcept { pop_count_.fetch_add(n, std::memory_order_relaxed); }
+    void record_failed_push(uint64_t n) noexcept { failed_push_count_.fetch_add(n, std::memory_order_relaxed); }
+    void record_backlog(uint64_t n) noexcept {
+        // Only the consumer writes the peak: no RMW needed
+        if (UNLIKELY(n > max_backlog_.load(std::memory_order_relaxed))) {
+            max_backlog_.store(n, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t pushes() const noexcept { return push_count_.load(std::memory_order_relaxed); }
+    uint64_t pops() const noexcept { return pop_count_.load(std::memory_order_relaxed); }
+    uint64_t failed_pushes() const noexcept { return failed_push_count_.load(std::memory_order_relaxed); }
+    uint64_t max_backlog() const noexcept { return max_backlog_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> push_count_{0};
+    std::atomic<uint64_t> pop_count_{0};
+    std::atomic<uint64_t> failed_push_count_{0};
+    std::atomic<uint64_t> max_backlog_{0};
+};
+
+// ============================================================================
+// WAKE POLICIES
+// ============================================================================
+//
+// Whether a side of the ring may sleep in the kernel. The ring calls
+// wake() after every index publish on every path (try_emplace, batches,
+// commit/release as well as blocking push/pop), so a sleeper is woken
+// whichever producer or consumer interface the other side uses.
+
+/**
+ * Nobody sleeps: wake() compiles away. Blocking calls can only spin.
+ */
+struct NoRingWake {
+    static constexpr bool CAN_SLEEP = false;
+
+    template<typename Index>
+    void wake(std::atomic<Index>&) noexcept {}
+};
+
+/**
+ * One side may sleep on the other's index (futex via std::atomic::wait).
+ * Publishes pay a full fence and a load of the sleeper count, and a
+ * syscall only while someone sleeps: for rings feeding non-critical
+ * threads such as loggers, not for the feed path.
+ */
+struct FutexRingWake {
+    static constexpr bool CAN_SLEEP = true;
+
+    template<typename Index>
+    void wake(std::atomic<Index>& index) noexcept {
+        // Pairs with the RMW in sleep(): either the sleeper is counted
+        // here, or its wait() already sees the index just published
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (UNLIKELY(sleepers_.load(std::memory_order_relaxed) != 0)) {
+            index.notify_all();
+        }
+    }
+
+    template<typename Index>
+    void sleep(const std::atomic<Index>& index, Index observed) noexcept {
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        index.wait(observed, std::memory_order_acquire);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> sleepers_{0};
+};
+
+// ============================================================================
+// WAIT STRATEGIES
+// ============================================================================
+//
+// Blocking ring operations construct one strategy object per call and call
+// wait() each time they find the ring full/empty. wait() receives the
+// ring's wake policy, the index the caller is blocked on and the value it
+// last observed.
+
+/**
+ * Spin on the index with no pause. Lowest wake-up latency; for threads
+ * that own an isolated core.
+ */
+struct BusySpinWait {
+    template<typename Wake, typename Index>
+    void wait(Wake&, const std::atomic<Index>&, Index) noexcept {}
+};
+
+/**
+ * Spin with exponentially growing bursts of PAUSE. Yields pipeline
+ * resources to the sibling hyperthread and eases memory-order machine
+ * clears while staying in user space.
+ */
+struct PauseBackoffWait {
+    static constexpr uint32_t MAX_PAUSES = 64;
+
+    template<typename Wake, typename Index>
+    void wait(Wake&, const std::atomic<Index>&, Index) noexcept {
+        for (uint32_t i = 0; i < pauses_; ++i) {
+            _mm_pause();
+        }
+        if (pauses_ < MAX_PAUSES) {
+            pauses_ <<= 1;
+        }
+    }
+
+private:
+    uint32_t pauses_ = 1;
+};
+
+/**
+ * Sleep in the kernel until the index moves. For non-critical consumers
+ * such as loggers: they burn no core, at the price of a wake-up syscall.
+ * Only rings built with FutexRingWake accept it (a compile error
+ * otherwise), since those are the rings whose publishes wake sleepers.
+ */
+struct FutexWait {
+    template<typename Wake, typename Index>
+    void wait(Wake& wake, const std::atomic<Index>& index, Index observed) noexcept {
+        static_assert(Wake::CAN_SLEEP, "FutexWait needs a ring built with FutexRingWake");
+        wake.sleep(index, observed);
+    }
+};
+
+// ============================================================================
+// STORAGE POLICIES
+// ============================================================================
+//
+// Where a ring keeps its slots. A policy provides data(), a pointer to
+// Size contiguous slots. ArenaRingStorage (HugePageArena.h) is the
+// huge-page backed alternative.
+
+/**
+ * Slots embedded in the ring object itself, on their own cache lines.
+ * Trivial T is left unconstructed.
+ */
+template<typename T, size_t Size>
+struct InlineRingStorage {
+    T* data() noexcept { return slots_; }
+    const T* data() const noexcept { return slots_; }
+
+private:
+    alignas(CACHE_LINE_SIZE) T slots_[Size];
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Types.h"
+#include "RingPolicies.h"
 #include <atomic>
 #include <memory>
 #include <cstring>
+#include <span>
+#include <algorithm>
 
 /**
  * Lock-Free Single Producer Single Consumer Ring Buffer
@@ -13,6 +16,16 @@
  * - Cache line aligned to prevent false sharing
  * - Power-of-2 sizing for fast modulo with bit masks
  * - Memory ordering optimized for performance
+ * - Each side caches the other side's index and only reloads it when the
+ *   cached value says the ring looks full (producer) or empty (consumer),
+ *   so the other core's cache line is not pulled over on every operation
+ * - Statistics are a policy: NoRingStats, SingleWriterRingStats (relaxed
+ *   stores, no locked RMW) or AtomicRingStats (fetch_add, the default)
+ * - Slot storage is a policy too: InlineRingStorage (a T[Size] array inside
+ *   the ring, the default) or ArenaRingStorage (slots from a HugePageArena)
+ * - Blocking push/pop take a wait strategy: BusySpinWait, PauseBackoffWait
+ *   or FutexWait. FutexWait needs the FutexRingWake policy, under which
+ *   every publish wakes a sleeper (see RingPolicies.h)
  * 
  * Usage:
  *   SPSCRing<Message, 1024> ring;
@@ -23,17 +36,45 @@
  *   // Consumer thread:
  *   Message msg;
  *   if (ring.try_pop(msg)) { ... }
+ *
+ * Batch usage (one index publish and one counter update per batch):
+ *   ring.try_push_n(std::span<const Message>(batch, n));
+ *   ring.consume_all([](Message& msg) { ... }, 64);
+ *
+ * Blocking usage:
+ *   SPSCRing<Message, 1024, SingleWriterRingStats> ring;
+ *   ring.push<PauseBackoffWait>(message);
+ *   ring.pop<PauseBackoffWait>(msg);
+ *
+ * Sleeping logger (the engine side may keep using try_emplace/reserve):
+ *   SPSCRing<LogRecord, 1024, SingleWriterRingStats, InlineRingStorage, FutexRingWake> log;
+ *   log.try_emplace(record);                      // Engine thread
+ *   log.pop<FutexWait>(record);                   // Logger thread
+ *
+ * Zero-copy usage (build and read messages in place in the ring slot):
+ *   if (Message* slot = ring.reserve()) { decode_into(*slot); ring.commit(); }
+ *   if (const Message* msg = ring.peek()) { apply(*msg); ring.release(); }
+ *
+ * Huge-page usage (slots live in the arena, which must outlive the ring):
+ *   HugePageArena arena(64 << 20);
+ *   SPSCRing<Message, 65536, AtomicRingStats, ArenaRingStorage> ring(arena);
  */
-template<typename T, size_t Size>
+template<typename T, size_t Size, typename Stats = AtomicRingStats,
+         template<typename, size_t> class Storage = InlineRingStorage,
+         typename Wake = NoRingWake>
 class SPSCRing {
     // Ensure Size is power of 2 for bit-mask optimization
     static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
     static_assert(Size >= 2, "Size must be at least 2");
     
 public:
-    SPSCRing();
+    SPSCRing() = default;
     ~SPSCRing() = default;
     
+    // External slot storage, e.g. ArenaRingStorage from a HugePageArena
+    template<typename Arena>
+    explicit SPSCRing(Arena& arena) : storage_(arena) {}
+    
     // Non-copyable, non-movable (contains atomics)
     SPSCRing(const SPSCRing&) = delete;
     SPSCRing& operator=(const SPSCRing&) = delete;
@@ -44,8 +85,31 @@ public:
     bool try_emplace(const T& item) noexcept;
     bool try_emplace(T&& item) noexcept;
     
+    size_t try_push_n(std::span<const T> items) noexcept;
+    
+    // In-place producer interface: reserve() hands out the next free slot
+    // (nullptr when full), commit() publishes it to the consumer
+    T* reserve() noexcept;
+    void commit() noexcept;
+    
+    // Blocking producer: waits with the given strategy while full
+    template<typename Wait = BusySpinWait>
+    void push(const T& item) noexcept;
+    
     // Consumer interface (single thread only)
     bool try_pop(T& item) noexcept;
+    size_t try_pop_n(std::span<T> items) noexcept;
+    template<typename Callback>
+    size_t consume_all(Callback&& callback, size_t max_items = Size) noexcept;
+    
+    // In-place consumer interface: peek() exposes the oldest item (nullptr
+    // when empty) without copying it, release() hands the slot back
+    const T* peek() noexcept;
+    void release() noexcept;
+    
+    // Blocking consumer: waits with the given strategy while empty
+    template<typename Wait = BusySpinWait>
+    void pop(T& item) noexcept;
     
     // Status queries (can be called from any thread)
     bool empty() const noexcept;
@@ -53,26 +117,32 @@ public:
     size_t size() const noexcept;
     size_t capacity() const noexcept { return Size - 1; }  // One slot reserved
     
-    // Performance monitoring
-    uint64_t total_pushes() const noexcept { return push_count_.load(std::memory_order_relaxed); }
-    uint64_t total_pops() const noexcept { return pop_count_.load(std::memory_order_relaxed); }
-    uint64_t failed_pushes() const noexcept { return failed_push_count_.load(std::memory_order_relaxed); }
+    // Performance monitoring (always 0 with NoRingStats). The high-watermark
+    // is the deepest backlog the consumer found when it reloaded head_.
+    uint64_t total_pushes() const noexcept { return stats_.pushes(); }
+    uint64_t total_pops() const noexcept { return stats_.pops(); }
+    uint64_t failed_pushes() const noexcept { return stats_.failed_pushes(); }
+    uint64_t high_watermark() const noexcept { return stats_.max_backlog(); }
     
 private:
-    // Cache line alignment prevents false sharing between producer and consumer
+    // Cache line alignment prevents false sharing between producer and consumer.
+    // Each cached index is private to the side that owns that line.
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};     // Producer writes here
+    size_t cached_tail_ = 0;                                   // Producer's copy of tail_
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};     // Consumer reads here
-    alignas(CACHE_LINE_SIZE) T buffer_[Size];                  // The actual ring buffer
+    size_t cached_head_ = 0;                                   // Consumer's copy of head_
+    Storage<T, Size> storage_;                                 // The actual ring buffer
     
-    // Performance counters (aligned to separate cache line)
-    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> push_count_{0};
-    std::atomic<uint64_t> pop_count_{0};
-    std::atomic<uint64_t> failed_push_count_{0};
+    // Performance counters (policy keeps them off the index cache lines)
+    [[no_unique_address]] Stats stats_;
+    [[no_unique_address]] Wake wake_;                          // Sleeper wake-up
     
     // Bit mask for fast modulo operation
     static constexpr size_t MASK = Size - 1;
     
     // Helper functions
+    T* slots() noexcept { return storage_.data(); }
+    
     size_t next_index(size_t current) const noexcept {
         return (current + 1) & MASK;
     }
@@ -82,93 +152,287 @@ private:
 // IMPLEMENTATION
 // ============================================================================
 
-template<typename T, size_t Size>
-SPSCRing<T, Size>::SPSCRing() {
-    // Initialize buffer with default-constructed objects
-    for (size_t i = 0; i < Size; ++i) {
-        new (&buffer_[i]) T{};
-    }
-}
-
-template<typename T, size_t Size>
-bool SPSCRing<T, Size>::try_emplace(const T& item) noexcept {
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+bool SPSCRing<T, Size, Stats, Storage, Wake>::try_emplace(const T& item) noexcept {
     // Load current head position (where we want to write)
     const size_t current_head = head_.load(std::memory_order_relaxed);
     const size_t next_head = next_index(current_head);
     
     // Check if buffer is full by comparing with tail
     // We need one empty slot to distinguish full from empty
-    if (UNLIKELY(next_head == tail_.load(std::memory_order_acquire))) {
-        failed_push_count_.fetch_add(1, std::memory_order_relaxed);
-        return false;  // Buffer full
+    // Only reload the real tail when the cached copy says we are full
+    if (UNLIKELY(next_head == cached_tail_)) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (next_head == cached_tail_) {
+            stats_.record_failed_push(1);
+            return false;  // Buffer full
+        }
     }
     
     // Write the item to the buffer
-    buffer_[current_head] = item;
+    slots()[current_head] = item;
     
     // Update head pointer - this makes the item visible to consumer
     // Use release semantics to ensure the write above happens before this
     head_.store(next_head, std::memory_order_release);
+    wake_.wake(head_);
     
-    push_count_.fetch_add(1, std::memory_order_relaxed);
+    stats_.record_push(1);
     return true;
 }
 
-template<typename T, size_t Size>
-bool SPSCRing<T, Size>::try_emplace(T&& item) noexcept {
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+bool SPSCRing<T, Size, Stats, Storage, Wake>::try_emplace(T&& item) noexcept {
     const size_t current_head = head_.load(std::memory_order_relaxed);
     const size_t next_head = next_index(current_head);
     
-    if (UNLIKELY(next_head == tail_.load(std::memory_order_acquire))) {
-        failed_push_count_.fetch_add(1, std::memory_order_relaxed);
-        return false;  // Buffer full
+    if (UNLIKELY(next_head == cached_tail_)) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (next_head == cached_tail_) {
+            stats_.record_failed_push(1);
+            return false;  // Buffer full
+        }
     }
     
     // Move the item into the buffer
-    buffer_[current_head] = std::move(item);
+    slots()[current_head] = std::move(item);
     
     head_.store(next_head, std::memory_order_release);
-    push_count_.fetch_add(1, std::memory_order_relaxed);
+    wake_.wake(head_);
+    stats_.record_push(1);
     return true;
 }
 
-template<typename T, size_t Size>
-bool SPSCRing<T, Size>::try_pop(T& item) noexcept {
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+bool SPSCRing<T, Size, Stats, Storage, Wake>::try_pop(T& item) noexcept {
     // Load current tail position (where we read from)
     const size_t current_tail = tail_.load(std::memory_order_relaxed);
     
     // Check if buffer is empty
-    if (UNLIKELY(current_tail == head_.load(std::memory_order_acquire))) {
-        return false;  // Buffer empty
+    // Only reload the real head when the cached copy says we are empty
+    if (UNLIKELY(current_tail == cached_head_)) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (current_tail == cached_head_) {
+            return false;  // Buffer empty
+        }
+        stats_.record_backlog((cached_head_ - current_tail) & MASK);
     }
     
     // Read the item from the buffer
-    item = std::move(buffer_[current_tail]);
+    item = std::move(slots()[current_tail]);
     
     // Update tail pointer - this frees up the slot for producer
     // Use release semantics to ensure the read above happens before this
     const size_t next_tail = next_index(current_tail);
     tail_.store(next_tail, std::memory_order_release);
+    wake_.wake(tail_);
     
-    pop_count_.fetch_add(1, std::memory_order_relaxed);
+    stats_.record_pop(1);
     return true;
 }
 
-template<typename T, size_t Size>
-bool SPSCRing<T, Size>::empty() const noexcept {
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+size_t SPSCRing<T, Size, Stats, Storage, Wake>::try_push_n(std::span<const T> items) noexcept {
+    const size_t current_head = head_.load(std::memory_order_relaxed);
+    size_t free_slots = (cached_tail_ - current_head - 1) & MASK;
+    if (free_slots < items.size()) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        free_slots = (cached_tail_ - current_head - 1) & MASK;
+    }
+    const size_t count = std::min(items.size(), free_slots);
+    
+    if (UNLIKELY(count < items.size())) {
+        stats_.record_failed_push(items.size() - count);
+        if (count == 0) {
+            return 0;  // Buffer full
+        }
+    }
+    
+    // Copy in at most two contiguous runs (before and after the wrap)
+    const size_t first_run = std::min(count, Size - current_head);
+    std::copy_n(items.begin(), first_run, slots() + current_head);
+    std::copy_n(items.begin() + first_run, count - first_run, slots());
+    
+    // Publish the whole batch with a single release store
+    head_.store((current_head + count) & MASK, std::memory_order_release);
+    wake_.wake(head_);
+    stats_.record_push(count);
+    return count;
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+size_t SPSCRing<T, Size, Stats, Storage, Wake>::try_pop_n(std::span<T> items) noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    size_t available = (cached_head_ - current_tail) & MASK;
+    if (available < items.size()) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        available = (cached_head_ - current_tail) & MASK;
+        stats_.record_backlog(available);
+    }
+    const size_t count = std::min(items.size(), available);
+    
+    if (count == 0) {
+        return 0;  // Buffer empty
+    }
+    
+    const size_t first_run = std::min(count, Size - current_tail);
+    std::move(slots() + current_tail, slots() + current_tail + first_run, items.begin());
+    std::move(slots(), slots() + (count - first_run), items.begin() + first_run);
+    
+    // Free the whole batch with a single release store
+    tail_.store((current_tail + count) & MASK, std::memory_order_release);
+    wake_.wake(tail_);
+    stats_.record_pop(count);
+    return count;
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+template<typename Callback>
+size_t SPSCRing<T, Size, Stats, Storage, Wake>::consume_all(Callback&& callback, size_t max_items) noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    size_t available = (cached_head_ - current_tail) & MASK;
+    if (available < max_items) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        available = (cached_head_ - current_tail) & MASK;
+        stats_.record_backlog(available);
+    }
+    const size_t count = std::min(max_items, available);
+    
+    // Hand each slot to the callback in place; slots stay owned by the
+    // consumer until the tail store below releases them to the producer
+    for (size_t i = 0; i < count; ++i) {
+        callback(slots()[(current_tail + i) & MASK]);
+    }
+    
+    if (count != 0) {
+        tail_.store((current_tail + count) & MASK, std::memory_order_release);
+        wake_.wake(tail_);
+        stats_.record_pop(count);
+    }
+    return count;
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+template<typename Wait>
+void SPSCRing<T, Size, Stats, Storage, Wake>::push(const T& item) noexcept {
+    Wait waiter;
+    const size_t current_head = head_.load(std::memory_order_relaxed);
+    const size_t next_head = next_index(current_head);
+    
+    while (UNLIKELY(next_head == cached_tail_)) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (next_head != cached_tail_) {
+            break;
+        }
+        waiter.wait(wake_, tail_, cached_tail_);
+    }
+    
+    slots()[current_head] = item;
+    head_.store(next_head, std::memory_order_release);
+    wake_.wake(head_);
+    stats_.record_push(1);
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+template<typename Wait>
+void SPSCRing<T, Size, Stats, Storage, Wake>::pop(T& item) noexcept {
+    Wait waiter;
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    
+    while (UNLIKELY(current_tail == cached_head_)) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (current_tail != cached_head_) {
+            stats_.record_backlog((cached_head_ - current_tail) & MASK);
+            break;
+        }
+        waiter.wait(wake_, head_, cached_head_);
+    }
+    
+    item = std::move(slots()[current_tail]);
+    tail_.store(next_index(current_tail), std::memory_order_release);
+    wake_.wake(tail_);
+    stats_.record_pop(1);
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+T* SPSCRing<T, Size, Stats, Storage, Wake>::reserve() noexcept {
+    const size_t current_head = head_.load(std::memory_order_relaxed);
+    const size_t next_head = next_index(current_head);
+    
+    if (UNLIKELY(next_head == cached_tail_)) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (next_head == cached_tail_) {
+            stats_.record_failed_push(1);
+            return nullptr;  // Buffer full
+        }
+    }
+    
+    // The slot is invisible to the consumer until commit()
+    return &slots()[current_head];
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+void SPSCRing<T, Size, Stats, Storage, Wake>::commit() noexcept {
+    const size_t current_head = head_.load(std::memory_order_relaxed);
+    head_.store(next_index(current_head), std::memory_order_release);
+    wake_.wake(head_);
+    stats_.record_push(1);
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+const T* SPSCRing<T, Size, Stats, Storage, Wake>::peek() noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    
+    if (UNLIKELY(current_tail == cached_head_)) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (current_tail == cached_head_) {
+            return nullptr;  // Buffer empty
+        }
+        stats_.record_backlog((cached_head_ - current_tail) & MASK);
+    }
+    
+    // The slot stays owned by the consumer until release()
+    return &slots()[current_tail];
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+void SPSCRing<T, Size, Stats, Storage, Wake>::release() noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    tail_.store(next_index(current_tail), std::memory_order_release);
+    wake_.wake(tail_);
+    stats_.record_pop(1);
+}
+
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+bool SPSCRing<T, Size, Stats, Storage, Wake>::empty() const noexcept {
     return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
 }
 
-template<typename T, size_t Size>
-bool SPSCRing<T, Size>::full() const noexcept {
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+bool SPSCRing<T, Size, Stats, Storage, Wake>::full() const noexcept {
     const size_t head = head_.load(std::memory_order_acquire);
     const size_t tail = tail_.load(std::memory_order_acquire);
     return next_index(head) == tail;
 }
 
-template<typename T, size_t Size>
-size_t SPSCRing<T, Size>::size() const noexcept {
+template<typename T, size_t Size, typename Stats, template<typename, size_t> class Storage,
+         typename Wake>
+size_t SPSCRing<T, Size, Stats, Storage, Wake>::size() const noexcept {
     const size_t head = head_.load(std::memory_order_acquire);
     const size_t tail = tail_.load(std::memory_order_acquire);
     return (head - tail) & MASK;
-}
\ No newline at end of file
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Types.h"
+#include <atomic>
+#include <cstring>
+#include <immintrin.h>
+#include <type_traits>
+
+/**
+ * Single-Writer Seqlock Cell
+ *
+ * Key features:
+ * - Writer never waits: bumps the sequence to odd, stores the value,
+ *   bumps it to even
+ * - Readers never write shared memory, so any number of cores can poll
+ *   without bouncing the line between them
+ * - The value is held as relaxed atomic words, so a reader racing the
+ *   writer sees a torn copy it then discards, never undefined behaviour
+ * - One cache line for small T (a top-of-book fits)
+ *
+ * Usage:
+ *   Seqlock<TopOfBook> cell;
+ *
+ *   cell.store(tob);                       // Writer thread
+ *
+ *   TopOfBook seen;
+ *   if (cell.try_load(seen)) { ... }       // Any reader; false mid-write
+ *   TopOfBook now = cell.load();           // Retries until consistent
+ */
+template<typename T>
+class alignas(CACHE_LINE_SIZE) Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock copies T word by word");
+
+public:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    // Reads as all-zero bytes until the first store
+    Seqlock() noexcept {
+        for (auto& word : words_) word.store(0, std::memory_order_relaxed);
+    }
+
+    // Non-copyable (readers and the writer share this object)
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    // Writer interface (single thread only)
+    void store(const T& value) noexcept;
+
+    // Reader interface (any thread)
+    bool try_load(T& out) const noexcept;
+    T load() const noexcept;
+
+    // Even, and advanced by 2 per store: pollers compare to detect change
+    uint64_t version() const noexcept { return sequence_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[WORDS];
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename T>
+void Seqlock<T>::store(const T& value) noexcept {
+    uint64_t words[WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+
+    const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < WORDS; ++i) {
+        words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(seq + 2, std::memory_order_release);
+}
+
+template<typename T>
+bool Seqlock<T>::try_load(T& out) const noexcept {
+    const uint64_t before = sequence_.load(std::memory_order_acquire);
+    if (UNLIKELY((before & 1) != 0)) {
+        return false;  // Writer mid-store
+    }
+
+    uint64_t words[WORDS];
+    for (size_t i = 0; i < WORDS; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (UNLIKELY(sequence_.load(std::memory_order_relaxed) != before)) {
+        return false;  // Overwritten while we copied
+    }
+
+    std::memcpy(&out, words, sizeof(T));
+    return true;
+}
+
+template<typename T>
+T Seqlock<T>::load() const noexcept {
+    T out;
+    while (!try_load(out)) {
+        _mm_pause();
+    }
+    return out;
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+#include "Types.h"
+#include "Message.h"
+#include "BookManager.h"
+#include "OrderIdMap.h"
+#include "OrderPool.h"
+#include "SPSCRing.h"
+#include "ThreadRuntime.h"
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <span>
+
+/**
+ * Static SymbolId -> shard assignment
+ *
+ * Built once per session, before the engine starts. from_weights() spreads
+ * symbols by expected load (e.g. the previous session's message counts)
+ * with a greedy longest-processing-time pass: heaviest symbol first, each
+ * onto the currently lightest shard.
+ */
+class ShardRouter {
+public:
+    // Round-robin over shard_count shards
+    explicit ShardRouter(size_t shard_count = 1) noexcept;
+
+    static ShardRouter from_weights(std::span<const uint64_t> weights, size_t shard_count);
+
+    // Weight files hold one "symbol weight" pair per line
+    static bool load_weights(const char* path, std::span<uint64_t> weights);
+    static bool save_weights(const char* path, std::span<const uint64_t> weights);
+
+    size_t shard_of(SymbolId symbol) const noexcept { return table_[symbol]; }
+    void assign(SymbolId symbol, size_t shard) noexcept;
+    size_t shard_count() const noexcept { return shard_count_; }
+    size_t symbols_on(size_t shard) const noexcept;
+
+private:
+    std::array<uint8_t, Config::MAX_SYMBOLS> table_{};
+    size_t shard_count_;
+};
+
+/**
+ * Feed-Side Order Ownership Table
+ *
+ * CANCEL, MODIFY and EXECUTE carry no reliable symbol (see Message.h), so
+ * the feed thread remembers the symbol each live order was added under
+ * and its open quantity, mirroring the book's delete rules: a full
+ * cancel, a fill of what is left, a modify to 0 or a replace retire or
+ * rename the entry. Ids it never saw keep their message's own symbol.
+ *
+ * Usage:
+ *   OrderRoutes routes;
+ *
+ *   SymbolId symbol = routes.owner(msg.order_id);   // NO_OWNER if unknown
+ *   routes.record(msg);                             // Once msg is sent on
+ */
+class OrderRoutes {
+public:
+    static constexpr SymbolId NO_OWNER = std::numeric_limits<SymbolId>::max();
+
+    // capacity is clamped to Config::MAX_ORDERS, the index capacity
+    explicit OrderRoutes(size_t capacity = Config::MAX_ORDERS);
+
+    // Non-copyable, non-movable (owns a pool and its index)
+    OrderRoutes(const OrderRoutes&) = delete;
+    OrderRoutes& operator=(const OrderRoutes&) = delete;
+    OrderRoutes(OrderRoutes&&) = delete;
+    OrderRoutes& operator=(OrderRoutes&&) = delete;
+
+    SymbolId owner(OrderId id) const noexcept;
+    void record(const Message& msg) noexcept;
+
+    // Status queries
+    size_t size() const noexcept { return index_.size(); }
+    uint64_t untracked_adds() const noexcept { return pool_.failed_allocations(); }
+
+private:
+    OrderPool pool_;
+    OrderIdMap<> index_;
+
+    void retire(OrderId id, OrderHandle handle) noexcept;
+    void reduce(OrderId id, OrderHandle handle, Quantity quantity) noexcept;
+};
+
+/**
+ * Engine-wide settings; placements[i] applies to shard i's book thread
+ */
+struct EngineConfig {
+    size_t orders_per_shard = Config::MAX_ORDERS;
+    std::array<ThreadPlacement, Config::MAX_SHARDS> placements{};
+    bool yield_when_idle = false;   // For shared cores; pinned cores spin
+};
+
+/**
+ * Multi-Symbol Sharded Book Engine
+ *
+ * Key features:
+ * - Symbols are partitioned across N book threads by a ShardRouter; each
+ *   shard owns its BookManager outright, so no book state is shared
+ * - The feed thread routes every message with one table load into the
+ *   shard's own SPSCRing; per-symbol message order is preserved
+ * - Id-keyed messages are routed by the symbol their order was added
+ *   under (OrderRoutes), and forwarded with that symbol filled in
+ * - Each book thread is a PinnedThread and builds its books itself, so
+ *   with local_memory placement they land on its NUMA node; its ring is
+ *   NodeLocal on the same node
+ * - Per-symbol message counts are kept so the next session's router can
+ *   be rebuilt from observed load (set_router() while stopped)
+ *
+ * Usage:
+ *   EngineConfig config;
+ *   config.placements[0] = {.cpu = 2, .fifo_priority = 80};
+ *   config.placements[1] = {.cpu = 3, .fifo_priority = 80};
+ *
+ *   ShardedEngine engine(ShardRouter::from_weights(weights, 2), config);
+ *   engine.start();
+ *
+ *   // Feed thread (the engine is also an ItchParser sink):
+ *   engine.publish(msg);
+ *
+ *   engine.stop();                               // Drains, then joins
+ *   auto next = ShardRouter::from_weights(engine.observed_weights(), 2);
+ */
+class ShardedEngine {
+public:
+    using ShardRing = SPSCRing<Message, Config::MESSAGE_RING_SIZE, SingleWriterRingStats>;
+
+    static constexpr uint32_t IDLE_SPINS_BEFORE_YIELD = 1024;
+
+    ShardedEngine(const ShardRouter& router, const EngineConfig& config = {});
+    ~ShardedEngine();
+
+    // Non-copyable, non-movable (shard threads hold a pointer to it)
+    ShardedEngine(const ShardedEngine&) = delete;
+    ShardedEngine& operator=(const ShardedEngine&) = delete;
+    ShardedEngine(ShardedEngine&&) = delete;
+    ShardedEngine& operator=(ShardedEngine&&) = delete;
+
+    // Session control (control thread). start() returns once every shard
+    // has built its books; stop() processes what is queued, then joins.
+    bool start();
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+    bool set_router(const ShardRouter& router) noexcept;
+    const ShardRouter& router() const noexcept { return router_; }
+
+    // Feed interface (single producer thread)
+    bool try_publish(const Message& msg) noexcept;
+    void publish(const Message& msg) noexcept;
+
+    // ItchParser sink interface (books for every symbol exist up front)
+    void on_message(const Message& msg) noexcept { publish(msg); }
+
+    // Queries: book state only after stop() (or from the shard's thread)
+    size_t shard_count() const noexcept { return router_.shard_count(); }
+    const BookManager* shard_books(size_t shard) const noexcept { return shards_[shard]->books.get(); }
+    const OrderBook* book(SymbolId symbol) const noexcept;
+    std::array<uint64_t, Config::MAX_SYMBOLS> observed_weights() const noexcept;
+    PlacementStatus placement(size_t shard) const noexcept { return shards_[shard]->thread.status(); }
+
+    // Performance monitoring
+    uint64_t processed(size_t shard) const noexcept {
+        return shards_[shard]->processed.load(std::memory_order_relaxed);
+    }
+    uint64_t dropped(size_t shard) const noexcept { return shards_[shard]->ring->failed_pushes(); }
+    size_t backlog(size_t shard) const noexcept { return shards_[shard]->ring->size(); }
+    uint64_t unroutable() const noexcept { return unroutable_; }
+    size_t tracked_orders() const noexcept { return routes_ ? routes_->size() : 0; }
+
+private:
+    struct Shard {
+        NodeLocal<ShardRing> ring;
+        std::unique_ptr<BookManager> books;
+        std::array<uint64_t, Config::MAX_SYMBOLS> symbol_messages{};
+        std::atomic<uint64_t> processed{0};
+        std::atomic<bool> ready{false};
+        PinnedThread thread;
+    };
+
+    ShardRouter router_;
+    EngineConfig config_;
+    std::array<std::unique_ptr<Shard>, Config::MAX_SHARDS> shards_;
+    std::atomic<bool> running_{false};
+    uint64_t unroutable_ = 0;
+    std::unique_ptr<OrderRoutes> routes_;   // Feed thread only
+
+    void run_shard(size_t index) noexcept;
+
+    // Fills in the owning symbol of id-keyed messages before routing
+    ShardRing* route(Message& msg) noexcept {
+        if (is_order_keyed(msg.type)) {
+            const SymbolId owner = routes_->owner(msg.order_id);
+            if (owner != OrderRoutes::NO_OWNER) {
+                msg.symbol = owner;
+            }
+        }
+        if (UNLIKELY(msg.symbol >= Config::MAX_SYMBOLS)) {
+            ++unroutable_;
+            return nullptr;
+        }
+        return shards_[router_.shard_of(msg.symbol)]->ring.get();
+    }
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+inline SymbolId OrderRoutes::owner(OrderId id) const noexcept {
+    const OrderHandle handle = index_.find(id);
+    return handle != index_.INVALID_HANDLE ? pool_.cold(handle).symbol : NO_OWNER;
+}
+
+inline void OrderRoutes::record(const Message& msg) noexcept {
+    if (msg.type == MessageType::ADD_ORDER) {
+        if (msg.quantity == 0) {
+            return;  // The book rejects it
+        }
+        const OrderHandle handle = pool_.allocate();
+        if (UNLIKELY(handle == INVALID_ORDER_HANDLE)) {
+            return;  // Counted; its messages keep their own symbol
+        }
+        pool_.cold(handle).symbol = msg.symbol;
+        pool_.hot(handle).quantity = msg.quantity;
+        if (UNLIKELY(!index_.insert(msg.order_id, handle))) {
+            pool_.release(handle);  // Duplicate id: the first order stays
+        }
+        return;
+    }
+    if (!is_order_keyed(msg.type)) {
+        return;
+    }
+
+    const OrderHandle handle = index_.find(msg.order_id);
+    if (handle == index_.INVALID_HANDLE) {
+        return;
+    }
+    switch (msg.type) {
+        case MessageType::CANCEL_ORDER:
+            if (msg.quantity == 0) {
+                retire(msg.order_id, handle);
+            } else {
+                reduce(msg.order_id, handle, msg.quantity);
+            }
+            break;
+        case MessageType::EXECUTE_ORDER:
+            reduce(msg.order_id, handle, msg.quantity);
+            break;
+        case MessageType::MODIFY_ORDER:
+            if (msg.quantity == 0) {
+                retire(msg.order_id, handle);
+                break;
+            }
+            if (msg.new_order_id != 0 && msg.new_order_id != msg.order_id) {
+                index_.erase(msg.order_id);
+                if (UNLIKELY(!index_.insert(msg.new_order_id, handle))) {
+                    pool_.release(handle);
+                    break;
+                }
+            }
+            pool_.hot(handle).quantity = msg.quantity;
+            break;
+        default:
+            break;
+    }
+}
+
+inline void OrderRoutes::retire(OrderId id, OrderHandle handle) noexcept {
+    index_.erase(id);
+    pool_.release(handle);
+}
+
+inline void OrderRoutes::reduce(OrderId id, OrderHandle handle, Quantity quantity) noexcept {
+    Quantity& open = pool_.hot(handle).quantity;
+    if (quantity >= open) {
+        retire(id, handle);
+    } else {
+        open -= quantity;
+    }
+}
+
+inline bool ShardedEngine::try_publish(const Message& msg) noexcept {
+    Message routed = msg;
+    ShardRing* ring = route(routed);
+    if (ring == nullptr || !ring->try_emplace(routed)) {
+        return false;
+    }
+    routes_->record(routed);
+    return true;
+}
+
+inline void ShardedEngine::publish(const Message& msg) noexcept {
+    Message routed = msg;
+    if (ShardRing* ring = route(routed)) {
+        ring->push<PauseBackoffWait>(routed);
+        routes_->record(routed);
+    }
+}
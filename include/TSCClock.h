@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Types.h"
+#include "TSCTimer.h"
+#include <atomic>
+
+/**
+ * TSC to UTC Wall-Clock Mapping
+ *
+ * Message timestamps are taken with rdtscp on the hot path and compared
+ * against the feed's exchange timestamps, which are wall-clock
+ * nanoseconds. TSCClock maps one onto the other.
+ *
+ * Key features:
+ * - Conversion is a subtract, a 64x64->128 multiply and a shift (fixed
+ *   point, SHIFT fractional bits): no floating-point divide per message
+ * - anchor() pairs a TSC reading with CLOCK_REALTIME (tightest of several
+ *   rdtscp brackets) and, once anchors are far enough apart, re-derives
+ *   the slope so the mapping follows NTP/PTP discipline of the clock
+ * - Slopes more than MAX_DRIFT_PPM from the nominal TSC rate are taken to
+ *   be clock steps and rejected; the nominal rate is kept instead
+ * - A timer whose rate is only an estimate (CPUID base MHz) gives a
+ *   provisional nominal rate: the first measured slope within
+ *   MAX_ESTIMATE_ERROR_PPM of it replaces it as the reference
+ * - Single anchoring thread, any number of converting threads: the anchor
+ *   is published through a seqlock, readers never write shared memory
+ *
+ * Usage:
+ *   TSCClock& clock = TSCClock::instance();
+ *
+ *   // Housekeeping thread, every ANCHOR_INTERVAL_MS or so:
+ *   clock.anchor();
+ *
+ *   // Hot path:
+ *   msg.timestamp = timer.now();                        // raw TSC
+ *   Timestamp utc = clock.utc_ns(msg.timestamp);        // later, or at once
+ */
+class TSCClock {
+public:
+    static constexpr unsigned SHIFT = 32;
+    static constexpr uint64_t ANCHOR_INTERVAL_MS = 1000;
+    static constexpr uint64_t MIN_SLOPE_INTERVAL_NS = 100'000'000;   // 100 ms
+    static constexpr uint64_t MAX_DRIFT_PPM = 500;
+    static constexpr uint64_t MAX_ESTIMATE_ERROR_PPM = 10'000;     // Nominal MHz vs real rate
+
+    explicit TSCClock(const TSCTimer& timer = TSCTimer::instance());
+
+    // Process-wide clock built on TSCTimer::instance()
+    static TSCClock& instance();
+
+    // Non-copyable (seqlock state)
+    TSCClock(const TSCClock&) = delete;
+    TSCClock& operator=(const TSCClock&) = delete;
+
+    // Hot path (any thread)
+    Timestamp utc_ns(uint64_t tsc) const noexcept;
+    Timestamp now_utc_ns() const noexcept { return utc_ns(read_tsc()); }
+    uint64_t cycles_to_ns(uint64_t cycles) const noexcept;
+
+    // Re-anchor against CLOCK_REALTIME (single anchoring thread)
+    void anchor() noexcept;
+
+    // Monitoring
+    uint64_t mult() const noexcept { return mult_.load(std::memory_order_relaxed); }
+    uint64_t nominal_mult() const noexcept { return nominal_mult_.load(std::memory_order_relaxed); }
+    bool nominal_is_provisional() const noexcept { return provisional_.load(std::memory_order_relaxed); }
+    int64_t last_correction_ns() const noexcept { return last_correction_ns_.load(std::memory_order_relaxed); }
+    uint64_t anchor_count() const noexcept { return anchor_count_.load(std::memory_order_relaxed); }
+    uint64_t rejected_slopes() const noexcept { return rejected_slopes_.load(std::memory_order_relaxed); }
+
+    static uint64_t scale(uint64_t cycles, uint64_t mult) noexcept {
+        return static_cast<uint64_t>((static_cast<uint128>(cycles) * mult) >> SHIFT);
+    }
+
+private:
+    // Seqlock-published anchor: odd sequence while the writer is mid-update
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<uint64_t> base_tsc_{0};
+    std::atomic<uint64_t> base_ns_{0};
+    std::atomic<uint64_t> mult_{0};
+
+    // Anchoring thread only (monitoring reads are relaxed)
+    std::atomic<uint64_t> nominal_mult_;
+    std::atomic<bool> provisional_;     // nominal_mult_ came from an estimated rate
+    std::atomic<int64_t> last_correction_ns_{0};
+    std::atomic<uint64_t> anchor_count_{0};
+    std::atomic<uint64_t> rejected_slopes_{0};
+    uint64_t slope_tsc_ = 0;       // Start of the current slope interval
+    uint64_t slope_ns_ = 0;
+
+    static uint64_t read_tsc() noexcept {
+        uint32_t aux;
+        return rdtscp(&aux);
+    }
+
+    void load_anchor(uint64_t& base_tsc, uint64_t& base_ns, uint64_t& mult) const noexcept;
+    void publish_anchor(uint64_t base_tsc, uint64_t base_ns, uint64_t mult) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+inline void TSCClock::load_anchor(uint64_t& base_tsc, uint64_t& base_ns,
+                                  uint64_t& mult) const noexcept {
+    uint32_t seq;
+    do {
+        seq = sequence_.load(std::memory_order_acquire);
+        base_tsc = base_tsc_.load(std::memory_order_relaxed);
+        base_ns = base_ns_.load(std::memory_order_relaxed);
+        mult = mult_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while (UNLIKELY((seq & 1) != 0 || seq != sequence_.load(std::memory_order_relaxed)));
+}
+
+inline Timestamp TSCClock::utc_ns(uint64_t tsc) const noexcept {
+    uint64_t base_tsc, base_ns, mult;
+    load_anchor(base_tsc, base_ns, mult);
+
+    // Stamps taken just before a re-anchor land behind base_tsc
+    if (LIKELY(tsc >= base_tsc)) {
+        return base_ns + scale(tsc - base_tsc, mult);
+    }
+    return base_ns - scale(base_tsc - tsc, mult);
+}
+
+inline uint64_t TSCClock::cycles_to_ns(uint64_t cycles) const noexcept {
+    return scale(cycles, mult_.load(std::memory_order_relaxed));
+}
@@ -15,9 +15,59 @@
     }
 #endif
 
+/**
+ * Where a TSCTimer's frequency came from, fastest first
+ */
+enum class TSCFrequencySource : uint8_t {
+    EXPLICIT,       // Passed to the constructor
+    ENVIRONMENT,    // HFT_TSC_FREQ_GHZ
+    CACHE_FILE,     // Persisted by an earlier calibration on this boot
+    CPUID,          // Leaf 0x15 crystal ratio: exact
+    CPUID_ESTIMATE, // Leaf 0x16 base MHz: nominal, may be off by a few MHz
+    CALIBRATED      // Measured against the monotonic clock
+};
+
+/**
+ * TSC-Based Cycle Timer
+ *
+ * Key features:
+ * - now() is a single rdtscp; conversion to ns is one division
+ * - Startup takes microseconds, not the ~330 ms of a sleep calibration:
+ *   the frequency is resolved from, in order, the HFT_TSC_FREQ_GHZ
+ *   environment variable, the calibration cache file, CPUID leaf
+ *   0x15/0x16, and only then a measurement (whose result is cached)
+ * - The leaf 0x16 base frequency is only nominal: a timer using it
+ *   reports CPUID_ESTIMATE and frequency_is_estimate()
+ * - The cache file is keyed by the kernel boot id, so a restart after a
+ *   crash reuses it but a reboot or a different host recalibrates.
+ *   It lives in $XDG_RUNTIME_DIR (else /tmp, suffixed with the uid) and
+ *   is only trusted when it is a regular file, not a symlink, owned by
+ *   this user and writable by no one else. HFT_TSC_CACHE_FILE overrides
+ *   the path; an empty value disables it.
+ * - instance() shares one resolved timer across the process
+ *
+ * Usage:
+ *   const TSCTimer& timer = TSCTimer::instance();
+ *   uint64_t start = timer.now();
+ *   ...
+ *   double ns = timer.cycles_to_ns(timer.now() - start);
+ */
 class TSCTimer {
 public:
+    static constexpr const char* FREQ_ENV_VAR = "HFT_TSC_FREQ_GHZ";
+    static constexpr const char* CACHE_ENV_VAR = "HFT_TSC_CACHE_FILE";
+    static constexpr const char* CACHE_FILE_NAME = "hft_tsc_frequency";
+
+    // Plausible TSC range; anything outside is treated as unavailable
+    static constexpr double MIN_FREQ_GHZ = 0.1;
+    static constexpr double MAX_FREQ_GHZ = 10.0;
+
     TSCTimer();
+    // A known rate; source says where the caller got it (e.g. CPUID_ESTIMATE)
+    explicit TSCTimer(double freq_ghz, TSCFrequencySource source = TSCFrequencySource::EXPLICIT) noexcept;
+
+    // Process-wide timer, resolved once on first use
+    static const TSCTimer& instance();
     
     uint64_t now() const noexcept {
         uint32_t aux;
@@ -31,14 +81,38 @@ public:
     double get_frequency_ghz() const noexcept {
         return tsc_freq_ghz_;
     }
+
+    TSCFrequencySource frequency_source() const noexcept {
+        return source_;
+    }
+
+    bool frequency_is_estimate() const noexcept {
+        return source_ == TSCFrequencySource::CPUID_ESTIMATE;
+    }
     
     static bool is_tsc_available();
+    static bool is_invariant_tsc();
+
+    // Measure against the monotonic clock and persist to the cache file
     void calibrate();
+
+    // Individual frequency sources; each returns 0.0 when unavailable.
+    // frequency_from_cpuid sets *estimate when only leaf 0x16 answered.
+    static double frequency_from_environment() noexcept;
+    static double frequency_from_cpuid(bool* estimate = nullptr) noexcept;
+    static double load_cached_frequency(const char* path);
+    static bool store_cached_frequency(const char* path, double freq_ghz);
+    static const char* cache_file_path() noexcept;
     
 private:
     double tsc_freq_ghz_;
+    TSCFrequencySource source_;
     uint64_t measure_tsc_frequency();
     void warmup_tsc();
+
+    static bool is_plausible(double freq_ghz) noexcept {
+        return freq_ghz >= MIN_FREQ_GHZ && freq_ghz <= MAX_FREQ_GHZ;
+    }
 };
 
 class ScopedTimer {
@@ -52,16 +126,15 @@ public:
 private:
     const char* name_;
     uint64_t start_cycles_;
-    static TSCTimer timer_;
 };
 
 inline ScopedTimer::ScopedTimer(const char* name) 
-    : name_(name), start_cycles_(timer_.now()) {}
+    : name_(name), start_cycles_(TSCTimer::instance().now()) {}
 
 inline uint64_t ScopedTimer::elapsed_cycles() const noexcept {
-    return timer_.now() - start_cycles_;
+    return TSCTimer::instance().now() - start_cycles_;
 }
 
 inline double ScopedTimer::elapsed_ns() const noexcept {
-    return timer_.cycles_to_ns(elapsed_cycles());
+    return TSCTimer::instance().cycles_to_ns(elapsed_cycles());
 }
\ No newline at end of file
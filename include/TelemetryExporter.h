@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Types.h"
+#include "HealthCounters.h"
+#include "LatencyHistogram.h"
+#include "TSCTimer.h"
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * Ring health as read by the exporter thread
+ */
+struct RingHealth {
+    uint64_t occupancy;
+    uint64_t capacity;
+    uint64_t high_watermark;
+    uint64_t pushes;
+    uint64_t failed_pushes;
+};
+
+/**
+ * Out-of-Band Telemetry Exporter
+ *
+ * Key features:
+ * - Reads only what hot-path threads already publish as relaxed
+ *   single-writer values: ring indices and stats policies, BookHealth
+ *   blocks, LatencyHistograms. The fast path does no telemetry work and
+ *   never waits for a scrape
+ * - Renders the Prometheus text exposition format, each metric family
+ *   contiguous across all sources
+ * - Serves it over HTTP from its own thread (loopback by default), one
+ *   scrape at a time, so a slow scraper only delays the next scrape
+ *
+ * Usage:
+ *   TelemetryExporter telemetry(timer);
+ *   telemetry.add_ring("feed", feed_ring);       // SingleWriterRingStats for high-watermark
+ *   telemetry.add_books("equities", books);
+ *   telemetry.add_histogram("book_process", Profiler::instance().histogram(ProfileZone::BOOK_PROCESS));
+ *   telemetry.start(9464);                      // curl localhost:9464/metrics
+ */
+class TelemetryExporter {
+public:
+    static constexpr size_t MAX_SOURCES = 32;      // Per kind
+
+    explicit TelemetryExporter(const TSCTimer& timer) noexcept : timer_(timer) {}
+    ~TelemetryExporter();
+
+    // Non-copyable, non-movable (the serving thread holds this)
+    TelemetryExporter(const TelemetryExporter&) = delete;
+    TelemetryExporter& operator=(const TelemetryExporter&) = delete;
+
+    // Setup (before start()): sources must outlive the exporter; false
+    // once MAX_SOURCES of a kind are registered
+    template<typename Ring>
+    bool add_ring(const char* name, const Ring& ring) noexcept;
+    template<typename Manager>
+    bool add_books(const char* name, const Manager& books) noexcept;
+    bool add_histogram(const char* name, const LatencyHistogram& histogram) noexcept;
+
+    // Prometheus text format of every source (any thread)
+    void render(std::string& out) const;
+
+    // Serving thread on address:port; port 0 picks a free one (see port())
+    bool start(uint16_t port, const char* address = "127.0.0.1");
+    void stop() noexcept;
+    uint16_t port() const noexcept { return port_; }
+    uint64_t scrapes() const noexcept { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    struct RingSource {
+        const char* name;
+        const void* ring;
+        RingHealth (*sample)(const void* ring) noexcept;
+    };
+    struct BookSource {
+        const char* name;
+        const BookHealth* health;
+        uint64_t pool_capacity;
+    };
+    struct HistogramSource {
+        const char* name;
+        const LatencyHistogram* histogram;
+    };
+
+    const TSCTimer& timer_;
+    std::array<RingSource, MAX_SOURCES> rings_{};
+    std::array<BookSource, MAX_SOURCES> books_{};
+    std::array<HistogramSource, MAX_SOURCES> histograms_{};
+    size_t ring_count_ = 0;
+    size_t book_count_ = 0;
+    size_t histogram_count_ = 0;
+
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> scrapes_{0};
+
+    void serve() noexcept;
+    void answer(int fd) noexcept;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+template<typename Ring>
+bool TelemetryExporter::add_ring(const char* name, const Ring& ring) noexcept {
+    if (ring_count_ == MAX_SOURCES) {
+        return false;
+    }
+    rings_[ring_count_++] = RingSource{name, &ring, [](const void* object) noexcept {
+        const Ring& r = *static_cast<const Ring*>(object);
+        uint64_t high_watermark = 0;
+        if constexpr (requires { r.high_watermark(); }) {
+            high_watermark = r.high_watermark();
+        }
+        return RingHealth{r.size(), r.capacity(), high_watermark, r.total_pushes(), r.failed_pushes()};
+    }};
+    return true;
+}
+
+template<typename Manager>
+bool TelemetryExporter::add_books(const char* name, const Manager& books) noexcept {
+    if (book_count_ == MAX_SOURCES) {
+        return false;
+    }
+    books_[book_count_++] = BookSource{name, &books.health(), books.pool().capacity()};
+    return true;
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Types.h"
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+/**
+ * Where and how an engine thread runs
+ */
+struct ThreadPlacement {
+    int cpu = -1;               // Core to pin to; -1 leaves the thread floating
+    int fifo_priority = 0;      // SCHED_FIFO priority 1..99; 0 keeps SCHED_OTHER
+    bool local_memory = true;   // Prefer the pinned core's NUMA node for allocations
+};
+
+/**
+ * Outcome of applying a ThreadPlacement. Each step is best effort: a
+ * container without CAP_SYS_NICE still runs, just without SCHED_FIFO.
+ */
+struct PlacementStatus {
+    bool pinned = false;
+    bool realtime = false;
+    bool memory_policy = false;
+    int node = -1;
+};
+
+/**
+ * Thread Placement and Memory Residency (Linux)
+ *
+ * Key features:
+ * - Pin the calling thread to one core and optionally switch it to
+ *   SCHED_FIFO, so the scheduler neither migrates nor time-slices it
+ * - NUMA placement through the raw mbind/set_mempolicy syscalls (no
+ *   libnuma dependency); on single-node hosts these are harmless no-ops
+ * - Prefault and mlock helpers, so the first touch of a ring slot or
+ *   order slot on the hot path never takes a page fault
+ *
+ * Usage:
+ *   // At startup, before any market data:
+ *   ThreadRuntime::lock_all();
+ *
+ *   PinnedThread book("book", {.cpu = 3, .fifo_priority = 80}, [&] {
+ *       BookManager books;           // Pool and books land on core 3's node
+ *       ...
+ *   });
+ *
+ *   auto ring = NodeLocal<SPSCRing<Message, 65536>>::create(
+ *       ThreadRuntime::node_of_cpu(3));   // Consumer (book) side's node
+ */
+class ThreadRuntime {
+public:
+    // Calling-thread placement
+    static PlacementStatus apply(const ThreadPlacement& placement) noexcept;
+    static bool pin_current_thread(int cpu) noexcept;
+    static bool set_fifo_priority(int priority) noexcept;
+    static bool prefer_node(int node) noexcept;
+    static bool reset_memory_policy() noexcept;
+    static int current_cpu() noexcept;
+    static void set_thread_name(const char* name) noexcept;
+
+    // Topology (from /sys; single-node fallback)
+    static int node_of_cpu(int cpu) noexcept;
+    static int node_count() noexcept;
+
+    // Memory residency. Ranges are widened to whole pages.
+    static size_t page_size() noexcept;
+    static bool bind_to_node(void* addr, size_t bytes, int node) noexcept;
+    static void prefault(void* addr, size_t bytes) noexcept;
+    static bool lock(void* addr, size_t bytes) noexcept;
+    static bool lock_all() noexcept;
+};
+
+/**
+ * std::thread that applies a ThreadPlacement before running its body.
+ * Joins on destruction. name must outlive the thread's startup (a string
+ * literal in practice).
+ */
+class PinnedThread {
+public:
+    PinnedThread() = default;
+
+    template<typename Fn>
+    PinnedThread(const char* name, const ThreadPlacement& placement, Fn&& fn)
+        : state_(std::make_unique<State>()) {
+        State* state = state_.get();
+        thread_ = std::thread([state, name, placement, body = std::forward<Fn>(fn)]() mutable {
+            ThreadRuntime::set_thread_name(name);
+            state->status = ThreadRuntime::apply(placement);
+            state->ready.store(true, std::memory_order_release);
+            body();
+        });
+    }
+
+    ~PinnedThread() { join(); }
+
+    PinnedThread(PinnedThread&&) noexcept = default;
+    PinnedThread& operator=(PinnedThread&& other) noexcept {
+        if (this != &other) {
+            join();
+            state_ = std::move(other.state_);
+            thread_ = std::move(other.thread_);
+        }
+        return *this;
+    }
+
+    void join() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    // Blocks until the thread has applied its placement
+    PlacementStatus status() const noexcept {
+        if (!state_) {
+            return {};
+        }
+        while (!state_->ready.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        return state_->status;
+    }
+
+private:
+    struct State {
+        std::atomic<bool> ready{false};
+        PlacementStatus status;
+    };
+
+    std::unique_ptr<State> state_;
+    std::thread thread_;
+};
+
+/**
+ * One T in its own anonymous mapping bound to a NUMA node, prefaulted and
+ * mlocked before T is constructed. For objects whose storage is inline,
+ * such as the rings; objects that allocate internally (OrderPool,
+ * BookManager) should instead be built on a thread placed with
+ * local_memory, or bound afterwards with ThreadRuntime::bind_to_node.
+ */
+template<typename T>
+class NodeLocal {
+public:
+    NodeLocal() = default;
+    ~NodeLocal() { reset(); }
+
+    NodeLocal(NodeLocal&& other) noexcept
+        : object_(std::exchange(other.object_, nullptr)), bytes_(other.bytes_) {}
+    NodeLocal& operator=(NodeLocal&& other) noexcept {
+        if (this != &other) {
+            reset();
+            object_ = std::exchange(other.object_, nullptr);
+            bytes_ = other.bytes_;
+        }
+        return *this;
+    }
+
+    // Returns an empty NodeLocal if the mapping cannot be created
+    template<typename... Args>
+    static NodeLocal create(int node, Args&&... args);
+
+    T* get() const noexcept { return object_; }
+    T* operator->() const noexcept { return object_; }
+    T& operator*() const noexcept { return *object_; }
+    explicit operator bool() const noexcept { return object_ != nullptr; }
+
+    void reset() noexcept;
+
+private:
+    T* object_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+// ============================================================================
+// IMPLEMENTATION
+// ============================================================================
+
+namespace detail {
+    void* map_node_memory(size_t bytes, int node) noexcept;
+    void unmap_node_memory(void* addr, size_t bytes) noexcept;
+}
+
+template<typename T>
+template<typename... Args>
+NodeLocal<T> NodeLocal<T>::create(int node, Args&&... args) {
+    static_assert(alignof(T) <= 4096, "Mapping is only page aligned");
+
+    NodeLocal result;
+    const size_t page = ThreadRuntime::page_size();
+    const size_t bytes = (sizeof(T) + page - 1) / page * page;
+
+    void* memory = detail::map_node_memory(bytes, node);
+    if (memory == nullptr) {
+        return result;
+    }
+    result.object_ = new (memory) T(std::forward<Args>(args)...);
+    result.bytes_ = bytes;
+    return result;
+}
+
+template<typename T>
+void NodeLocal<T>::reset() noexcept {
+    if (object_ != nullptr) {
+        object_->~T();
+        detail::unmap_node_memory(object_, bytes_);
+        object_ = nullptr;
+    }
+}
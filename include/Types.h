@@ -12,9 +12,13 @@
 using Price = uint32_t;        // Price in ticks (e.g., $100.25 = 10025)
 using Quantity = uint32_t;     // Share quantity
 using OrderId = uint64_t;      // Unique order identifier
-using Timestamp = uint64_t;    // Nanoseconds since epoch or TSC cycles
+using Timestamp = uint64_t;    // Nanoseconds since epoch or TSC cycles (TSCClock maps one to the other)
 using SymbolId = uint16_t;     // Numeric symbol identifier for performance
 
+// 128-bit intermediate for 64x64 fixed-point products (a GCC/Clang
+// extension; __extension__ keeps -Wpedantic quiet)
+__extension__ using uint128 = unsigned __int128;
+
 // ============================================================================
 // ENUMERATIONS  
 // ============================================================================
@@ -41,18 +45,22 @@ namespace Config {
     // Ring buffer sizes (must be power of 2)
     constexpr size_t MESSAGE_RING_SIZE = 65536;
     constexpr size_t OUTPUT_RING_SIZE = 32768;
+    constexpr size_t BUS_RING_SIZE = 65536;         // Shared-memory market data bus
     
     // Memory pool sizes
     constexpr size_t MAX_ORDERS = 1000000;
     constexpr size_t MAX_SYMBOLS = 1000;
+    constexpr size_t MAX_SHARDS = 16;
     
     // Price level array size
     constexpr size_t MAX_PRICE_LEVELS = 65536;
     constexpr Price MIN_PRICE = 1;
     constexpr Price MAX_PRICE = MAX_PRICE_LEVELS;
     
-    // Performance monitoring
-    constexpr size_t LATENCY_SAMPLE_SIZE = 1000000;
+    // Per-side level storage: dense window around the touch (power of 2)
+    // plus an overflow table for far levels (power of 2, <= 50% load)
+    constexpr size_t LEVEL_WINDOW_SIZE = 1024;
+    constexpr size_t LEVEL_OVERFLOW_SLOTS = 2048;
 }
 
 // ============================================================================
@@ -0,0 +1,112 @@
+#include "Capture.h"
+#include "FileIO.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+// CaptureRecorder
+// ============================================================================
+
+CaptureRecorder::CaptureRecorder() : buffer_(std::make_unique<Message[]>(BUFFER_RECORDS)) {}
+
+CaptureRecorder::~CaptureRecorder() {
+    close();
+}
+
+bool CaptureRecorder::open(const char* path, bool truncate) {
+    close();
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    failed_ = false;
+    records_ = 0;
+
+    struct stat st;
+    CaptureHeader existing{};
+    const bool appendable = !truncate && fstat(fd_, &st) == 0 &&
+                            static_cast<size_t>(st.st_size) >= sizeof(CaptureHeader) &&
+                            ::pread(fd_, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing)) &&
+                            file_header_matches(existing, sizeof(Message));
+
+    if (appendable) {
+        // Drop a torn final record so appends stay record aligned
+        records_ = (static_cast<size_t>(st.st_size) - sizeof(CaptureHeader)) / sizeof(Message);
+        const off_t end = static_cast<off_t>(sizeof(CaptureHeader) + records_ * sizeof(Message));
+        if (ftruncate(fd_, end) == 0 && lseek(fd_, end, SEEK_SET) == end) {
+            return true;
+        }
+    } else if (ftruncate(fd_, 0) == 0) {
+        CaptureHeader header{};
+        init_file_header(header, sizeof(Message));
+        if (write_all(fd_, &header, sizeof(header))) {
+            return true;
+        }
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+    return false;
+}
+
+bool CaptureRecorder::flush() noexcept {
+    if (buffered_ == 0) {
+        return !failed_;
+    }
+    if (fd_ < 0 || failed_ || !write_all(fd_, buffer_.get(), buffered_ * sizeof(Message))) {
+        failed_ = true;   // Records are discarded rather than retried
+        buffered_ = 0;
+        return false;
+    }
+    records_ += buffered_;
+    buffered_ = 0;
+    return true;
+}
+
+void CaptureRecorder::close() noexcept {
+    if (fd_ < 0) {
+        return;
+    }
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+// ============================================================================
+// CaptureReplayer
+// ============================================================================
+
+CaptureReplayer::~CaptureReplayer() {
+    close();
+}
+
+bool CaptureReplayer::open(const char* path) {
+    close();
+    size_t bytes = 0;
+    void* memory = map_file(path, sizeof(CaptureHeader), bytes);
+    if (memory == nullptr) {
+        return false;
+    }
+    if (!file_header_matches(*static_cast<const CaptureHeader*>(memory), sizeof(Message))) {
+        munmap(memory, bytes);
+        return false;
+    }
+
+    mapping_ = memory;
+    mapping_bytes_ = bytes;
+    records_ = reinterpret_cast<const Message*>(static_cast<const char*>(memory) + sizeof(CaptureHeader));
+    count_ = (bytes - sizeof(CaptureHeader)) / sizeof(Message);
+    return true;
+}
+
+void CaptureReplayer::close() noexcept {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_bytes_);
+    }
+    mapping_ = nullptr;
+    mapping_bytes_ = 0;
+    records_ = nullptr;
+    count_ = 0;
+}
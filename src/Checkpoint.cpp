@@ -0,0 +1,244 @@
+#include "Checkpoint.h"
+#include "FileIO.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t BUFFER_RECORDS = 1024;
+constexpr size_t PATH_MAX_BYTES = 4096;
+
+bool valid_header(const CheckpointHeader& header) noexcept {
+    return file_header_matches(header, sizeof(CheckpointOrder)) &&
+           header.max_symbols == Config::MAX_SYMBOLS;
+}
+
+// Buffered record writer: one write() per BUFFER_RECORDS orders. Runs in
+// the forked child too, so it allocates nothing.
+class RecordWriter {
+public:
+    explicit RecordWriter(int fd) noexcept : fd_(fd) {}
+
+    void add(const CheckpointOrder& order) noexcept {
+        buffer_[buffered_++] = order;
+        ++written_;
+        if (buffered_ == BUFFER_RECORDS) {
+            flush();
+        }
+    }
+    bool flush() noexcept {
+        ok_ = ok_ && write_all(fd_, buffer_, buffered_ * sizeof(CheckpointOrder));
+        buffered_ = 0;
+        return ok_;
+    }
+    uint64_t written() const noexcept { return written_; }
+
+private:
+    int fd_;
+    CheckpointOrder buffer_[BUFFER_RECORDS];
+    size_t buffered_ = 0;
+    uint64_t written_ = 0;
+    bool ok_ = true;
+};
+
+// Orders of one side, best level first, each level head (oldest) first
+void write_side(RecordWriter& out, const BookManager& books, const OrderBook& book, Side side) noexcept {
+    const auto& levels = side == Side::BUY ? book.bid_levels() : book.ask_levels();
+    if (side == Side::BUY ? !book.has_bid() : !book.has_ask()) {
+        return;
+    }
+
+    const auto& pool = books.pool();
+    for (auto price = static_cast<OrderBook::price_type>(side == Side::BUY ? book.best_bid() : book.best_ask());
+         price != OrderBook::Levels::NO_PRICE;
+         price = side == Side::BUY ? levels.highest_below(price) : levels.lowest_above(price)) {
+        for (auto h = levels.get(price).head; h != OrderBook::INVALID_HANDLE; h = pool.hot(h).next) {
+            const auto& hot = pool.hot(h);
+            const auto& cold = pool.cold(h);
+            out.add(CheckpointOrder{cold.id, hot.price, hot.quantity, cold.symbol, cold.side});
+        }
+    }
+}
+
+}  // namespace
+
+bool write_checkpoint(const BookManager& books, uint64_t last_sequence, const char* path) noexcept {
+    const size_t length = std::strlen(path);
+    char tmp_path[PATH_MAX_BYTES];
+    if (length + sizeof(".tmp") > sizeof(tmp_path)) {
+        return false;
+    }
+    std::memcpy(tmp_path, path, length);
+    std::memcpy(tmp_path + length, ".tmp", sizeof(".tmp"));
+
+    const int fd = ::open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Header and symbol bitmap first, with the order count patched in
+    // once the records are out
+    CheckpointHeader header{};
+    init_file_header(header, sizeof(CheckpointOrder));
+    header.last_sequence = last_sequence;
+    header.max_symbols = Config::MAX_SYMBOLS;
+
+    uint8_t symbols[CHECKPOINT_SYMBOL_BYTES] = {};
+    for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+        if (books.book(static_cast<SymbolId>(s)) != nullptr) {
+            symbols[s / 8] |= static_cast<uint8_t>(1u << (s % 8));
+        }
+    }
+
+    // 24 KB of records on the stack: in the forked child this must not
+    // touch the parent's allocator state
+    RecordWriter out(fd);
+    bool ok = write_all(fd, &header, sizeof(header)) && write_all(fd, symbols, sizeof(symbols));
+    if (ok) {
+        for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+            if (const OrderBook* book = books.book(static_cast<SymbolId>(s))) {
+                write_side(out, books, *book, Side::BUY);
+                write_side(out, books, *book, Side::SELL);
+            }
+        }
+        header.order_count = out.written();
+        ok = out.flush() &&
+             ::pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+             fsync(fd) == 0;
+    }
+
+    ok = ::close(fd) == 0 && ok;
+    if (ok && ::rename(tmp_path, path) == 0) {
+        return true;
+    }
+    ::unlink(tmp_path);
+    return false;
+}
+
+// ============================================================================
+// Checkpointer
+// ============================================================================
+
+Checkpointer::~Checkpointer() {
+    wait();
+}
+
+bool Checkpointer::begin(const BookManager& books, uint64_t last_sequence, const char* path) noexcept {
+    if (poll()) {
+        return false;  // Previous checkpoint still being written
+    }
+
+    const pid_t child = fork();
+    if (child < 0) {
+        ++failed_;
+        return false;
+    }
+    if (child == 0) {
+        // Only this thread exists in the child; _exit skips the parent's
+        // atexit handlers and stdio buffers
+        _exit(write_checkpoint(books, last_sequence, path) ? 0 : 1);
+    }
+
+    child_ = child;
+    pending_sequence_ = last_sequence;
+    return true;
+}
+
+bool Checkpointer::poll() noexcept {
+    if (child_ <= 0) {
+        return false;
+    }
+    int status = 0;
+    const pid_t reaped = waitpid(child_, &status, WNOHANG);
+    if (reaped == 0) {
+        return true;
+    }
+    finish(reaped == child_ ? status : -1);
+    return false;
+}
+
+bool Checkpointer::wait() noexcept {
+    if (child_ <= 0) {
+        return false;
+    }
+    const uint64_t before = completed_;
+    int status = 0;
+    pid_t reaped;
+    do {
+        reaped = waitpid(child_, &status, 0);
+    } while (reaped < 0 && errno == EINTR);
+    finish(reaped == child_ ? status : -1);
+    return completed_ != before;
+}
+
+void Checkpointer::finish(int status) noexcept {
+    if (status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        ++completed_;
+        last_sequence_ = pending_sequence_;
+    } else {
+        ++failed_;
+    }
+    child_ = -1;
+}
+
+// ============================================================================
+// CheckpointLoader
+// ============================================================================
+
+CheckpointLoader::~CheckpointLoader() {
+    close();
+}
+
+bool CheckpointLoader::open(const char* path) {
+    close();
+    constexpr size_t PREFIX = sizeof(CheckpointHeader) + CHECKPOINT_SYMBOL_BYTES;
+    size_t bytes = 0;
+    void* memory = map_file(path, PREFIX, bytes);
+    if (memory == nullptr) {
+        return false;
+    }
+    const auto& header = *static_cast<const CheckpointHeader*>(memory);
+    if (!valid_header(header) || bytes != PREFIX + header.order_count * sizeof(CheckpointOrder)) {
+        munmap(memory, bytes);
+        return false;
+    }
+
+    mapping_ = memory;
+    mapping_bytes_ = bytes;
+    symbols_ = static_cast<const uint8_t*>(memory) + sizeof(CheckpointHeader);
+    orders_ = reinterpret_cast<const CheckpointOrder*>(static_cast<const char*>(memory) + PREFIX);
+    return true;
+}
+
+void CheckpointLoader::close() noexcept {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_bytes_);
+    }
+    mapping_ = nullptr;
+    mapping_bytes_ = 0;
+    symbols_ = nullptr;
+    orders_ = nullptr;
+}
+
+bool CheckpointLoader::has_symbol(SymbolId symbol) const noexcept {
+    return symbol < Config::MAX_SYMBOLS && (symbols_[symbol / 8] & (1u << (symbol % 8))) != 0;
+}
+
+bool CheckpointLoader::restore(BookManager& books) const {
+    for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+        if (has_symbol(static_cast<SymbolId>(s)) && !books.add_symbol(static_cast<SymbolId>(s))) {
+            return false;
+        }
+    }
+
+    bool ok = true;
+    for (const CheckpointOrder& order : orders()) {
+        ok &= books.add_order(order.symbol, order.id, order.side, order.price, order.quantity);
+    }
+    return ok;
+}
@@ -0,0 +1,127 @@
+#include "FeedHandler.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef SO_BUSY_POLL
+    #define SO_BUSY_POLL 46
+#endif
+
+// ============================================================================
+// UdpReceiver
+// ============================================================================
+
+struct UdpReceiver::Batch {
+    mmsghdr headers[BATCH];
+    iovec vectors[BATCH];
+    alignas(CACHE_LINE_SIZE) uint8_t buffers[BATCH][PACKET_BYTES];
+    size_t received = 0;
+};
+
+UdpReceiver::UdpReceiver() = default;
+
+UdpReceiver::~UdpReceiver() {
+    close();
+}
+
+bool UdpReceiver::open(const char* address, uint16_t port, const char* interface_address,
+                       const Options& options) {
+    close();
+
+    in_addr group{};
+    if (inet_pton(AF_INET, address, &group) != 1) {
+        return false;
+    }
+    in_addr local{};
+    local.s_addr = htonl(INADDR_ANY);
+    if (interface_address != nullptr && inet_pton(AF_INET, interface_address, &local) != 1) {
+        return false;
+    }
+
+    fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    const bool multicast = IN_MULTICAST(ntohl(group.s_addr));
+    const int one = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));   // A and B may share a port
+
+    // Best effort: the kernel caps both at its sysctl limits without
+    // CAP_NET_ADMIN, which is not worth failing the feed over
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &options.receive_buffer_bytes,
+               sizeof(options.receive_buffer_bytes));
+    if (options.busy_poll_us > 0) {
+        busy_polling_ = setsockopt(fd_, SOL_SOCKET, SO_BUSY_POLL, &options.busy_poll_us,
+                                   sizeof(options.busy_poll_us)) == 0;
+    }
+
+    // Multicast binds the group address so the socket sees only its line
+    sockaddr_in bind_addr{};
+    bind_addr.sin_family = AF_INET;
+    bind_addr.sin_port = htons(port);
+    bind_addr.sin_addr = multicast || interface_address == nullptr ? group : local;
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&bind_addr), sizeof(bind_addr)) != 0) {
+        close();
+        return false;
+    }
+    if (multicast) {
+        ip_mreq membership{};
+        membership.imr_multiaddr = group;
+        membership.imr_interface = local;
+        if (setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+            close();
+            return false;
+        }
+    }
+
+    sockaddr_in bound{};
+    socklen_t bound_length = sizeof(bound);
+    getsockname(fd_, reinterpret_cast<sockaddr*>(&bound), &bound_length);
+    port_ = ntohs(bound.sin_port);
+
+    batch_ = std::make_unique<Batch>();
+    for (size_t i = 0; i < BATCH; ++i) {
+        batch_->vectors[i] = iovec{batch_->buffers[i], PACKET_BYTES};
+        batch_->headers[i] = mmsghdr{};
+        batch_->headers[i].msg_hdr.msg_iov = &batch_->vectors[i];
+        batch_->headers[i].msg_hdr.msg_iovlen = 1;
+    }
+    return true;
+}
+
+void UdpReceiver::close() noexcept {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+    port_ = 0;
+    busy_polling_ = false;
+}
+
+size_t UdpReceiver::receive() noexcept {
+    if (UNLIKELY(fd_ < 0)) {
+        return 0;
+    }
+    ++calls_;
+    const int n = recvmmsg(fd_, batch_->headers, BATCH, MSG_DONTWAIT, nullptr);
+    if (n <= 0) {
+        batch_->received = 0;
+        return 0;   // EAGAIN: nothing queued
+    }
+
+    batch_->received = static_cast<size_t>(n);
+    datagrams_ += batch_->received;
+    for (size_t i = 0; i < batch_->received; ++i) {
+        if (UNLIKELY(batch_->headers[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+            ++truncated_;
+        }
+    }
+    return batch_->received;
+}
+
+std::span<const uint8_t> UdpReceiver::packet(size_t i) const noexcept {
+    return {batch_->buffers[i], batch_->headers[i].msg_len};
+}
@@ -0,0 +1,52 @@
+#include "FileIO.h"
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool write_all(int fd, const void* data, size_t bytes) noexcept {
+    const char* cursor = static_cast<const char*>(data);
+    while (bytes != 0) {
+        const ssize_t n = ::write(fd, cursor, bytes);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        cursor += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void* map_file(const char* path, size_t min_bytes, size_t& bytes) noexcept {
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < min_bytes) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // The mapping keeps the file referenced
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // Read-ahead hint only; readers are correct without it
+    madvise(memory, size, MADV_SEQUENTIAL);
+    bytes = size;
+    return memory;
+}
+
+uint64_t wall_clock_ns() noexcept {
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
@@ -0,0 +1,77 @@
+#include "FlowGenerator.h"
+#include <algorithm>
+
+namespace {
+
+uint64_t splitmix64(uint64_t& state) noexcept {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}  // namespace
+
+// ============================================================================
+// BatchRng
+// ============================================================================
+
+BatchRng::BatchRng(uint64_t seed) noexcept {
+    // splitmix64 expands the seed so no lane starts from all-zero state
+    uint64_t state = seed;
+    for (size_t l = 0; l < LANES; ++l) {
+        s0_[l] = splitmix64(state);
+        s1_[l] = splitmix64(state);
+        s2_[l] = splitmix64(state);
+        s3_[l] = splitmix64(state);
+    }
+}
+
+// ============================================================================
+// FlowConfig / FlowGenerator
+// ============================================================================
+
+FlowConfig FlowConfig::market_open(size_t symbols, uint64_t seed) {
+    FlowConfig config;
+    config.seed = seed;
+    config.symbols = symbols;
+    constexpr Timestamp MINUTE_NS = 60'000'000'000ULL;
+    const Timestamp minutes[] = {1, 1, 1, 1, 2, 2, 2, 5};
+    const double multipliers[] = {20.0, 10.0, 6.0, 4.0, 3.0, 2.0, 1.5, 1.2};
+    for (size_t i = 0; i < config.phases.size(); ++i) {
+        config.phases[i] = BurstPhase{minutes[i] * MINUTE_NS, multipliers[i]};
+    }
+    config.phase_count = config.phases.size();
+    return config;
+}
+
+FlowGenerator::FlowGenerator(const FlowConfig& config)
+    : config_(config),
+      rng_(config.seed),
+      clock_(config.start_time) {
+    config_.symbols = std::clamp<size_t>(config_.symbols, 1, Config::MAX_SYMBOLS);
+    config_.max_live_orders = std::clamp<size_t>(config_.max_live_orders, 2, Config::MAX_ORDERS);
+    config_.min_live_orders = std::clamp<size_t>(config_.min_live_orders, 1, config_.max_live_orders - 1);
+    config_.depth = std::clamp<uint32_t>(config_.depth, 1, (Config::MAX_PRICE - Config::MIN_PRICE) / 4);
+    config_.mid_step_interval = std::max<uint32_t>(config_.mid_step_interval, 1);
+    config_.max_lots = std::max<uint32_t>(config_.max_lots, 1);
+    config_.lot_size = std::max<Quantity>(config_.lot_size, 1);
+    config_.phase_count = std::min(config_.phase_count, config_.phases.size());
+    if (config_.messages_per_second <= 0) config_.messages_per_second = 1e6;
+    if (config_.add_weight == 0) config_.add_weight = 1;     // Something must add orders
+    total_weight_ = config_.add_weight + config_.cancel_weight + config_.modify_weight +
+                    config_.execute_weight;
+
+    // Mids stay far enough from the price limits that every add is valid
+    min_mid_ = Config::MIN_PRICE + config_.depth;
+    max_mid_ = Config::MAX_PRICE - config_.depth;
+    live_ = std::make_unique<LiveOrder[]>(config_.max_live_orders);
+    mids_ = std::make_unique<Price[]>(config_.symbols);
+    for (size_t s = 0; s < config_.symbols; ++s) {
+        mids_[s] = std::clamp(config_.initial_mid, min_mid_, max_mid_);
+    }
+
+    const double multiplier = config_.phase_count != 0 ? config_.phases[0].rate_multiplier : 1.0;
+    mean_gap_ns_ = 1e9 / (config_.messages_per_second * multiplier);
+    phase_end_ = config_.phase_count != 0 ? clock_ + config_.phases[0].duration_ns : ~Timestamp{0};
+}
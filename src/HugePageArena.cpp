@@ -0,0 +1,97 @@
+#include "HugePageArena.h"
+#include <sys/mman.h>
+
+#ifndef MAP_HUGE_SHIFT
+    #define MAP_HUGE_SHIFT 26
+#endif
+
+const char* page_backing_name(PageBacking backing) noexcept {
+    switch (backing) {
+        case PageBacking::HUGETLB_1GB: return "HUGETLB_1GB";
+        case PageBacking::HUGETLB_2MB: return "HUGETLB_2MB";
+        case PageBacking::TRANSPARENT: return "TRANSPARENT";
+        case PageBacking::NORMAL: return "NORMAL";
+        default: return "NONE";
+    }
+}
+
+HugePageArena::HugePageArena(size_t bytes, size_t page_size) noexcept {
+    if (bytes == 0) {
+        return;
+    }
+
+    // Largest page first; each step is a smaller page or a softer request
+    bool mapped = false;
+    if (page_size >= HUGE_PAGE_1GB) {
+        mapped = map_hugetlb(bytes, HUGE_PAGE_1GB);
+    }
+    if (!mapped) {
+        mapped = map_hugetlb(bytes, HUGE_PAGE_2MB);
+    }
+    if (!mapped) {
+        mapped = map_transparent(bytes);
+    }
+    if (!mapped) {
+        return;
+    }
+
+    // Fault in every page now rather than on the first hot-path access
+    for (size_t offset = 0; offset < capacity_; offset += 4096) {
+        base_[offset] = 0;
+    }
+}
+
+HugePageArena::~HugePageArena() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_bytes_);
+    }
+}
+
+bool HugePageArena::map_hugetlb(size_t bytes, size_t page_size) noexcept {
+    const size_t rounded = (bytes + page_size - 1) & ~(page_size - 1);
+    const int size_flag = __builtin_ctzll(page_size) << MAP_HUGE_SHIFT;
+
+    void* memory = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | size_flag, -1, 0);
+    if (memory == MAP_FAILED) {
+        return false;   // No pool of this size reserved (vm.nr_hugepages)
+    }
+
+    mapping_ = memory;
+    mapping_bytes_ = rounded;
+    base_ = static_cast<char*>(memory);
+    capacity_ = rounded;
+    page_size_ = page_size;
+    backing_ = page_size == HUGE_PAGE_1GB ? PageBacking::HUGETLB_1GB : PageBacking::HUGETLB_2MB;
+    return true;
+}
+
+bool HugePageArena::map_transparent(size_t bytes) noexcept {
+    // Over-map by one huge page so the usable region can start 2 MB aligned;
+    // THP only promotes aligned 2 MB extents
+    const size_t rounded = (bytes + HUGE_PAGE_2MB - 1) & ~(HUGE_PAGE_2MB - 1);
+    const size_t total = rounded + HUGE_PAGE_2MB;
+
+    void* memory = mmap(nullptr, total, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    const uintptr_t start = reinterpret_cast<uintptr_t>(memory);
+    const uintptr_t aligned = (start + HUGE_PAGE_2MB - 1) & ~(HUGE_PAGE_2MB - 1);
+
+    mapping_ = memory;
+    mapping_bytes_ = total;
+    base_ = reinterpret_cast<char*>(aligned);
+    capacity_ = rounded;
+
+    if (madvise(base_, capacity_, MADV_HUGEPAGE) == 0) {
+        page_size_ = HUGE_PAGE_2MB;
+        backing_ = PageBacking::TRANSPARENT;
+    } else {
+        page_size_ = 4096;
+        backing_ = PageBacking::NORMAL;
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    uint64_t merged = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        const uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+        if (n != 0) {
+            bump(buckets_[i], n);
+            merged += n;
+        }
+    }
+
+    // Derive the count from the buckets actually copied so percentiles stay
+    // consistent even while other's owner is still recording
+    bump(count_, merged);
+    bump(sum_, other.sum_.load(std::memory_order_relaxed));
+    min_.store(std::min(min_.load(std::memory_order_relaxed),
+                        other.min_.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    max_.store(std::max(max_.load(std::memory_order_relaxed),
+                        other.max_.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile_cycles(double percentile) const noexcept {
+    uint64_t total = 0;
+    for (const auto& bucket : buckets_) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the requested sample (1-based), clamped into [1, total]
+    const double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * total + 0.5));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // Report the bucket's highest equivalent value, never above max
+            return std::min(bucket_upper_bound(i), max_cycles());
+        }
+    }
+    return max_cycles();
+}
+
+LatencySummary LatencyHistogram::summary(const TSCTimer& timer) const noexcept {
+    LatencySummary s;
+    s.count = count();
+    s.mean_ns = mean_cycles() / timer.get_frequency_ghz();
+    s.p50_ns = timer.cycles_to_ns(percentile_cycles(50.0));
+    s.p99_ns = timer.cycles_to_ns(percentile_cycles(99.0));
+    s.p999_ns = timer.cycles_to_ns(percentile_cycles(99.9));
+    s.p9999_ns = timer.cycles_to_ns(percentile_cycles(99.99));
+    s.max_ns = timer.cycles_to_ns(max_cycles());
+    return s;
+}
+
+void LatencyHistogram::print(const char* name, const TSCTimer& timer, std::ostream& out) const {
+    const LatencySummary s = summary(timer);
+    out << "[LATENCY] " << name << ": n=" << s.count
+        << std::fixed << std::setprecision(1)
+        << " mean=" << s.mean_ns
+        << " p50=" << s.p50_ns
+        << " p99=" << s.p99_ns
+        << " p99.9=" << s.p999_ns
+        << " p99.99=" << s.p9999_ns
+        << " max=" << s.max_ns << " ns\n";
+}
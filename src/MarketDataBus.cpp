@@ -0,0 +1,151 @@
+#include "MarketDataBus.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t SEGMENT_BYTES = sizeof(MarketDataSegment);
+
+bool compatible_header(const BusHeader& header) noexcept {
+    return std::memcmp(header.magic, BusHeader::MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == BusHeader::VERSION &&
+           header.update_size == sizeof(LevelUpdate) &&
+           header.snapshot_size == sizeof(BookSnapshot) &&
+           header.max_symbols == Config::MAX_SYMBOLS &&
+           header.ring_slots == MarketDataSegment::SLOTS;
+}
+
+}  // namespace
+
+// ============================================================================
+// MarketDataBus
+// ============================================================================
+
+MarketDataBus::~MarketDataBus() {
+    close();
+}
+
+bool MarketDataBus::create(const char* name) {
+    close();
+    if (std::strlen(name) >= sizeof(name_)) {
+        return false;
+    }
+
+    // A fresh object rather than truncating the old one: consumers still
+    // mapping the previous session must not take SIGBUS
+    shm_unlink(name);
+    const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(SEGMENT_BYTES)) != 0) {
+        ::close(fd);
+        shm_unlink(name);
+        return false;
+    }
+    void* memory = mmap(nullptr, SEGMENT_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);   // The mapping keeps the object referenced
+    if (memory == MAP_FAILED) {
+        shm_unlink(name);
+        return false;
+    }
+
+    segment_ = new (memory) MarketDataSegment;
+    published_ = 0;
+    std::strcpy(name_, name);
+
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    BusHeader& header = segment_->header;
+    std::memcpy(header.magic, BusHeader::MAGIC, sizeof(header.magic));
+    header.version = BusHeader::VERSION;
+    header.update_size = sizeof(LevelUpdate);
+    header.snapshot_size = sizeof(BookSnapshot);
+    header.max_symbols = Config::MAX_SYMBOLS;
+    header.ring_slots = SLOTS;
+    header.session = static_cast<uint64_t>(now.tv_sec) * 1'000'000'000ULL +
+                     static_cast<uint64_t>(now.tv_nsec);
+    header.producer_pid = static_cast<int32_t>(getpid());
+
+    // Consumers validate the fields above only after seeing LIVE
+    header.state.store(BusHeader::LIVE, std::memory_order_release);
+    return true;
+}
+
+void MarketDataBus::close(bool unlink) noexcept {
+    if (segment_ == nullptr) {
+        return;
+    }
+    segment_->header.state.store(BusHeader::CLOSED, std::memory_order_release);
+    munmap(segment_, SEGMENT_BYTES);
+    if (unlink) {
+        shm_unlink(name_);
+    }
+    segment_ = nullptr;
+    name_[0] = '\0';
+}
+
+// ============================================================================
+// MarketDataBusReader
+// ============================================================================
+
+MarketDataBusReader::~MarketDataBusReader() {
+    detach();
+}
+
+bool MarketDataBusReader::attach(const char* name) {
+    detach();
+    const int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    // The producer sizes the object before it maps it: a short object is
+    // mid-creation (or foreign)
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != SEGMENT_BYTES) {
+        ::close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, SEGMENT_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    const auto* segment = static_cast<const MarketDataSegment*>(memory);
+    if (segment->header.state.load(std::memory_order_acquire) != BusHeader::LIVE ||
+        !compatible_header(segment->header)) {
+        munmap(memory, SEGMENT_BYTES);
+        return false;
+    }
+
+    segment_ = segment;
+    lapped_ = false;
+    overruns_ = 0;
+    resync();
+    return true;
+}
+
+void MarketDataBusReader::detach() noexcept {
+    if (segment_ != nullptr) {
+        munmap(const_cast<MarketDataSegment*>(segment_), SEGMENT_BYTES);
+    }
+    segment_ = nullptr;
+}
+
+bool MarketDataBusReader::producer_alive() const noexcept {
+    const BusHeader& header = segment_->header;
+    if (header.state.load(std::memory_order_acquire) != BusHeader::LIVE) {
+        return false;
+    }
+    // A crashed producer leaves LIVE behind; its pid is then gone
+    return kill(header.producer_pid, 0) == 0 || errno == EPERM;
+}
@@ -0,0 +1,103 @@
+#include "Profiler.h"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    std::mutex registration_mutex;
+}
+
+const char* profile_zone_name(ProfileZone zone) noexcept {
+    switch (zone) {
+        case ProfileZone::BOOK_ADD: return "BOOK_ADD";
+        case ProfileZone::BOOK_CANCEL: return "BOOK_CANCEL";
+        case ProfileZone::BOOK_EXECUTE: return "BOOK_EXECUTE";
+        case ProfileZone::BOOK_MODIFY: return "BOOK_MODIFY";
+        case ProfileZone::BOOK_PROCESS: return "BOOK_PROCESS";
+        case ProfileZone::FEED_PARSE: return "FEED_PARSE";
+        default: return "UNKNOWN";
+    }
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::~Profiler() {
+    stop();
+}
+
+bool Profiler::register_thread() {
+    if (thread_ring_ != nullptr) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(registration_mutex);
+    const size_t index = ring_count_.load(std::memory_order_relaxed);
+    if (index >= MAX_THREADS) {
+        return false;
+    }
+
+    // Publish the ring before the count so the drain thread never sees
+    // a half-initialized slot
+    rings_[index] = std::make_unique<ZoneRing>();
+    thread_ring_ = rings_[index].get();
+    ring_count_.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+void Profiler::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    set_enabled(true);
+    drain_thread_ = std::thread([this] {
+        while (running_.load(std::memory_order_relaxed)) {
+            if (drain() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+}
+
+void Profiler::stop() {
+    set_enabled(false);
+    if (!running_.exchange(false)) {
+        return;
+    }
+    drain_thread_.join();
+    drain();  // Pick up samples recorded before the switch flipped
+}
+
+size_t Profiler::drain() noexcept {
+    size_t drained = 0;
+    const size_t count = ring_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        drained += rings_[i]->consume_all([this](ZoneSample& sample) {
+            histograms_[static_cast<size_t>(sample.zone)].record(sample.cycles);
+        });
+    }
+    return drained;
+}
+
+uint64_t Profiler::dropped_samples() const noexcept {
+    uint64_t dropped = 0;
+    const size_t count = ring_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        dropped += rings_[i]->failed_pushes();
+    }
+    return dropped;
+}
+
+void Profiler::report(const TSCTimer& timer, std::ostream& out) const {
+    for (size_t i = 0; i < ZONE_COUNT; ++i) {
+        if (histograms_[i].count() != 0) {
+            histograms_[i].print(profile_zone_name(static_cast<ProfileZone>(i)), timer, out);
+        }
+    }
+    const uint64_t dropped = dropped_samples();
+    if (dropped != 0) {
+        out << "[LATENCY] dropped samples: " << dropped << "\n";
+    }
+}
@@ -0,0 +1,222 @@
+#include "ShardedEngine.h"
+#include <algorithm>
+#include <fstream>
+#include <immintrin.h>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// ShardRouter
+// ============================================================================
+
+ShardRouter::ShardRouter(size_t shard_count) noexcept
+    : shard_count_(std::clamp<size_t>(shard_count, 1, Config::MAX_SHARDS)) {
+    for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+        table_[s] = static_cast<uint8_t>(s % shard_count_);
+    }
+}
+
+ShardRouter ShardRouter::from_weights(std::span<const uint64_t> weights, size_t shard_count) {
+    ShardRouter router(shard_count);
+
+    std::vector<SymbolId> order(Config::MAX_SYMBOLS);
+    std::iota(order.begin(), order.end(), SymbolId{0});
+    auto weight_of = [&](SymbolId s) { return s < weights.size() ? weights[s] : 0; };
+    std::stable_sort(order.begin(), order.end(),
+                     [&](SymbolId a, SymbolId b) { return weight_of(a) > weight_of(b); });
+
+    // Heaviest first onto the lightest shard; unweighted symbols then
+    // spread by count so new listings do not all land on one shard
+    std::array<uint64_t, Config::MAX_SHARDS> load{};
+    std::array<size_t, Config::MAX_SHARDS> count{};
+    for (SymbolId s : order) {
+        size_t target = 0;
+        for (size_t i = 1; i < router.shard_count_; ++i) {
+            if (load[i] < load[target] || (load[i] == load[target] && count[i] < count[target])) {
+                target = i;
+            }
+        }
+        router.assign(s, target);
+        load[target] += weight_of(s);
+        ++count[target];
+    }
+    return router;
+}
+
+bool ShardRouter::load_weights(const char* path, std::span<uint64_t> weights) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::fill(weights.begin(), weights.end(), 0);
+    size_t symbol;
+    uint64_t weight;
+    while (in >> symbol >> weight) {
+        if (symbol < weights.size()) {
+            weights[symbol] = weight;
+        }
+    }
+    return in.eof();
+}
+
+bool ShardRouter::save_weights(const char* path, std::span<const uint64_t> weights) {
+    std::ofstream out(path, std::ios::trunc);
+    for (size_t s = 0; s < weights.size(); ++s) {
+        if (weights[s] != 0) {
+            out << s << ' ' << weights[s] << '\n';
+        }
+    }
+    return static_cast<bool>(out.flush());
+}
+
+void ShardRouter::assign(SymbolId symbol, size_t shard) noexcept {
+    if (symbol < Config::MAX_SYMBOLS && shard < shard_count_) {
+        table_[symbol] = static_cast<uint8_t>(shard);
+    }
+}
+
+size_t ShardRouter::symbols_on(size_t shard) const noexcept {
+    return static_cast<size_t>(std::count(table_.begin(), table_.end(), shard));
+}
+
+// ============================================================================
+// OrderRoutes
+// ============================================================================
+
+OrderRoutes::OrderRoutes(size_t capacity)
+    : pool_(std::min(capacity, Config::MAX_ORDERS)) {}
+
+// ============================================================================
+// ShardedEngine
+// ============================================================================
+
+ShardedEngine::ShardedEngine(const ShardRouter& router, const EngineConfig& config)
+    : router_(router), config_(config) {
+    for (size_t i = 0; i < Config::MAX_SHARDS; ++i) {
+        shards_[i] = std::make_unique<Shard>();
+    }
+}
+
+ShardedEngine::~ShardedEngine() {
+    stop();
+}
+
+bool ShardedEngine::start() {
+    if (running()) {
+        return false;
+    }
+
+    // Rings first, on each consumer's node, so the feed can publish as
+    // soon as start() returns
+    for (size_t i = 0; i < shard_count(); ++i) {
+        Shard& shard = *shards_[i];
+        const int cpu = config_.placements[i].cpu;
+        const int node = ThreadRuntime::node_of_cpu(cpu >= 0 ? cpu : ThreadRuntime::current_cpu());
+        shard.ring = NodeLocal<ShardRing>::create(node);
+        if (!shard.ring) {
+            return false;
+        }
+        shard.books.reset();
+        shard.symbol_messages.fill(0);
+        shard.processed.store(0, std::memory_order_relaxed);
+        shard.ready.store(false, std::memory_order_relaxed);
+    }
+    unroutable_ = 0;
+    routes_ = std::make_unique<OrderRoutes>(config_.orders_per_shard * shard_count());
+
+    running_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < shard_count(); ++i) {
+        shards_[i]->thread = PinnedThread("book-shard", config_.placements[i],
+                                          [this, i] { run_shard(i); });
+    }
+    for (size_t i = 0; i < shard_count(); ++i) {
+        while (!shards_[i]->ready.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+void ShardedEngine::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (size_t i = 0; i < shard_count(); ++i) {
+        shards_[i]->thread.join();
+    }
+}
+
+bool ShardedEngine::set_router(const ShardRouter& router) noexcept {
+    if (running()) {
+        return false;  // Books are partitioned for the whole session
+    }
+    router_ = router;
+    return true;
+}
+
+const OrderBook* ShardedEngine::book(SymbolId symbol) const noexcept {
+    if (symbol >= Config::MAX_SYMBOLS) {
+        return nullptr;
+    }
+    const BookManager* books = shard_books(router_.shard_of(symbol));
+    return books != nullptr ? books->book(symbol) : nullptr;
+}
+
+std::array<uint64_t, Config::MAX_SYMBOLS> ShardedEngine::observed_weights() const noexcept {
+    std::array<uint64_t, Config::MAX_SYMBOLS> weights{};
+    for (size_t i = 0; i < shard_count(); ++i) {
+        for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+            weights[s] += shards_[i]->symbol_messages[s];
+        }
+    }
+    return weights;
+}
+
+void ShardedEngine::run_shard(size_t index) noexcept {
+    Shard& shard = *shards_[index];
+
+    // Built on this thread so its pages follow the thread's memory policy
+    shard.books = std::make_unique<BookManager>(config_.orders_per_shard);
+    for (SymbolId s = 0; s < Config::MAX_SYMBOLS; ++s) {
+        if (router_.shard_of(s) == index) {
+            shard.books->add_symbol(s);
+        }
+    }
+    shard.ready.store(true, std::memory_order_release);
+
+    BookManager& books = *shard.books;
+    ShardRing& ring = *shard.ring;
+    auto apply = [&](Message& msg) {
+        books.process(msg);
+        ++shard.symbol_messages[msg.symbol];
+    };
+
+    // Single writer: relaxed store, no locked RMW
+    auto count = [&](size_t n) {
+        shard.processed.store(shard.processed.load(std::memory_order_relaxed) + n,
+                              std::memory_order_relaxed);
+    };
+
+    uint32_t idle = 0;
+    for (;;) {
+        const size_t n = ring.consume_all(apply);
+        if (n != 0) {
+            count(n);
+            idle = 0;
+            continue;
+        }
+        if (!running_.load(std::memory_order_acquire)) {
+            // The feed published its last messages before stop(); take them
+            while (const size_t rest = ring.consume_all(apply)) {
+                count(rest);
+            }
+            return;
+        }
+        if (config_.yield_when_idle && ++idle > IDLE_SPINS_BEFORE_YIELD) {
+            std::this_thread::yield();
+        } else {
+            _mm_pause();
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include "TSCClock.h"
+#include <ctime>
+
+namespace {
+
+uint64_t realtime_ns() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+}  // namespace
+
+TSCClock::TSCClock(const TSCTimer& timer)
+    : nominal_mult_(static_cast<uint64_t>(
+          static_cast<double>(uint64_t{1} << SHIFT) / timer.get_frequency_ghz())),
+      provisional_(timer.frequency_is_estimate()) {
+    mult_.store(nominal_mult_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    anchor();
+}
+
+TSCClock& TSCClock::instance() {
+    static TSCClock clock;
+    return clock;
+}
+
+void TSCClock::anchor() noexcept {
+    // Pair CLOCK_REALTIME with the midpoint of the tightest rdtscp bracket
+    uint64_t best_width = UINT64_MAX;
+    uint64_t tsc = 0;
+    uint64_t ns = 0;
+    for (int i = 0; i < 8; ++i) {
+        const uint64_t before = read_tsc();
+        const uint64_t sample_ns = realtime_ns();
+        const uint64_t after = read_tsc();
+        if (after - before < best_width) {
+            best_width = after - before;
+            tsc = before + (after - before) / 2;
+            ns = sample_ns;
+        }
+    }
+
+    uint64_t mult = mult_.load(std::memory_order_relaxed);
+    if (anchor_count_.load(std::memory_order_relaxed) == 0) {
+        slope_tsc_ = tsc;
+        slope_ns_ = ns;
+    } else {
+        last_correction_ns_.store(static_cast<int64_t>(ns - utc_ns(tsc)), std::memory_order_relaxed);
+
+        // Re-derive the slope over a long enough baseline for the bracket
+        // error to vanish; a clock step shows up as an implausible slope
+        const uint64_t elapsed_ns = ns - slope_ns_;
+        if (ns > slope_ns_ && elapsed_ns >= MIN_SLOPE_INTERVAL_NS && tsc > slope_tsc_) {
+            const auto measured = static_cast<uint64_t>(
+                (static_cast<uint128>(elapsed_ns) << SHIFT) / (tsc - slope_tsc_));
+            // An estimated nominal rate is off by more than a drift: judge
+            // the first slope against the estimate's error instead, and
+            // take it as the reference for every later one
+            const bool provisional = provisional_.load(std::memory_order_relaxed);
+            const uint64_t nominal = nominal_mult_.load(std::memory_order_relaxed);
+            const uint64_t tolerance = nominal / 1'000'000 *
+                                       (provisional ? MAX_ESTIMATE_ERROR_PPM : MAX_DRIFT_PPM);
+            const uint64_t deviation = measured > nominal ? measured - nominal : nominal - measured;
+            if (deviation <= tolerance) {
+                mult = measured;
+                if (provisional) {
+                    nominal_mult_.store(measured, std::memory_order_relaxed);
+                    provisional_.store(false, std::memory_order_relaxed);
+                }
+            } else {
+                rejected_slopes_.fetch_add(1, std::memory_order_relaxed);
+                mult = nominal;
+            }
+            slope_tsc_ = tsc;
+            slope_ns_ = ns;
+        } else if (ns < slope_ns_) {
+            // Clock stepped backwards: restart the baseline
+            rejected_slopes_.fetch_add(1, std::memory_order_relaxed);
+            slope_tsc_ = tsc;
+            slope_ns_ = ns;
+        }
+    }
+
+    publish_anchor(tsc, ns, mult);
+    anchor_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TSCClock::publish_anchor(uint64_t base_tsc, uint64_t base_ns, uint64_t mult) noexcept {
+    const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    base_tsc_.store(base_tsc, std::memory_order_relaxed);
+    base_ns_.store(base_ns, std::memory_order_relaxed);
+    mult_.store(mult, std::memory_order_relaxed);
+
+    sequence_.store(seq + 2, std::memory_order_release);
+}
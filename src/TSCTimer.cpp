@@ -2,12 +2,71 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
 
-TSCTimer::TSCTimer() : tsc_freq_ghz_(0.0) {
+#ifndef _WIN32
+    #include <cpuid.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+struct CpuidRegs {
+    uint32_t eax, ebx, ecx, edx;
+};
+
+CpuidRegs cpuid(uint32_t leaf) noexcept {
+    CpuidRegs r{0, 0, 0, 0};
+    #ifdef _WIN32
+        int cpuInfo[4];
+        __cpuidex(cpuInfo, static_cast<int>(leaf), 0);
+        r = {static_cast<uint32_t>(cpuInfo[0]), static_cast<uint32_t>(cpuInfo[1]),
+             static_cast<uint32_t>(cpuInfo[2]), static_cast<uint32_t>(cpuInfo[3])};
+    #else
+        __cpuid_count(leaf, 0, r.eax, r.ebx, r.ecx, r.edx);
+    #endif
+    return r;
+}
+
+// Ties the cache file to one boot of one host: the TSC rate is fixed for
+// the life of a boot, but may be re-derived differently after a reboot
+std::string boot_id() {
+    std::ifstream in("/proc/sys/kernel/random/boot_id");
+    std::string id;
+    in >> id;
+    return id.empty() ? "unknown" : id;
+}
+
+}  // namespace
+
+TSCTimer::TSCTimer() : tsc_freq_ghz_(0.0), source_(TSCFrequencySource::CALIBRATED) {
     if (!is_tsc_available()) {
         std::cerr << "Warning: TSC not available or unreliable on this system\n";
     }
-    calibrate();
+
+    // Cheapest source first; measuring is the last resort
+    if ((tsc_freq_ghz_ = frequency_from_environment()) != 0.0) {
+        source_ = TSCFrequencySource::ENVIRONMENT;
+    } else if ((tsc_freq_ghz_ = load_cached_frequency(cache_file_path())) != 0.0) {
+        source_ = TSCFrequencySource::CACHE_FILE;
+    } else if (bool estimate = false; (tsc_freq_ghz_ = frequency_from_cpuid(&estimate)) != 0.0) {
+        source_ = estimate ? TSCFrequencySource::CPUID_ESTIMATE : TSCFrequencySource::CPUID;
+    } else {
+        calibrate();
+    }
+}
+
+TSCTimer::TSCTimer(double freq_ghz, TSCFrequencySource source) noexcept
+    : tsc_freq_ghz_(freq_ghz), source_(source) {}
+
+const TSCTimer& TSCTimer::instance() {
+    static const TSCTimer timer;
+    return timer;
 }
 
 bool TSCTimer::is_tsc_available() {
@@ -28,6 +87,136 @@ bool TSCTimer::is_tsc_available() {
     return (edx & (1 << 4)) != 0;  // Check TSC bit
 }
 
+bool TSCTimer::is_invariant_tsc() {
+    if (cpuid(0x80000000).eax < 0x80000007) {
+        return false;
+    }
+    return (cpuid(0x80000007).edx & (1 << 8)) != 0;  // Invariant TSC bit
+}
+
+double TSCTimer::frequency_from_environment() noexcept {
+    const char* value = std::getenv(FREQ_ENV_VAR);
+    if (value == nullptr || *value == '\0') {
+        return 0.0;
+    }
+    char* end = nullptr;
+    const double freq_ghz = std::strtod(value, &end);
+    return (*end == '\0' && is_plausible(freq_ghz)) ? freq_ghz : 0.0;
+}
+
+double TSCTimer::frequency_from_cpuid(bool* estimate) noexcept {
+    if (estimate != nullptr) {
+        *estimate = false;
+    }
+    // A frequency only means anything if the TSC does not follow P-states
+    if (!is_invariant_tsc()) {
+        return 0.0;
+    }
+    const uint32_t max_leaf = cpuid(0).eax;
+
+    // Leaf 0x15: TSC = crystal * EBX / EAX. Exact when the crystal is reported.
+    if (max_leaf >= 0x15) {
+        const CpuidRegs r = cpuid(0x15);
+        if (r.eax != 0 && r.ebx != 0 && r.ecx != 0) {
+            const double freq_ghz = static_cast<double>(r.ecx) * r.ebx / r.eax / 1e9;
+            if (is_plausible(freq_ghz)) {
+                return freq_ghz;
+            }
+        }
+    }
+
+    // Leaf 0x16: processor base frequency in whole MHz, which the invariant
+    // TSC runs at on the parts that report 0x15 without a crystal
+    // frequency. It is the nominal rate, not a measured one, so callers
+    // are told it is an estimate.
+    if (max_leaf >= 0x16) {
+        const uint32_t base_mhz = cpuid(0x16).eax & 0xFFFF;
+        const double freq_ghz = base_mhz / 1e3;
+        if (is_plausible(freq_ghz)) {
+            if (estimate != nullptr) {
+                *estimate = true;
+            }
+            return freq_ghz;
+        }
+    }
+    return 0.0;
+}
+
+const char* TSCTimer::cache_file_path() noexcept {
+    if (const char* path = std::getenv(CACHE_ENV_VAR)) {
+        return path;
+    }
+
+    // Per-user location: the runtime dir is private to the user; the /tmp
+    // fallback is shared, which is why loading also checks ownership
+    static const std::string default_path = [] {
+        const char* runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+        if (runtime_dir != nullptr && *runtime_dir == '/') {
+            return std::string(runtime_dir) + '/' + CACHE_FILE_NAME;
+        }
+        return std::string("/tmp/") + CACHE_FILE_NAME + '.' + std::to_string(::geteuid());
+    }();
+    return default_path.c_str();
+}
+
+double TSCTimer::load_cached_frequency(const char* path) {
+    if (path == nullptr || *path == '\0') {
+        return 0.0;
+    }
+
+    // Anyone can create files in /tmp: only trust a regular file (not a
+    // symlink) that this user owns and nobody else can write
+    const int fd = ::open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        return 0.0;
+    }
+    struct stat st;
+    char contents[128];
+    ssize_t length = -1;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_uid == ::geteuid() &&
+        (st.st_mode & (S_IWGRP | S_IWOTH)) == 0) {
+        length = ::read(fd, contents, sizeof(contents) - 1);
+    }
+    ::close(fd);
+    if (length <= 0) {
+        return 0.0;
+    }
+    contents[length] = '\0';
+
+    char cached_boot_id[64];
+    double freq_ghz = 0.0;
+    if (std::sscanf(contents, "%63s %lf", cached_boot_id, &freq_ghz) != 2 ||
+        cached_boot_id != boot_id()) {
+        return 0.0;
+    }
+    return is_plausible(freq_ghz) ? freq_ghz : 0.0;
+}
+
+bool TSCTimer::store_cached_frequency(const char* path, double freq_ghz) {
+    if (path == nullptr || *path == '\0' || !is_plausible(freq_ghz)) {
+        return false;
+    }
+
+    // Write a fresh 0600 file then rename, so a crash mid-write never
+    // leaves a torn cache and a file planted at the temporary path (or a
+    // symlink there) is refused rather than written through
+    const std::string tmp_path = std::string(path) + ".tmp";
+    ::unlink(tmp_path.c_str());     // A leftover of ours; fails harmlessly on anyone else's
+    const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    char contents[128];
+    const int length = std::snprintf(contents, sizeof(contents), "%s %.12g\n", boot_id().c_str(), freq_ghz);
+    const bool written = length > 0 && static_cast<size_t>(length) < sizeof(contents) &&
+                         ::write(fd, contents, static_cast<size_t>(length)) == length;
+    if (::close(fd) != 0 || !written || std::rename(tmp_path.c_str(), path) != 0) {
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
 void TSCTimer::calibrate() {
     std::cout << "Calibrating TSC timer...\n";
     warmup_tsc();
@@ -44,19 +233,40 @@ void TSCTimer::calibrate() {
     uint64_t median_freq = frequencies[num_measurements / 2];
     
     tsc_freq_ghz_ = static_cast<double>(median_freq) / 1e9;
+    source_ = TSCFrequencySource::CALIBRATED;
+    store_cached_frequency(cache_file_path(), tsc_freq_ghz_);
     
     std::cout << "TSC frequency: " << std::fixed << std::setprecision(3) 
               << tsc_freq_ghz_ << " GHz\n";
 }
 
 uint64_t TSCTimer::measure_tsc_frequency() {
-    auto start_time = std::chrono::high_resolution_clock::now();
-    uint64_t start_tsc = now();
+    // Pair a clock read with the TSC midpoint of the tightest of several
+    // rdtscp brackets around it, so a preemption or slow clock read at
+    // either end of the interval does not skew the result
+    auto sample = [this](uint64_t& tsc_mid) {
+        uint64_t best_width = UINT64_MAX;
+        std::chrono::steady_clock::time_point best_time{};
+        for (int i = 0; i < 5; ++i) {
+            const uint64_t before = now();
+            const auto time = std::chrono::steady_clock::now();
+            const uint64_t after = now();
+            if (after - before < best_width) {
+                best_width = after - before;
+                best_time = time;
+                tsc_mid = before + (after - before) / 2;
+            }
+        }
+        return best_time;
+    };
+
+    uint64_t start_tsc = 0;
+    uint64_t end_tsc = 0;
+    const auto start_time = sample(start_tsc);
     
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     
-    uint64_t end_tsc = now();
-    auto end_time = std::chrono::high_resolution_clock::now();
+    const auto end_time = sample(end_tsc);
     
     auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
         end_time - start_time).count();
@@ -75,11 +285,10 @@ void TSCTimer::warmup_tsc() {
     (void)dummy;
 }
 
-TSCTimer ScopedTimer::timer_;
-
 ScopedTimer::~ScopedTimer() {
-    uint64_t end_cycles = timer_.now();
-    double elapsed_ns = timer_.cycles_to_ns(end_cycles - start_cycles_);
+    const TSCTimer& timer = TSCTimer::instance();
+    uint64_t end_cycles = timer.now();
+    double elapsed_ns = timer.cycles_to_ns(end_cycles - start_cycles_);
     
     std::cout << "[TIMER] " << name_ << ": " 
               << std::fixed << std::setprecision(2) << elapsed_ns << " ns\n";
@@ -0,0 +1,249 @@
+#include "TelemetryExporter.h"
+#include "ThreadRuntime.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int POLL_INTERVAL_MS = 100;      // stop() latency bound
+constexpr size_t MAX_REQUEST_BYTES = 4096;
+
+void append(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void append(std::string& out, const char* format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    const int n = std::vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (n > 0) {
+        out.append(line, std::min(static_cast<size_t>(n), sizeof(line) - 1));
+    }
+}
+
+const char* type_label(MessageType type) noexcept {
+    switch (type) {
+        case MessageType::ADD_ORDER: return "add";
+        case MessageType::CANCEL_ORDER: return "cancel";
+        case MessageType::MODIFY_ORDER: return "modify";
+        case MessageType::EXECUTE_ORDER: return "execute";
+        case MessageType::TRADE: return "trade";
+        case MessageType::HEARTBEAT: return "heartbeat";
+    }
+    return "unknown";
+}
+
+void family(std::string& out, const char* name, const char* type, const char* help) {
+    append(out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+bool send_all(int fd, const char* data, size_t bytes) noexcept {
+    while (bytes != 0) {
+        const ssize_t n = ::send(fd, data, bytes, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+}  // namespace
+
+TelemetryExporter::~TelemetryExporter() {
+    stop();
+}
+
+bool TelemetryExporter::add_histogram(const char* name, const LatencyHistogram& histogram) noexcept {
+    if (histogram_count_ == MAX_SOURCES) {
+        return false;
+    }
+    histograms_[histogram_count_++] = HistogramSource{name, &histogram};
+    return true;
+}
+
+void TelemetryExporter::render(std::string& out) const {
+    out.clear();
+
+    // Rings: sample each once, then emit family by family
+    std::array<RingHealth, MAX_SOURCES> rings;
+    for (size_t i = 0; i < ring_count_; ++i) {
+        rings[i] = rings_[i].sample(rings_[i].ring);
+    }
+    auto ring_family = [&](const char* name, const char* type, const char* help, auto field) {
+        if (ring_count_ == 0) return;
+        family(out, name, type, help);
+        for (size_t i = 0; i < ring_count_; ++i) {
+            append(out, "%s{ring=\"%s\"} %" PRIu64 "\n", name, rings_[i].name, rings[i].*field);
+        }
+    };
+    ring_family("hft_ring_occupancy", "gauge", "Items queued in the ring", &RingHealth::occupancy);
+    ring_family("hft_ring_capacity", "gauge", "Usable ring slots", &RingHealth::capacity);
+    ring_family("hft_ring_high_watermark", "gauge",
+                "Deepest backlog seen by the consumer", &RingHealth::high_watermark);
+    ring_family("hft_ring_pushes_total", "counter", "Items pushed", &RingHealth::pushes);
+    ring_family("hft_ring_failed_pushes_total", "counter",
+                "Pushes rejected by a full ring", &RingHealth::failed_pushes);
+
+    // Books
+    if (book_count_ != 0) {
+        family(out, "hft_book_messages_total", "counter", "Messages applied, by type (rejects excluded)");
+        for (size_t i = 0; i < book_count_; ++i) {
+            for (size_t t = 1; t < BookHealth::TYPE_COUNT; ++t) {
+                append(out, "hft_book_messages_total{books=\"%s\",type=\"%s\"} %" PRIu64 "\n",
+                       books_[i].name, type_label(static_cast<MessageType>(t)),
+                       books_[i].health->messages[t].value());
+            }
+        }
+    }
+    auto book_family = [&](const char* name, const char* type, const char* help, auto value) {
+        if (book_count_ == 0) return;
+        family(out, name, type, help);
+        for (size_t i = 0; i < book_count_; ++i) {
+            append(out, "%s{books=\"%s\"} %s\n", name, books_[i].name, value(books_[i]).c_str());
+        }
+    };
+    auto counter = [](HealthCounter BookHealth::*field) {
+        return [field](const BookSource& source) { return std::to_string((source.health->*field).value()); };
+    };
+    book_family("hft_book_rejected_total", "counter", "Orders rejected", counter(&BookHealth::rejected));
+    book_family("hft_book_unknown_orders_total", "counter",
+                "Messages naming an id not in the index", counter(&BookHealth::unknown));
+    book_family("hft_pool_orders_in_use", "gauge", "Resting orders", counter(&BookHealth::orders_in_use));
+    book_family("hft_pool_capacity", "gauge", "Order pool slots",
+                [](const BookSource& source) { return std::to_string(source.pool_capacity); });
+    book_family("hft_pool_high_watermark", "gauge", "Most orders resting at once",
+                counter(&BookHealth::pool_high_watermark));
+    book_family("hft_pool_failed_allocations_total", "counter", "Adds refused by a full pool",
+                counter(&BookHealth::pool_failed_allocations));
+    book_family("hft_index_longest_probe", "gauge", "Longest id index insert probe",
+                counter(&BookHealth::index_longest_probe));
+    book_family("hft_index_mean_probe", "gauge", "Mean id index insert probe",
+                [](const BookSource& source) {
+                    char value[32];
+                    std::snprintf(value, sizeof(value), "%.3f",
+                                  static_cast<double>(source.health->index_mean_probe_milli.value()) / 1000.0);
+                    return std::string(value);
+                });
+
+    // Histograms, as summaries in nanoseconds
+    if (histogram_count_ != 0) {
+        family(out, "hft_latency_ns", "summary", "Zone latency in nanoseconds");
+        for (size_t i = 0; i < histogram_count_; ++i) {
+            const char* name = histograms_[i].name;
+            const LatencySummary s = histograms_[i].histogram->summary(timer_);
+            const std::pair<const char*, double> quantiles[] = {
+                {"0.5", s.p50_ns}, {"0.99", s.p99_ns}, {"0.999", s.p999_ns}, {"0.9999", s.p9999_ns}, {"1", s.max_ns}};
+            for (const auto& [quantile, value] : quantiles) {
+                append(out, "hft_latency_ns{zone=\"%s\",quantile=\"%s\"} %.1f\n", name, quantile, value);
+            }
+            append(out, "hft_latency_ns_sum{zone=\"%s\"} %.1f\n", name, s.mean_ns * static_cast<double>(s.count));
+            append(out, "hft_latency_ns_count{zone=\"%s\"} %" PRIu64 "\n", name, s.count);
+        }
+    }
+}
+
+bool TelemetryExporter::start(uint16_t port, const char* address) {
+    if (running_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    const int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    socklen_t length = sizeof(addr);
+    if (inet_pton(AF_INET, address, &addr.sin_addr) != 1 ||
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listen_fd_, 8) != 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &length) != 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread([this] {
+        ThreadRuntime::set_thread_name("hft-telemetry");
+        serve();
+    });
+    return true;
+}
+
+void TelemetryExporter::stop() noexcept {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    thread_.join();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+}
+
+void TelemetryExporter::serve() noexcept {
+    while (running_.load(std::memory_order_relaxed)) {
+        pollfd listener{listen_fd_, POLLIN, 0};
+        if (poll(&listener, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+        const int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0) {
+            answer(fd);
+            ::close(fd);
+        }
+    }
+}
+
+void TelemetryExporter::answer(int fd) noexcept {
+    // A scraper that stalls mid-request only holds off the next one
+    const timeval timeout{0, POLL_INTERVAL_MS * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    char request[MAX_REQUEST_BYTES];
+    size_t received = 0;
+    while (received < sizeof(request) - 1) {
+        const ssize_t n = ::recv(fd, request + received, sizeof(request) - 1 - received, 0);
+        if (n <= 0) {
+            break;
+        }
+        received += static_cast<size_t>(n);
+        request[received] = '\0';
+        if (std::strstr(request, "\r\n\r\n") != nullptr) {
+            break;
+        }
+    }
+    request[received] = '\0';
+
+    std::string body;
+    const char* status = "200 OK";
+    if (std::strncmp(request, "GET ", 4) != 0) {
+        status = "405 Method Not Allowed";
+    } else {
+        render(body);
+    }
+
+    std::string response;
+    append(response, "HTTP/1.0 %s\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                     "Content-Length: %zu\r\nConnection: close\r\n\r\n", status, body.size());
+    response += body;
+    if (send_all(fd, response.data(), response.size())) {
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
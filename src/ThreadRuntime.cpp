@@ -0,0 +1,196 @@
+#include "ThreadRuntime.h"
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr unsigned long NODEMASK_BITS = 64 * 16;   // Up to 1024 nodes
+
+bool make_nodemask(int node, unsigned long (&mask)[NODEMASK_BITS / 64]) noexcept {
+    if (node < 0 || static_cast<unsigned long>(node) >= NODEMASK_BITS) {
+        return false;
+    }
+    std::memset(mask, 0, sizeof(mask));
+    mask[node / 64] = 1UL << (node % 64);
+    return true;
+}
+
+// Widen [addr, addr + bytes) to page boundaries
+void page_range(void* addr, size_t bytes, uintptr_t& start, size_t& length) noexcept {
+    const uintptr_t page = ThreadRuntime::page_size();
+    start = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + bytes + page - 1) & ~(page - 1);
+    length = end - start;
+}
+
+}  // namespace
+
+PlacementStatus ThreadRuntime::apply(const ThreadPlacement& placement) noexcept {
+    PlacementStatus status;
+    if (placement.cpu >= 0) {
+        status.pinned = pin_current_thread(placement.cpu);
+        status.node = node_of_cpu(placement.cpu);
+        if (placement.local_memory) {
+            status.memory_policy = prefer_node(status.node);
+        }
+    }
+    if (placement.fifo_priority > 0) {
+        status.realtime = set_fifo_priority(placement.fifo_priority);
+    }
+    return status;
+}
+
+bool ThreadRuntime::pin_current_thread(int cpu) noexcept {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool ThreadRuntime::set_fifo_priority(int priority) noexcept {
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+bool ThreadRuntime::prefer_node(int node) noexcept {
+    unsigned long mask[NODEMASK_BITS / 64];
+    if (!make_nodemask(node, mask)) {
+        return false;
+    }
+    // Preferred rather than bound: a full node spills over instead of OOM
+    return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, NODEMASK_BITS) == 0;
+}
+
+bool ThreadRuntime::reset_memory_policy() noexcept {
+    return syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0) == 0;
+}
+
+int ThreadRuntime::current_cpu() noexcept {
+    return sched_getcpu();
+}
+
+void ThreadRuntime::set_thread_name(const char* name) noexcept {
+    if (name == nullptr) {
+        return;
+    }
+    char truncated[16];   // Kernel limit, including the terminator
+    std::snprintf(truncated, sizeof(truncated), "%s", name);
+    pthread_setname_np(pthread_self(), truncated);
+}
+
+int ThreadRuntime::node_of_cpu(int cpu) noexcept {
+    char path[64];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+    DIR* dir = opendir(path);
+    if (dir == nullptr) {
+        return 0;
+    }
+
+    // The cpu directory holds a nodeN link to its node
+    int node = 0;
+    while (dirent* entry = readdir(dir)) {
+        int parsed;
+        if (std::sscanf(entry->d_name, "node%d", &parsed) == 1) {
+            node = parsed;
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+int ThreadRuntime::node_count() noexcept {
+    DIR* dir = opendir("/sys/devices/system/node");
+    if (dir == nullptr) {
+        return 1;
+    }
+    int count = 0;
+    while (dirent* entry = readdir(dir)) {
+        int parsed;
+        if (std::sscanf(entry->d_name, "node%d", &parsed) == 1) {
+            ++count;
+        }
+    }
+    closedir(dir);
+    return count == 0 ? 1 : count;
+}
+
+size_t ThreadRuntime::page_size() noexcept {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+bool ThreadRuntime::bind_to_node(void* addr, size_t bytes, int node) noexcept {
+    unsigned long mask[NODEMASK_BITS / 64];
+    if (bytes == 0 || !make_nodemask(node, mask)) {
+        return false;
+    }
+    uintptr_t start;
+    size_t length;
+    page_range(addr, bytes, start, length);
+
+    // MPOL_MF_MOVE migrates pages that were already faulted in elsewhere
+    return syscall(SYS_mbind, start, length, MPOL_BIND, mask, NODEMASK_BITS, MPOL_MF_MOVE) == 0;
+}
+
+void ThreadRuntime::prefault(void* addr, size_t bytes) noexcept {
+    if (bytes == 0) {
+        return;
+    }
+    // Write-touch each page: a read would only map the shared zero page.
+    // Rewriting the byte already there keeps live contents intact. The
+    // first page is touched at addr itself, so no byte outside
+    // [addr, addr + bytes) is accessed (heap blocks share their pages).
+    const uintptr_t page = page_size();
+    const uintptr_t first = reinterpret_cast<uintptr_t>(addr);
+    const uintptr_t end = first + bytes;
+    for (uintptr_t at = first; at < end; at = (at & ~(page - 1)) + page) {
+        auto* byte = reinterpret_cast<volatile char*>(at);
+        *byte = *byte;
+    }
+}
+
+bool ThreadRuntime::lock(void* addr, size_t bytes) noexcept {
+    uintptr_t start;
+    size_t length;
+    page_range(addr, bytes, start, length);
+    return mlock(reinterpret_cast<void*>(start), length) == 0;
+}
+
+bool ThreadRuntime::lock_all() noexcept {
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+namespace detail {
+
+void* map_node_memory(size_t bytes, int node) noexcept {
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // Bind before the first touch so every page faults in on the node;
+    // binding and locking are best effort (single node, RLIMIT_MEMLOCK)
+    ThreadRuntime::bind_to_node(memory, bytes, node);
+    ThreadRuntime::prefault(memory, bytes);
+    ThreadRuntime::lock(memory, bytes);
+    return memory;
+}
+
+void unmap_node_memory(void* addr, size_t bytes) noexcept {
+    munmap(addr, bytes);
+}
+
+}  // namespace detail
@@ -32,7 +32,7 @@ int main() {
     // Test TSC timer
     if (TSCTimer::is_tsc_available()) {
         std::cout << "TSC Timer Test:\n";
-        TSCTimer timer;
+        const TSCTimer& timer = TSCTimer::instance();
         
         uint64_t start = timer.now();
         volatile int sum = 0;
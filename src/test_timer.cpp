@@ -4,7 +4,7 @@
 void test_basic_timing() {
     std::cout << "=== Basic Timing Test ===\n";
     
-    TSCTimer timer;
+    const TSCTimer& timer = TSCTimer::instance();
     uint64_t start = timer.now();
     
     volatile int sum = 0;
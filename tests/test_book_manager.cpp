@@ -0,0 +1,100 @@
+#include "BookManager.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+class BookManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(books.add_symbol(1));
+        ASSERT_TRUE(books.add_symbol(2));
+    }
+
+    BookManager books{1024};
+};
+
+}  // namespace
+
+TEST_F(BookManagerTest, RoutesOrdersToTheirSymbol) {
+    EXPECT_TRUE(books.add_order(1, 100, Side::BUY, 500, 10));
+    EXPECT_TRUE(books.add_order(2, 200, Side::SELL, 700, 20));
+
+    EXPECT_EQ(books.book(1)->best_bid(), 500u);
+    EXPECT_FALSE(books.book(1)->has_ask());
+    EXPECT_EQ(books.book(2)->best_ask(), 700u);
+    EXPECT_EQ(books.order_count(), 2u);
+}
+
+TEST_F(BookManagerTest, RejectsUnknownSymbolAndDuplicateId) {
+    EXPECT_FALSE(books.add_order(3, 100, Side::BUY, 500, 10));
+    EXPECT_FALSE(books.add_symbol(Config::MAX_SYMBOLS));
+    EXPECT_TRUE(books.add_order(1, 100, Side::BUY, 500, 10));
+    EXPECT_FALSE(books.add_order(2, 100, Side::BUY, 500, 10));
+    EXPECT_EQ(books.rejected_orders(), 2u);
+}
+
+TEST_F(BookManagerTest, CancelById) {
+    books.add_order(1, 100, Side::BUY, 500, 10);
+
+    EXPECT_TRUE(books.cancel_order(100, 4));
+    EXPECT_EQ(books.book(1)->quantity_at(Side::BUY, 500), 6u);
+    EXPECT_NE(books.find_order(100), INVALID_ORDER_HANDLE);
+
+    EXPECT_TRUE(books.cancel_order(100));
+    EXPECT_EQ(books.find_order(100), INVALID_ORDER_HANDLE);
+    EXPECT_FALSE(books.book(1)->has_bid());
+    EXPECT_EQ(books.pool().in_use(), 0u);
+
+    EXPECT_FALSE(books.cancel_order(100));
+    EXPECT_EQ(books.unknown_orders(), 1u);
+}
+
+TEST_F(BookManagerTest, PartialCancelOfWholeSizeRemovesOrder) {
+    books.add_order(1, 100, Side::SELL, 500, 10);
+    EXPECT_TRUE(books.cancel_order(100, 10));
+    EXPECT_EQ(books.order_count(), 0u);
+    EXPECT_FALSE(books.book(1)->has_ask());
+}
+
+TEST_F(BookManagerTest, ExecuteById) {
+    books.add_order(2, 100, Side::SELL, 500, 10);
+
+    EXPECT_TRUE(books.execute_order(100, 3));
+    EXPECT_EQ(books.book(2)->quantity_at(Side::SELL, 500), 7u);
+    EXPECT_TRUE(books.execute_order(100, 7));
+    EXPECT_EQ(books.find_order(100), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(books.book(2)->executed_volume(), 10u);
+}
+
+TEST_F(BookManagerTest, FillByHandle) {
+    books.add_order(1, 100, Side::BUY, 500, 10);
+    const OrderHandle handle = books.find_order(100);
+
+    EXPECT_EQ(books.fill_order(handle, 4), 6u);
+    EXPECT_EQ(books.fill_order(handle, 6), 0u);
+    EXPECT_EQ(books.find_order(100), INVALID_ORDER_HANDLE);
+    EXPECT_FALSE(books.book(1)->has_bid());
+}
+
+TEST_F(BookManagerTest, ModifyById) {
+    books.add_order(1, 100, Side::BUY, 500, 10);
+
+    EXPECT_TRUE(books.modify_order(100, 505, 12));
+    EXPECT_EQ(books.book(1)->best_bid(), 505u);
+    EXPECT_FALSE(books.modify_order(100, 0, 12));
+
+    EXPECT_TRUE(books.modify_order(100, 505, 0));
+    EXPECT_EQ(books.order_count(), 0u);
+}
+
+TEST_F(BookManagerTest, ReplaceUnderNewId) {
+    books.add_order(1, 100, Side::SELL, 500, 10);
+
+    EXPECT_TRUE(books.replace_order(100, 101, 498, 5));
+    EXPECT_EQ(books.find_order(100), INVALID_ORDER_HANDLE);
+    const OrderHandle h = books.find_order(101);
+    ASSERT_NE(h, INVALID_ORDER_HANDLE);
+    EXPECT_EQ(books.book(1)->order(h).side, Side::SELL);
+    EXPECT_EQ(books.book(1)->best_ask(), 498u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 500), 0u);
+}
@@ -0,0 +1,237 @@
+#include "BookPublisher.h"
+#include "BroadcastRing.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+Message add(OrderId id, Side side, Price price, Quantity qty, uint64_t seq = 0) {
+    Message msg{};
+    msg.type = MessageType::ADD_ORDER;
+    msg.symbol = 1;
+    msg.order_id = id;
+    msg.side = side;
+    msg.price = price;
+    msg.quantity = qty;
+    msg.sequence = seq;
+    return msg;
+}
+
+Message cancel(OrderId id, Quantity qty = 0) {
+    Message msg{};
+    msg.type = MessageType::CANCEL_ORDER;
+    msg.order_id = id;
+    msg.quantity = qty;
+    return msg;
+}
+
+Message modify(OrderId id, Price price, Quantity qty) {
+    Message msg{};
+    msg.type = MessageType::MODIFY_ORDER;
+    msg.order_id = id;
+    msg.price = price;
+    msg.quantity = qty;
+    return msg;
+}
+
+std::vector<LevelUpdate> drain(LevelUpdateRing& ring) {
+    std::vector<LevelUpdate> out;
+    LevelUpdate u;
+    while (ring.try_pop(u)) out.push_back(u);
+    return out;
+}
+
+struct Wide {
+    uint64_t a, b, c, d;
+};
+
+}  // namespace
+
+class BookPublisherTest : public ::testing::Test {
+protected:
+    BookManager books{1024};
+    std::unique_ptr<LevelUpdateRing> ring = std::make_unique<LevelUpdateRing>();
+
+    void SetUp() override { books.add_symbol(1); }
+};
+
+TEST(SeqlockTest, RoundTrip) {
+    Seqlock<Wide> cell;
+    EXPECT_EQ(cell.load().a, 0u);
+    const uint64_t v0 = cell.version();
+    cell.store(Wide{1, 2, 3, 4});
+    Wide w{};
+    ASSERT_TRUE(cell.try_load(w));
+    EXPECT_EQ(w.d, 4u);
+    EXPECT_EQ(cell.version(), v0 + 2);
+}
+
+TEST(SeqlockTest, ReaderNeverSeesTornValue) {
+    Seqlock<Wide> cell;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= 200000; ++i) cell.store(Wide{i, i, i, i});
+        done.store(true, std::memory_order_release);
+    });
+    uint64_t reads = 0;
+    while (!done.load(std::memory_order_acquire) || reads == 0) {
+        const Wide w = cell.load();
+        ASSERT_TRUE(w.a == w.b && w.b == w.c && w.c == w.d);
+        ++reads;
+    }
+    writer.join();
+    EXPECT_EQ(cell.load().a, 200000u);
+}
+
+TEST_F(BookPublisherTest, DepthWalksFromTheTouch) {
+    books.add_order(1, 1, Side::BUY, 100, 10);
+    books.add_order(1, 2, Side::BUY, 98, 5);
+    books.add_order(1, 3, Side::BUY, 100, 7);
+    books.add_order(1, 4, Side::SELL, 103, 4);
+    books.add_order(1, 5, Side::SELL, 101, 6);
+
+    std::array<DepthLevel, 4> out;
+    const OrderBook* book = books.book(1);
+    ASSERT_EQ(book->depth(Side::BUY, out), 2u);
+    EXPECT_EQ(out[0].price, 100u);
+    EXPECT_EQ(out[0].quantity, 17u);
+    EXPECT_EQ(out[0].order_count, 2u);
+    EXPECT_EQ(out[1].price, 98u);
+
+    ASSERT_EQ(book->depth(Side::SELL, std::span(out).first(1)), 1u);
+    EXPECT_EQ(out[0].price, 101u);
+
+    BookManager empty(16);
+    empty.add_symbol(2);
+    EXPECT_EQ(empty.book(2)->depth(Side::BUY, out), 0u);
+}
+
+TEST_F(BookPublisherTest, EmitsLevelStateForEachChange) {
+    BookPublisher<LevelUpdateRing> out(books, *ring);
+
+    ASSERT_TRUE(out.process(add(1, Side::BUY, 100, 10, 7)));
+    ASSERT_TRUE(out.process(add(2, Side::BUY, 100, 5)));
+    ASSERT_TRUE(out.process(cancel(1, 4)));
+    ASSERT_TRUE(out.process(modify(2, 99, 5)));
+
+    const auto updates = drain(*ring);
+    ASSERT_EQ(updates.size(), 5u);
+    EXPECT_EQ(updates[0].sequence, 7u);
+    EXPECT_EQ(updates[0].total_quantity, 10u);
+    EXPECT_EQ(updates[1].total_quantity, 15u);
+    EXPECT_EQ(updates[1].order_count, 2u);
+    EXPECT_EQ(updates[2].total_quantity, 11u);
+    EXPECT_EQ(updates[3].price, 100u);           // Modify: old level shrinks
+    EXPECT_EQ(updates[3].total_quantity, 6u);
+    EXPECT_EQ(updates[4].price, 99u);            // ... and the new one appears
+    EXPECT_EQ(updates[4].total_quantity, 5u);
+    EXPECT_EQ(updates[4].symbol, 1u);
+    EXPECT_EQ(out.published_updates(), 5u);
+
+    ASSERT_TRUE(out.process(cancel(1)));
+    const auto removed = drain(*ring);
+    ASSERT_EQ(removed.size(), 1u);
+    EXPECT_EQ(removed[0].total_quantity, 0u);    // Level gone
+}
+
+TEST_F(BookPublisherTest, UnknownOrderPublishesNothing) {
+    BookPublisher<LevelUpdateRing> out(books, *ring);
+    EXPECT_FALSE(out.process(cancel(42)));
+    EXPECT_TRUE(drain(*ring).empty());
+}
+
+TEST_F(BookPublisherTest, ConflationKeepsLastStatePerLevel) {
+    BookPublisher<LevelUpdateRing> out(books, *ring, true);
+
+    out.process(add(1, Side::BUY, 100, 10));
+    out.process(add(2, Side::BUY, 100, 5));
+    out.process(add(3, Side::SELL, 105, 3));
+    out.process(cancel(1));
+    EXPECT_TRUE(drain(*ring).empty());           // Held until flush
+
+    out.flush();
+    const auto updates = drain(*ring);
+    ASSERT_EQ(updates.size(), 2u);
+    EXPECT_EQ(updates[0].price, 100u);
+    EXPECT_EQ(updates[0].total_quantity, 5u);
+    EXPECT_EQ(updates[1].price, 105u);
+    EXPECT_EQ(out.conflated_updates(), 2u);
+
+    out.flush();
+    EXPECT_TRUE(drain(*ring).empty());
+}
+
+TEST_F(BookPublisherTest, ConflationFlushesWhenBatchIsFull) {
+    BookPublisher<LevelUpdateRing> out(books, *ring, true);
+    const size_t n = BookPublisher<LevelUpdateRing>::MAX_PENDING + 1;
+    for (size_t i = 0; i < n; ++i) {
+        out.process(add(i + 1, Side::BUY, static_cast<Price>(100 + i), 1));
+    }
+    EXPECT_EQ(drain(*ring).size(), n - 1);
+    out.flush();
+    EXPECT_EQ(drain(*ring).size(), 1u);
+}
+
+TEST_F(BookPublisherTest, TopOfBookSnapshot) {
+    BookPublisher<LevelUpdateRing> out(books, *ring);
+    const Seqlock<TopOfBook>& tob = out.top_of_book(1);
+    EXPECT_EQ(tob.load().bid_price, OrderBook::NO_BID);
+
+    out.process(add(1, Side::BUY, 100, 10, 3));
+    out.process(add(2, Side::SELL, 102, 4, 4));
+    TopOfBook top = tob.load();
+    EXPECT_EQ(top.bid_price, 100u);
+    EXPECT_EQ(top.bid_quantity, 10u);
+    EXPECT_EQ(top.ask_price, 102u);
+    EXPECT_EQ(top.ask_quantity, 4u);
+    EXPECT_EQ(top.sequence, 4u);
+
+    // A change behind the touch leaves the snapshot alone
+    const uint64_t version = tob.version();
+    out.process(add(3, Side::BUY, 90, 1));
+    EXPECT_EQ(tob.version(), version);
+
+    out.process(cancel(1));
+    top = tob.load();
+    EXPECT_EQ(top.bid_price, 90u);
+    EXPECT_EQ(top.bid_quantity, 1u);
+}
+
+TEST_F(BookPublisherTest, ConflatedTopOfBookPublishesAtFlush) {
+    BookPublisher<LevelUpdateRing> out(books, *ring, true);
+    const Seqlock<TopOfBook>& tob = out.top_of_book(1);
+    const uint64_t version = tob.version();
+
+    out.process(add(1, Side::BUY, 100, 10, 1));
+    out.process(add(2, Side::BUY, 101, 10, 2));
+    EXPECT_EQ(tob.version(), version);
+    out.flush();
+    EXPECT_EQ(tob.version(), version + 2);
+    EXPECT_EQ(tob.load().bid_price, 101u);
+    EXPECT_EQ(tob.load().sequence, 2u);
+}
+
+TEST_F(BookPublisherTest, FullRingDropsAndCounts) {
+    using TinyRing = SPSCRing<LevelUpdate, 2, SingleWriterRingStats>;
+    TinyRing tiny;
+    BookPublisher<TinyRing> out(books, tiny);
+    for (OrderId id = 1; id <= 4; ++id) {
+        out.process(add(id, Side::SELL, static_cast<Price>(200 + id), 1));
+    }
+    EXPECT_GT(out.dropped_updates(), 0u);
+    EXPECT_EQ(out.published_updates() + out.dropped_updates(), 4u);
+    EXPECT_EQ(out.top_of_book(1).load().ask_price, 201u);
+}
+
+TEST_F(BookPublisherTest, BroadcastsToEveryConsumer) {
+    auto fanout = std::make_unique<BroadcastRing<LevelUpdate, 64, 2>>();
+    BookPublisher<BroadcastRing<LevelUpdate, 64, 2>> out(books, *fanout);
+    out.process(add(1, Side::BUY, 100, 10));
+    for (size_t c = 0; c < 2; ++c) {
+        LevelUpdate u;
+        ASSERT_TRUE(fanout->try_pop(c, u));
+        EXPECT_EQ(u.total_quantity, 10u);
+    }
+}
@@ -0,0 +1,205 @@
+#include "BookRegistry.h"
+#include "FlowGenerator.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// Full tick range at test-sized order capacity
+using Equities = BookSpec<Price, Quantity, uint32_t, 1, 65'536, 4'096, 1'024, 2'048>;
+using Futures = CompactBookSpec<1'024, 1'000>;
+
+// What ItchParser leaves in id-keyed messages for unmapped locates
+constexpr SymbolId NO_SYMBOL = UINT16_MAX;
+
+struct MissingTypes {
+    static constexpr size_t MAX_ORDERS = 10;
+};
+
+struct SignedPrices {
+    using price_type = int32_t;
+    using quantity_type = uint32_t;
+    using handle_type = uint32_t;
+    static constexpr price_type MIN_PRICE = 1;
+    static constexpr price_type MAX_PRICE = 100;
+    static constexpr size_t PRICE_LEVELS = 100;
+    static constexpr size_t MAX_ORDERS = 10;
+    static constexpr size_t WINDOW_SIZE = 64;
+    static constexpr size_t OVERFLOW_SLOTS = 16;
+    static constexpr handle_type INVALID_HANDLE = UINT32_MAX;
+};
+
+// Same shape as a BookSpec, but a range the occupancy bitmap cannot cover
+template<size_t Levels>
+struct RangeSpec {
+    using price_type = uint32_t;
+    using quantity_type = uint32_t;
+    using handle_type = uint32_t;
+    static constexpr price_type MIN_PRICE = 1;
+    static constexpr price_type MAX_PRICE = Levels;
+    static constexpr size_t PRICE_LEVELS = Levels;
+    static constexpr size_t MAX_ORDERS = 10;
+    static constexpr size_t WINDOW_SIZE = 64;
+    static constexpr size_t OVERFLOW_SLOTS = 16;
+    static constexpr handle_type INVALID_HANDLE = UINT32_MAX;
+    static constexpr OrderLayout ORDER_LAYOUT = OrderLayout::INTERLEAVED;
+};
+
+static_assert(BookSpecification<DefaultBookSpec>);
+static_assert(BookSpecification<RangeSpec<MAX_BOOK_PRICE_LEVELS>>);
+static_assert(!BookSpecification<RangeSpec<MAX_BOOK_PRICE_LEVELS + 64>>);   // Too wide
+static_assert(!BookSpecification<RangeSpec<1'000>>);                          // Not whole words
+static_assert(BookSpecification<Futures>);
+static_assert(!BookSpecification<MissingTypes>);
+static_assert(!BookSpecification<SignedPrices>);
+
+// Narrow specs shrink the level array and the links, not the order slot
+static_assert(sizeof(BasicLevelWindow<Futures>::Level) == 12);
+static_assert(sizeof(BasicOrder<Futures>) == sizeof(Order));
+static_assert(std::is_same_v<OrderBook::Level, PriceLevel>);
+
+Message add(SymbolId symbol, OrderId id, Side side, Price price, Quantity qty) {
+    Message msg{};
+    msg.type = MessageType::ADD_ORDER;
+    msg.symbol = symbol;
+    msg.order_id = id;
+    msg.side = side;
+    msg.price = price;
+    msg.quantity = qty;
+    return msg;
+}
+
+Message cancel(SymbolId symbol, OrderId id) {
+    Message msg{};
+    msg.type = MessageType::CANCEL_ORDER;
+    msg.symbol = symbol;
+    msg.order_id = id;
+    return msg;
+}
+
+}  // namespace
+
+TEST(CompactBookTest, RejectsPricesOutsideItsRangeBeforeNarrowing) {
+    BasicOrderPool<Futures> pool(64);
+    BasicOrderBook<Futures> book(7, pool);
+
+    // 65'537 would wrap to 1 in a 16-bit price
+    EXPECT_EQ(book.add_order(1, Side::BUY, 65'537, 10), book.INVALID_HANDLE);
+    EXPECT_EQ(book.add_order(2, Side::BUY, 1'025, 10), book.INVALID_HANDLE);
+    EXPECT_EQ(book.rejected_orders(), 2u);
+
+    const auto h = book.add_order(3, Side::BUY, 1'024, 10);
+    ASSERT_NE(h, book.INVALID_HANDLE);
+    EXPECT_EQ(book.best_bid(), 1'024u);
+    EXPECT_FALSE(book.modify_order(h, 70'000, 10));
+    EXPECT_EQ(book.best_bid(), 1'024u);
+}
+
+TEST(CompactBookTest, WholeRangeWindowNeverOverflowsOrRecenters) {
+    BasicOrderPool<Futures> pool(1'000);
+    BasicOrderBook<Futures> book(0, pool);
+
+    for (Price p = 1; p <= 1'024; p += 3) {
+        ASSERT_NE(book.add_order(p, p < 512 ? Side::BUY : Side::SELL, p, 1), book.INVALID_HANDLE);
+    }
+    EXPECT_EQ(book.bid_levels().overflow_size(), 0u);
+    EXPECT_EQ(book.ask_levels().overflow_size(), 0u);
+    EXPECT_EQ(book.bid_levels().recenters() + book.ask_levels().recenters(), 0u);
+    EXPECT_EQ(book.best_bid(), 511u);
+    EXPECT_EQ(book.best_ask(), 514u);
+}
+
+TEST(CompactBookTest, PoolCapacityIsBoundedByTheHandleWidth) {
+    BasicOrderPool<Futures> pool(1'000'000);
+    EXPECT_EQ(pool.capacity(), Futures::MAX_ORDERS);
+}
+
+TEST(BookRegistryTest, RoutesEachSymbolToItsSpec) {
+    BookRegistry<Equities, Futures> books;
+    ASSERT_TRUE(books.add_symbol<Equities>(1));
+    ASSERT_TRUE(books.add_symbol<Futures>(2));
+    EXPECT_TRUE(books.add_symbol<Futures>(2));         // Idempotent
+    EXPECT_FALSE(books.add_symbol<Equities>(2));       // Already a futures book
+    EXPECT_FALSE(books.add_symbol<Futures>(Config::MAX_SYMBOLS));
+
+    EXPECT_EQ(books.spec_of(1), books.spec_index<Equities>());
+    EXPECT_EQ(books.spec_of(2), books.spec_index<Futures>());
+    EXPECT_EQ(books.spec_of(3), books.UNASSIGNED);
+
+    EXPECT_TRUE(books.process(add(1, 100, Side::BUY, 30'000, 10)));
+    EXPECT_TRUE(books.process(add(2, 200, Side::SELL, 900, 5)));
+    EXPECT_FALSE(books.process(add(2, 201, Side::SELL, 30'000, 5)));   // Beyond the futures range
+    EXPECT_FALSE(books.process(add(3, 300, Side::BUY, 100, 1)));       // No book
+
+    EXPECT_EQ(books.manager<Equities>().book(1)->best_bid(), 30'000u);
+    EXPECT_EQ(books.manager<Futures>().book(2)->best_ask(), 900u);
+    EXPECT_EQ(books.manager<Futures>().order_count(), 1u);
+    EXPECT_EQ(books.order_count(), 2u);
+    EXPECT_EQ(books.unroutable_messages(), 1u);
+}
+
+TEST(BookRegistryTest, VisitSeesTheSpecificManagerType) {
+    BookRegistry<Equities, Futures> books;
+    ASSERT_TRUE(books.add_symbol<Futures>(5));
+    ASSERT_TRUE(books.process(add(5, 1, Side::BUY, 100, 10)));
+
+    size_t price_bytes = 0;
+    EXPECT_TRUE(books.visit(5, [&](auto& manager) {
+        using Book = typename std::remove_reference_t<decltype(manager)>::Book;
+        price_bytes = sizeof(typename Book::price_type);
+        return manager.book(5)->best_bid() == 100;
+    }));
+    EXPECT_EQ(price_bytes, sizeof(uint16_t));
+    EXPECT_FALSE(books.visit(6, [](auto&) { return true; }));
+}
+
+TEST(BookRegistryTest, IdKeyedMessagesWithoutSymbolFallBackToTheIndex) {
+    BookRegistry<Equities, Futures> books;
+    ASSERT_TRUE(books.add_symbol<Futures>(2));
+    ASSERT_TRUE(books.process(add(2, 42, Side::BUY, 100, 10)));
+
+    EXPECT_TRUE(books.process(cancel(NO_SYMBOL, 42)));
+    EXPECT_EQ(books.order_count(), 0u);
+    EXPECT_FALSE(books.process(cancel(NO_SYMBOL, 42)));
+    EXPECT_EQ(books.unroutable_messages(), 1u);
+}
+
+TEST(BookRegistryTest, IdKeyedMessagesFollowTheIdNotAStaleSymbol) {
+    BookRegistry<Equities, Futures> books;
+    ASSERT_TRUE(books.add_symbol<Equities>(0));
+    ASSERT_TRUE(books.add_symbol<Futures>(2));
+    ASSERT_TRUE(books.process(add(0, 7, Side::SELL, 30'000, 5)));
+    ASSERT_TRUE(books.process(add(2, 42, Side::BUY, 100, 10)));
+
+    Message unset{};                                   // Symbol left at 0, an equities book
+    unset.type = MessageType::CANCEL_ORDER;
+    unset.order_id = 42;
+    EXPECT_TRUE(books.process(unset));
+    EXPECT_EQ(books.manager<Futures>().order_count(), 0u);
+    EXPECT_EQ(books.manager<Equities>().order_count(), 1u);
+    EXPECT_EQ(books.unroutable_messages(), 0u);
+}
+
+TEST(BookRegistryTest, MixedUniverseAppliesASyntheticSession) {
+    BookRegistry<Equities, Futures> books;
+    FlowConfig config;
+    config.seed = 21;
+    config.symbols = 4;
+    config.initial_mid = 500;
+    config.depth = 40;
+    config.max_live_orders = 900;       // Within the futures pool even if one symbol takes all
+    config.min_live_orders = 100;
+    FlowGenerator flow(config);
+
+    for (SymbolId s = 0; s < 4; ++s) {
+        ASSERT_TRUE(s % 2 == 0 ? books.add_symbol<Equities>(s) : books.add_symbol<Futures>(s));
+    }
+
+    std::vector<Message> session(50'000);
+    flow.generate(session);
+    for (const Message& msg : session) {
+        ASSERT_TRUE(books.process(msg));
+    }
+    EXPECT_EQ(books.order_count(), flow.live_orders());
+    EXPECT_EQ(books.unroutable_messages(), 0u);
+}
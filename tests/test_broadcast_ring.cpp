@@ -0,0 +1,86 @@
+#include "BroadcastRing.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include <vector>
+
+TEST(BroadcastRingTest, EveryConsumerSeesEveryItem) {
+    BroadcastRing<int, 8, 2> ring;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(ring.try_publish(i));
+    }
+
+    for (size_t c = 0; c < 2; ++c) {
+        std::vector<int> seen;
+        EXPECT_EQ(ring.consume_all(c, [&](const int& v) { seen.push_back(v); }), 5u);
+        EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3, 4}));
+        EXPECT_EQ(ring.lag(c), 0u);
+    }
+}
+
+TEST(BroadcastRingTest, ProducerGatedBySlowestConsumer) {
+    BroadcastRing<int, 4, 2> ring;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_publish(i));
+    }
+    EXPECT_FALSE(ring.try_publish(4));
+
+    // Fast consumer drains everything; the slow one still holds the ring
+    int value;
+    while (ring.try_pop(0, value)) {}
+    EXPECT_FALSE(ring.try_publish(4));
+    EXPECT_EQ(ring.failed_pushes(), 2u);
+
+    ASSERT_TRUE(ring.try_pop(1, value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_publish(4));
+    EXPECT_EQ(ring.lag(0), 1u);
+    EXPECT_EQ(ring.lag(1), 4u);
+}
+
+TEST(BroadcastRingTest, ReserveCommitPublishesInPlace) {
+    BroadcastRing<int, 4, 1, SingleWriterRingStats> ring;
+    int* slot = ring.reserve();
+    ASSERT_NE(slot, nullptr);
+    *slot = 42;
+    int value = 0;
+    EXPECT_FALSE(ring.try_pop(0, value));
+
+    ring.commit();
+    ASSERT_TRUE(ring.try_pop(0, value));
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(ring.total_pushes(), 1u);
+}
+
+TEST(BroadcastRingTest, ConcurrentConsumersReceiveFullStream) {
+    constexpr uint64_t N = 30000;
+    constexpr size_t CONSUMERS = 3;
+    BroadcastRing<uint64_t, 128, CONSUMERS> ring;
+
+    std::array<bool, CONSUMERS> ok{};
+    std::vector<std::thread> consumers;
+    for (size_t c = 0; c < CONSUMERS; ++c) {
+        consumers.emplace_back([&, c] {
+            uint64_t expected = 0;
+            bool in_order = true;
+            while (expected < N) {
+                if (ring.consume_all(c, [&](const uint64_t& v) { in_order &= (v == expected++); }) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            ok[c] = in_order;
+        });
+    }
+
+    for (uint64_t i = 0; i < N; ++i) {
+        while (!ring.try_publish(i)) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : consumers) t.join();
+
+    for (size_t c = 0; c < CONSUMERS; ++c) {
+        EXPECT_TRUE(ok[c]) << "consumer " << c;
+        EXPECT_EQ(ring.consumed(c), N);
+    }
+}
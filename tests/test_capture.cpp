@@ -0,0 +1,137 @@
+#include "Capture.h"
+#include "BookManager.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+Message add(uint64_t seq, OrderId id, Price price, Timestamp ts = 0) {
+    Message msg{};
+    msg.type = MessageType::ADD_ORDER;
+    msg.timestamp = ts;
+    msg.sequence = seq;
+    msg.symbol = 1;
+    msg.order_id = id;
+    msg.side = Side::BUY;
+    msg.price = price;
+    msg.quantity = 10;
+    return msg;
+}
+
+class CaptureTest : public ::testing::Test {
+protected:
+    std::string path = "/tmp/hft_capture_test_" + std::to_string(getpid()) + ".cap";
+
+    void TearDown() override { unlink(path.c_str()); }
+};
+
+}  // namespace
+
+TEST_F(CaptureTest, RoundTripsRecordsThroughTheMapping) {
+    {
+        CaptureRecorder recorder;
+        ASSERT_TRUE(recorder.open(path.c_str()));
+        // More than one buffer's worth, so a mid-stream write happens
+        for (uint64_t i = 0; i < CaptureRecorder::BUFFER_RECORDS + 10; ++i) {
+            ASSERT_TRUE(recorder.record(add(i, i + 1, 100 + (i % 50), i * 1000)));
+        }
+        EXPECT_EQ(recorder.records(), CaptureRecorder::BUFFER_RECORDS + 10);
+    }
+
+    CaptureReplayer replay;
+    ASSERT_TRUE(replay.open(path.c_str()));
+    ASSERT_EQ(replay.size(), CaptureRecorder::BUFFER_RECORDS + 10);
+    EXPECT_EQ(replay.header()->record_size, sizeof(Message));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(replay.messages().data()) % CACHE_LINE_SIZE, 0u);
+    EXPECT_EQ(replay.messages()[7].timestamp, 7000u);
+    EXPECT_EQ(replay.messages().back().sequence, CaptureRecorder::BUFFER_RECORDS + 9);
+
+    BookManager books(4096);
+    books.add_symbol(1);
+    EXPECT_EQ(replay.replay([&](const Message& msg) { books.process(msg); }), replay.size());
+    EXPECT_EQ(books.order_count(), replay.size());
+}
+
+TEST_F(CaptureTest, ReopenAppendsAndDropsTornTail) {
+    {
+        CaptureRecorder recorder;
+        ASSERT_TRUE(recorder.open(path.c_str()));
+        recorder.record(add(1, 1, 100));
+    }
+    // Simulate a crash mid-record
+    {
+        FILE* f = fopen(path.c_str(), "ab");
+        ASSERT_NE(f, nullptr);
+        fwrite("torn", 1, 4, f);
+        fclose(f);
+    }
+    {
+        CaptureRecorder recorder;
+        ASSERT_TRUE(recorder.open(path.c_str()));
+        EXPECT_EQ(recorder.records(), 1u);
+        recorder.record(add(2, 2, 101));
+    }
+
+    CaptureReplayer replay;
+    ASSERT_TRUE(replay.open(path.c_str()));
+    ASSERT_EQ(replay.size(), 2u);
+    EXPECT_EQ(replay.messages()[1].sequence, 2u);
+
+    CaptureRecorder fresh;
+    ASSERT_TRUE(fresh.open(path.c_str(), true));
+    EXPECT_EQ(fresh.records(), 0u);
+}
+
+TEST_F(CaptureTest, RejectsForeignFiles) {
+    FILE* f = fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    const std::vector<char> junk(256, 'x');
+    fwrite(junk.data(), 1, junk.size(), f);
+    fclose(f);
+
+    CaptureReplayer replay;
+    EXPECT_FALSE(replay.open(path.c_str()));
+    EXPECT_FALSE(replay.open("/nonexistent/capture.cap"));
+    EXPECT_EQ(replay.size(), 0u);
+}
+
+TEST_F(CaptureTest, DrainsARing) {
+    auto ring = std::make_unique<SPSCRing<Message, 64>>();
+    for (uint64_t i = 0; i < 20; ++i) ring->try_emplace(add(i, i + 1, 100));
+
+    CaptureRecorder recorder;
+    ASSERT_TRUE(recorder.open(path.c_str()));
+    EXPECT_EQ(recorder.drain(*ring), 20u);
+    EXPECT_TRUE(ring->empty());
+    recorder.close();
+
+    CaptureReplayer replay;
+    ASSERT_TRUE(replay.open(path.c_str()));
+    EXPECT_EQ(replay.size(), 20u);
+}
+
+TEST_F(CaptureTest, PacedReplayHonoursTimestamps) {
+    {
+        CaptureRecorder recorder;
+        ASSERT_TRUE(recorder.open(path.c_str()));
+        recorder.record(add(1, 1, 100, 1'000'000'000));
+        recorder.record(add(2, 2, 100, 1'020'000'000));     // 20 ms later
+    }
+    CaptureReplayer replay;
+    ASSERT_TRUE(replay.open(path.c_str()));
+
+    const TSCTimer& timer = TSCTimer::instance();
+    std::vector<uint64_t> seen;
+    replay.replay_paced([&](const Message&) { seen.push_back(timer.now()); }, timer);
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_GE(timer.cycles_to_ns(seen[1] - seen[0]), 19e6);
+
+    // Ten times faster: about 2 ms
+    seen.clear();
+    replay.replay_paced([&](const Message&) { seen.push_back(timer.now()); }, timer, 10.0);
+    EXPECT_GE(timer.cycles_to_ns(seen[1] - seen[0]), 1.9e6);
+    EXPECT_LT(timer.cycles_to_ns(seen[1] - seen[0]), 19e6);
+}
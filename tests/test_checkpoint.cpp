@@ -0,0 +1,164 @@
+#include "Checkpoint.h"
+#include "FlowGenerator.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr size_t ORDERS = 1 << 16;
+
+class CheckpointTest : public ::testing::Test {
+protected:
+    std::string path = "/tmp/hft_checkpoint_test_" + std::to_string(getpid()) + ".ckp";
+
+    void TearDown() override { unlink(path.c_str()); }
+};
+
+// The same books: every resting order in the same place in its queue
+void expect_same_books(const BookManager& a, const BookManager& b, const std::vector<Message>& flow) {
+    ASSERT_EQ(a.order_count(), b.order_count());
+    for (size_t s = 0; s < Config::MAX_SYMBOLS; ++s) {
+        const OrderBook* x = a.book(static_cast<SymbolId>(s));
+        const OrderBook* y = b.book(static_cast<SymbolId>(s));
+        ASSERT_EQ(x == nullptr, y == nullptr);
+        if (x == nullptr) continue;
+        EXPECT_EQ(x->best_bid(), y->best_bid());
+        EXPECT_EQ(x->best_ask(), y->best_ask());
+        EXPECT_EQ(x->order_count(), y->order_count());
+    }
+    for (const Message& msg : flow) {
+        const auto h = a.find_order(msg.order_id);
+        if (h == BookManager::INVALID_HANDLE) {
+            EXPECT_EQ(b.find_order(msg.order_id), BookManager::INVALID_HANDLE);
+            continue;
+        }
+        const auto g = b.find_order(msg.order_id);
+        ASSERT_NE(g, BookManager::INVALID_HANDLE);
+        const Order x = a.pool()[h];
+        const Order y = b.pool()[g];
+        EXPECT_EQ(x.price, y.price);
+        EXPECT_EQ(x.quantity, y.quantity);
+        EXPECT_EQ(x.side, y.side);
+        EXPECT_EQ(a.book(x.symbol)->quantity_ahead(h), b.book(y.symbol)->quantity_ahead(g));
+    }
+}
+
+std::vector<Message> session(size_t count, uint64_t seed = 5) {
+    FlowConfig config;
+    config.seed = seed;
+    config.symbols = 8;
+    config.max_live_orders = 4096;
+    FlowGenerator flow(config);
+    std::vector<Message> out(count);
+    flow.generate(out);
+    return out;
+}
+
+}  // namespace
+
+TEST_F(CheckpointTest, RestoreRebuildsBooksAndQueuePriority) {
+    const auto flow = session(50'000);
+    BookManager books(ORDERS);
+    for (SymbolId s = 0; s < 8; ++s) books.add_symbol(s);
+    books.add_symbol(500);                          // Registered, never traded
+    for (const Message& msg : flow) books.process(msg);
+
+    ASSERT_TRUE(write_checkpoint(books, flow.back().sequence, path.c_str()));
+    EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+
+    CheckpointLoader checkpoint;
+    ASSERT_TRUE(checkpoint.open(path.c_str()));
+    EXPECT_EQ(checkpoint.last_sequence(), flow.back().sequence);
+    EXPECT_EQ(checkpoint.orders().size(), books.order_count());
+    EXPECT_TRUE(checkpoint.has_symbol(500));
+    EXPECT_FALSE(checkpoint.has_symbol(9));
+
+    BookManager restored(ORDERS);
+    ASSERT_TRUE(checkpoint.restore(restored));
+    ASSERT_NE(restored.book(500), nullptr);
+    expect_same_books(books, restored, flow);
+}
+
+TEST_F(CheckpointTest, CheckpointPlusTailMatchesFullReplay) {
+    const auto flow = session(40'000, 9);
+    const size_t cut = 25'000;
+
+    BookManager full(ORDERS);
+    BookManager live(ORDERS);
+    for (SymbolId s = 0; s < 8; ++s) {
+        full.add_symbol(s);
+        live.add_symbol(s);
+    }
+    for (size_t i = 0; i < cut; ++i) live.process(flow[i]);
+    ASSERT_TRUE(write_checkpoint(live, flow[cut - 1].sequence, path.c_str()));
+    for (const Message& msg : flow) full.process(msg);
+
+    CheckpointLoader checkpoint;
+    ASSERT_TRUE(checkpoint.open(path.c_str()));
+    BookManager restarted(ORDERS);
+    ASSERT_TRUE(checkpoint.restore(restarted));
+    const auto tail = CheckpointLoader::tail(flow, checkpoint.last_sequence());
+    ASSERT_EQ(tail.size(), flow.size() - cut);
+    for (const Message& msg : tail) restarted.process(msg);
+
+    expect_same_books(full, restarted, flow);
+}
+
+TEST_F(CheckpointTest, RejectsForeignAndTruncatedFiles) {
+    CheckpointLoader checkpoint;
+    EXPECT_FALSE(checkpoint.open("/tmp/hft_checkpoint_absent.ckp"));
+
+    { std::ofstream(path) << "not a checkpoint"; }
+    EXPECT_FALSE(checkpoint.open(path.c_str()));
+
+    BookManager books(1024);
+    books.add_symbol(1);
+    for (OrderId id = 1; id <= 10; ++id) books.add_order(1, id, Side::BUY, 100, 10);
+    ASSERT_TRUE(write_checkpoint(books, 10, path.c_str()));
+    ASSERT_TRUE(checkpoint.open(path.c_str()));
+    checkpoint.close();
+
+    ASSERT_EQ(truncate(path.c_str(), static_cast<off_t>(sizeof(CheckpointHeader) + CHECKPOINT_SYMBOL_BYTES +
+                                                       9 * sizeof(CheckpointOrder))), 0);
+    EXPECT_FALSE(checkpoint.open(path.c_str()));
+}
+
+TEST_F(CheckpointTest, ForkedCheckpointCapturesStateAtBegin) {
+    BookManager books(1024);
+    books.add_symbol(1);
+    for (OrderId id = 1; id <= 100; ++id) books.add_order(1, id, Side::SELL, 200 + id % 5, 10);
+
+    Checkpointer checkpoints;
+    ASSERT_TRUE(checkpoints.begin(books, 100, path.c_str()));
+    EXPECT_TRUE(checkpoints.in_progress());
+
+    // The book keeps trading while the child writes its image
+    for (OrderId id = 1; id <= 50; ++id) books.cancel_order(id);
+    for (OrderId id = 101; id <= 120; ++id) books.add_order(1, id, Side::BUY, 150, 10);
+
+    ASSERT_TRUE(checkpoints.wait());
+    EXPECT_FALSE(checkpoints.in_progress());
+    EXPECT_EQ(checkpoints.completed(), 1u);
+    EXPECT_EQ(checkpoints.last_sequence(), 100u);
+    EXPECT_FALSE(checkpoints.poll());
+
+    CheckpointLoader checkpoint;
+    ASSERT_TRUE(checkpoint.open(path.c_str()));
+    BookManager restored(1024);
+    ASSERT_TRUE(checkpoint.restore(restored));
+    EXPECT_EQ(restored.order_count(), 100u);
+    EXPECT_FALSE(restored.book(1)->has_bid());
+    EXPECT_EQ(restored.book(1)->best_ask(), 200u);
+}
+
+TEST_F(CheckpointTest, FailedChildIsCounted) {
+    BookManager books(16);
+    Checkpointer checkpoints;
+    ASSERT_TRUE(checkpoints.begin(books, 1, "/nonexistent-dir/books.ckp"));
+    EXPECT_FALSE(checkpoints.wait());
+    EXPECT_EQ(checkpoints.failed(), 1u);
+    EXPECT_EQ(checkpoints.completed(), 0u);
+}
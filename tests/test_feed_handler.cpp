@@ -0,0 +1,218 @@
+#include "FeedHandler.h"
+#include "ItchParser.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Records the sequence each message was delivered under
+struct SequenceProbe {
+    uint64_t next = 0;
+    std::vector<uint64_t> seen;
+
+    void set_sequence(uint64_t sequence) noexcept { next = sequence; }
+    bool parse_message(const uint8_t*, size_t) {
+        seen.push_back(next);
+        return true;
+    }
+};
+
+// MoldUDP64 packet of count messages starting at sequence; each body is
+// an ITCH system event padded to body_size bytes
+std::vector<uint8_t> packet(uint64_t sequence, uint16_t count, uint16_t body_size = 1) {
+    std::vector<uint8_t> out(mold::HEADER_SIZE, ' ');
+    const uint64_t be_seq = __builtin_bswap64(sequence);
+    const uint16_t be_count = __builtin_bswap16(count);
+    std::memcpy(out.data() + mold::SEQUENCE_OFFSET, &be_seq, sizeof(be_seq));
+    std::memcpy(out.data() + mold::COUNT_OFFSET, &be_count, sizeof(be_count));
+    if (count == mold::END_OF_SESSION) return out;
+    for (uint16_t i = 0; i < count; ++i) {
+        out.push_back(static_cast<uint8_t>(body_size >> 8));
+        out.push_back(static_cast<uint8_t>(body_size));
+        out.push_back('S');
+        out.insert(out.end(), body_size - 1, 0);
+    }
+    return out;
+}
+
+using Arbiter = LineArbiter<SequenceProbe>;
+
+size_t feed(Arbiter& arbiter, uint8_t line, uint64_t sequence, uint16_t count) {
+    const auto p = packet(sequence, count);
+    return arbiter.on_packet(line, p.data(), p.size());
+}
+
+std::vector<uint64_t> range(uint64_t first, uint64_t last) {
+    std::vector<uint64_t> out;
+    for (uint64_t s = first; s <= last; ++s) out.push_back(s);
+    return out;
+}
+
+}  // namespace
+
+TEST(LineArbiterTest, DuplicatesFromTheSlowLineAreDropped) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe);
+
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_A, 1, 3), 3u);
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 1, 3), 0u);
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 4, 2), 2u);    // B ahead now
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_A, 4, 2), 0u);
+
+    EXPECT_EQ(probe.seen, range(1, 5));
+    EXPECT_EQ(arbiter.duplicate_packets(), 2u);
+    EXPECT_EQ(arbiter.first_arrivals(Arbiter::LINE_A), 1u);
+    EXPECT_EQ(arbiter.first_arrivals(Arbiter::LINE_B), 1u);
+    EXPECT_EQ(arbiter.next_sequence(), 6u);
+}
+
+TEST(LineArbiterTest, PartialOverlapDeliversOnlyNewMessages) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe, 256, 1);
+    feed(arbiter, Arbiter::LINE_A, 1, 3);
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 2, 4), 2u);
+    EXPECT_EQ(probe.seen, range(1, 5));
+}
+
+TEST(LineArbiterTest, GapOnOneLineIsFilledByTheOther) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe, 256, 1);
+
+    feed(arbiter, Arbiter::LINE_A, 1, 2);
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_A, 5, 2), 0u);    // 3..4 lost on A
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_A, 7, 1), 0u);
+    EXPECT_TRUE(arbiter.in_gap());
+
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 3, 2), 5u);    // Fills it, stash drains
+    EXPECT_FALSE(arbiter.in_gap());
+    EXPECT_EQ(probe.seen, range(1, 7));
+    EXPECT_EQ(arbiter.gaps(), 1u);
+    EXPECT_EQ(arbiter.recovered_gaps(), 1u);
+    EXPECT_EQ(arbiter.lost_messages(), 0u);
+
+    // B's late copies of the stashed packets are duplicates
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 5, 3), 0u);
+}
+
+TEST(LineArbiterTest, PersistentGapIsDeclaredLost) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe, 3, 1);
+
+    feed(arbiter, Arbiter::LINE_A, 1, 1);
+    feed(arbiter, Arbiter::LINE_A, 4, 1);
+    feed(arbiter, Arbiter::LINE_A, 5, 1);
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_A, 6, 1), 3u);    // Timeout: skip 2..3
+
+    EXPECT_EQ(probe.seen, (std::vector<uint64_t>{1, 4, 5, 6}));
+    EXPECT_EQ(arbiter.lost_messages(), 2u);
+    EXPECT_EQ(arbiter.recovered_gaps(), 0u);
+    EXPECT_FALSE(arbiter.in_gap());
+
+    // The lost messages arriving late are no longer wanted
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 2, 2), 0u);
+}
+
+TEST(LineArbiterTest, FullStashForcesTheSkip) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe, 1'000'000, 1);
+    for (uint64_t s = 10; s < 10 + Arbiter::STASH_SLOTS + 1; ++s) {
+        feed(arbiter, Arbiter::LINE_A, s, 1);
+    }
+    EXPECT_EQ(arbiter.lost_messages(), 9u);
+    EXPECT_EQ(probe.seen, range(10, 10 + Arbiter::STASH_SLOTS));
+}
+
+TEST(LineArbiterTest, FullStashDeliversAPacketInsideTheGap) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe, 1'000'000, 1);
+    for (uint64_t s = 100; s < 100 + Arbiter::STASH_SLOTS; ++s) {
+        feed(arbiter, Arbiter::LINE_A, s, 1);
+    }
+
+    // Line B brings 50, between the stream and everything stashed: only
+    // 1..49 are lost, 50 is delivered, and 51..99 can still be filled
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 50, 1), 1u);
+    EXPECT_EQ(probe.seen, (std::vector<uint64_t>{50}));
+    EXPECT_EQ(arbiter.lost_messages(), 49u);
+    EXPECT_EQ(arbiter.duplicate_packets(), 0u);
+    EXPECT_EQ(arbiter.next_sequence(), 51u);
+    EXPECT_TRUE(arbiter.in_gap());
+
+    EXPECT_EQ(feed(arbiter, Arbiter::LINE_B, 51, 49), 49u + Arbiter::STASH_SLOTS);
+    EXPECT_EQ(probe.seen, range(50, 100 + Arbiter::STASH_SLOTS - 1));
+    EXPECT_EQ(arbiter.lost_messages(), 49u);
+    EXPECT_FALSE(arbiter.in_gap());
+}
+
+TEST(LineArbiterTest, HeartbeatRevealsTrailingLossAndSessionEnd) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe, 2, 1);
+    feed(arbiter, Arbiter::LINE_A, 1, 1);
+    feed(arbiter, Arbiter::LINE_A, 4, 0);       // Heartbeat: next to send is 4
+    EXPECT_TRUE(arbiter.in_gap());
+    feed(arbiter, Arbiter::LINE_B, 4, 0);
+    EXPECT_EQ(arbiter.lost_messages(), 2u);
+    EXPECT_EQ(arbiter.next_sequence(), 4u);
+
+    feed(arbiter, Arbiter::LINE_A, 4, mold::END_OF_SESSION);
+    EXPECT_TRUE(arbiter.session_ended());
+}
+
+TEST(LineArbiterTest, RejectsShortPackets) {
+    SequenceProbe probe;
+    Arbiter arbiter(probe);
+    const uint8_t junk[8] = {};
+    EXPECT_EQ(arbiter.on_packet(Arbiter::LINE_A, junk, sizeof(junk)), 0u);
+    EXPECT_EQ(arbiter.malformed_packets(), 1u);
+}
+
+TEST(UdpReceiverTest, ReceivesABatchAndFeedsTheRing) {
+    UdpReceiver line_a, line_b;
+    ASSERT_TRUE(line_a.open("127.0.0.1", 0));
+    ASSERT_TRUE(line_b.open("127.0.0.1", 0));
+
+    const int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(tx, 0);
+    auto send_to = [&](uint16_t port, const std::vector<uint8_t>& p) {
+        sockaddr_in to{};
+        to.sin_family = AF_INET;
+        to.sin_port = htons(port);
+        to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        sendto(tx, p.data(), p.size(), 0, reinterpret_cast<sockaddr*>(&to), sizeof(to));
+    };
+    // Same three packets on both lines; B also carries a packet A dropped
+    send_to(line_a.port(), packet(1, 2, itch::SYSTEM_EVENT_SIZE));
+    send_to(line_a.port(), packet(5, 1, itch::SYSTEM_EVENT_SIZE));
+    send_to(line_b.port(), packet(1, 2, itch::SYSTEM_EVENT_SIZE));
+    send_to(line_b.port(), packet(3, 2, itch::SYSTEM_EVENT_SIZE));
+    send_to(line_b.port(), packet(5, 1, itch::SYSTEM_EVENT_SIZE));
+    close(tx);
+
+    auto ring = std::make_unique<SPSCRing<Message, 64>>();
+    ItchRingSink<SPSCRing<Message, 64>> sink{*ring};
+    ItchParser<ItchRingSink<SPSCRing<Message, 64>>> parser(sink);
+    FeedHandler<decltype(parser)> handler(parser, line_a, line_b);
+
+    size_t delivered = 0;
+    for (int spin = 0; spin < 1000 && delivered < 5; ++spin) {
+        delivered += handler.poll();
+        if (delivered < 5) usleep(100);
+    }
+    EXPECT_EQ(delivered, 5u);
+    EXPECT_EQ(line_a.datagrams() + line_b.datagrams(), 5u);
+    EXPECT_EQ(handler.arbiter().lost_messages(), 0u);
+
+    // Decoded in place into the ring, in feed order with feed sequences
+    Message msg;
+    for (uint64_t sequence = 1; sequence <= 5; ++sequence) {
+        ASSERT_TRUE(ring->try_pop(msg));
+        EXPECT_EQ(msg.type, MessageType::HEARTBEAT);
+        EXPECT_EQ(msg.sequence, sequence);
+    }
+    EXPECT_FALSE(ring->try_pop(msg));
+}
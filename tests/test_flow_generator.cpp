@@ -0,0 +1,210 @@
+#include "FlowGenerator.h"
+#include "BookManager.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace {
+
+FlowConfig small_config(uint64_t seed) {
+    FlowConfig config;
+    config.seed = seed;
+    config.symbols = 8;
+    config.max_live_orders = 4'000;
+    config.min_live_orders = 500;
+    return config;
+}
+
+std::vector<Message> take(FlowGenerator& flow, size_t count) {
+    std::vector<Message> out(count);
+    flow.generate(out);
+    return out;
+}
+
+bool same(const Message& a, const Message& b) {
+    return a.type == b.type && a.timestamp == b.timestamp && a.sequence == b.sequence &&
+           a.symbol == b.symbol && a.order_id == b.order_id && a.new_order_id == b.new_order_id &&
+           a.price == b.price && a.quantity == b.quantity && a.side == b.side;
+}
+
+}  // namespace
+
+TEST(BatchRngTest, SameSeedSameSequence) {
+    BatchRng a(42), b(42), c(43);
+    bool differs = false;
+    for (size_t i = 0; i < 3 * BatchRng::BUFFER; ++i) {
+        const uint64_t x = a.next();
+        ASSERT_EQ(x, b.next());
+        differs |= x != c.next();
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(BatchRngTest, BelowStaysInRangeAndCoversIt) {
+    BatchRng rng(7);
+    std::array<uint32_t, 10> hits{};
+    for (int i = 0; i < 100'000; ++i) {
+        const uint32_t v = rng.below(10);
+        ASSERT_LT(v, 10u);
+        ++hits[v];
+    }
+    for (uint32_t h : hits) {
+        EXPECT_NEAR(h, 10'000, 600);
+    }
+}
+
+TEST(FlowGeneratorTest, IsDeterministicPerSeed) {
+    FlowGenerator a(small_config(5)), b(small_config(5)), c(small_config(6));
+    const auto xs = take(a, 20'000);
+    const auto ys = take(b, 20'000);
+    const auto zs = take(c, 20'000);
+
+    size_t differing = 0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        ASSERT_TRUE(same(xs[i], ys[i])) << "message " << i;
+        differing += !same(xs[i], zs[i]);
+    }
+    EXPECT_GT(differing, xs.size() / 2);
+}
+
+TEST(FlowGeneratorTest, EveryMessageAppliesToABook) {
+    FlowConfig config = small_config(11);
+    FlowGenerator flow(config);
+    auto books = std::make_unique<BookManager>(config.max_live_orders * 2);
+    for (SymbolId s = 0; s < config.symbols; ++s) books->add_symbol(s);
+
+    Message msg;
+    uint64_t last_sequence = 0;
+    Timestamp last_time = 0;
+    for (int i = 0; i < 200'000; ++i) {
+        flow.next(msg);
+        ASSERT_LT(msg.symbol, config.symbols);
+        ASSERT_GE(msg.price, Config::MIN_PRICE);
+        ASSERT_LE(msg.price, Config::MAX_PRICE);
+        ASSERT_EQ(msg.sequence, last_sequence + 1);
+        ASSERT_GE(msg.timestamp, last_time);
+        last_sequence = msg.sequence;
+        last_time = msg.timestamp;
+        ASSERT_TRUE(books->process(msg)) << "message " << i;
+    }
+    EXPECT_EQ(books->unknown_orders(), 0u);
+    EXPECT_EQ(books->rejected_orders(), 0u);
+    EXPECT_EQ(books->order_count(), flow.live_orders());
+
+    // Draining leaves every book empty
+    while (flow.drain(msg)) {
+        ASSERT_TRUE(books->process(msg));
+    }
+    EXPECT_EQ(flow.live_orders(), 0u);
+    EXPECT_EQ(books->order_count(), 0u);
+}
+
+TEST(FlowGeneratorTest, EventMixFollowsTheWeights) {
+    FlowConfig config = small_config(3);
+    config.add_weight = 40;
+    config.cancel_weight = 40;
+    config.modify_weight = 10;
+    config.execute_weight = 10;
+    config.max_live_orders = 1'000'000;     // Out of the forced add/cancel regimes
+    config.min_live_orders = 0;
+    FlowGenerator flow(config);
+
+    // Warm up so the live set is never empty
+    take(flow, 10'000);
+    std::array<size_t, 8> counts{};
+    for (const Message& msg : take(flow, 200'000)) {
+        ++counts[static_cast<size_t>(msg.type)];
+    }
+    const double n = 200'000;
+    EXPECT_NEAR(counts[static_cast<size_t>(MessageType::ADD_ORDER)] / n, 0.40, 0.01);
+    EXPECT_NEAR(counts[static_cast<size_t>(MessageType::CANCEL_ORDER)] / n, 0.40, 0.01);
+    EXPECT_NEAR(counts[static_cast<size_t>(MessageType::MODIFY_ORDER)] / n, 0.10, 0.01);
+    EXPECT_NEAR(counts[static_cast<size_t>(MessageType::EXECUTE_ORDER)] / n, 0.10, 0.01);
+}
+
+TEST(FlowGeneratorTest, LiveOrdersStayWithinBounds) {
+    FlowConfig config = small_config(9);
+    config.add_weight = 90;                 // Pushes against the ceiling
+    config.cancel_weight = 10;
+    config.modify_weight = 0;
+    config.execute_weight = 0;
+    FlowGenerator flow(config);
+
+    Message msg;
+    for (int i = 0; i < 50'000; ++i) {
+        flow.next(msg);
+        ASSERT_LE(flow.live_orders(), config.max_live_orders);
+    }
+    EXPECT_EQ(flow.live_orders(), config.max_live_orders);
+}
+
+TEST(FlowGeneratorTest, SymbolCountIsClampedToTheUniverse) {
+    FlowConfig config = small_config(1);
+    config.symbols = Config::MAX_SYMBOLS * 4;
+    FlowGenerator flow(config);
+    EXPECT_EQ(flow.config().symbols, Config::MAX_SYMBOLS);
+
+    for (const Message& msg : take(flow, 50'000)) {
+        ASSERT_LT(msg.symbol, Config::MAX_SYMBOLS);
+    }
+}
+
+TEST(FlowGeneratorTest, PricesClusterAroundTheMid) {
+    FlowConfig config = small_config(4);
+    config.symbols = 1;
+    config.mid_step_interval = 1'000'000'000;   // Freeze the mid
+    FlowGenerator flow(config);
+
+    size_t adds = 0, near_touch = 0;
+    for (const Message& msg : take(flow, 50'000)) {
+        if (msg.type != MessageType::ADD_ORDER) continue;
+        const Price mid = flow.mid(0);
+        const Price distance = msg.side == Side::BUY ? mid - msg.price : msg.price - mid;
+        ASSERT_GE(distance, 1u);
+        ASSERT_LE(distance, config.depth);
+        ++adds;
+        near_touch += distance <= config.depth / 4;
+    }
+    // min of two uniforms: P(d <= depth/4) is about 7/16
+    EXPECT_GT(near_touch, adds * 4 / 10);
+}
+
+TEST(FlowGeneratorTest, BurstPhasesCompressTimestamps) {
+    FlowConfig config = small_config(2);
+    config.messages_per_second = 1e6;         // 1 us mean gap
+    config.phases[0] = BurstPhase{1'000'000, 10.0};
+    config.phase_count = 1;
+    FlowGenerator flow(config);
+
+    // First 1 ms at 10x: about 10'000 messages; then back to the base rate
+    size_t in_burst = 0;
+    Message msg;
+    do {
+        flow.next(msg);
+        ++in_burst;
+    } while (msg.timestamp < 1'000'000);
+    EXPECT_NEAR(static_cast<double>(in_burst), 10'000, 500);
+
+    const Timestamp start = msg.timestamp;
+    for (int i = 0; i < 10'000; ++i) flow.next(msg);
+    EXPECT_NEAR(static_cast<double>(msg.timestamp - start), 10'000'000, 500'000);
+}
+
+TEST(FlowGeneratorTest, FillsRingSlotsInPlace) {
+    auto ring = std::make_unique<SPSCRing<Message, 1024>>();
+    FlowGenerator flow(small_config(8)), reference(small_config(8));
+
+    EXPECT_EQ(flow.fill(*ring, 100), 100u);
+    EXPECT_EQ(flow.fill(*ring, 10'000), ring->capacity() - 100);   // Stops when full
+
+    Message expected, got;
+    size_t popped = 0;
+    while (ring->try_pop(got)) {
+        reference.next(expected);
+        ASSERT_TRUE(same(expected, got));
+        ++popped;
+    }
+    EXPECT_EQ(popped, ring->capacity());
+}
@@ -0,0 +1,92 @@
+#include "HugePageArena.h"
+#include "BookManager.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+bool inside(const HugePageArena& arena, const void* base, const void* p) {
+    const auto* b = static_cast<const char*>(base);
+    const auto* q = static_cast<const char*>(p);
+    return q >= b && q < b + arena.capacity();
+}
+
+}  // namespace
+
+TEST(HugePageArenaTest, MapsWithSomeBacking) {
+    HugePageArena arena(1 << 20);
+    EXPECT_NE(arena.backing(), PageBacking::NONE);
+    EXPECT_GE(arena.capacity(), size_t{1} << 20);
+    EXPECT_EQ(arena.capacity() % HugePageArena::HUGE_PAGE_2MB, 0u);
+    EXPECT_STRNE(page_backing_name(arena.backing()), "NONE");
+}
+
+TEST(HugePageArenaTest, BumpAllocatesAligned) {
+    HugePageArena arena(1 << 20);
+    void* a = arena.allocate(10);
+    void* b = arena.allocate(10, 256);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % CACHE_LINE_SIZE, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 256, 0u);
+    EXPECT_GT(b, a);
+    EXPECT_EQ(arena.used(), 256u + 10u);
+}
+
+TEST(HugePageArenaTest, ExhaustionReturnsNullAndCounts) {
+    HugePageArena arena(1);
+    EXPECT_NE(arena.allocate(arena.capacity()), nullptr);
+    EXPECT_EQ(arena.allocate(1), nullptr);
+    EXPECT_EQ(arena.allocate_array<uint64_t>(SIZE_MAX / 4), nullptr);
+    EXPECT_EQ(arena.failed_allocations(), 2u);
+}
+
+TEST(HugePageArenaTest, ArraysAreValueInitialized) {
+    HugePageArena arena(1 << 20);
+    PriceLevel* levels = arena.allocate_array<PriceLevel>(1024);
+    ASSERT_NE(levels, nullptr);
+    for (size_t i = 0; i < 1024; ++i) {
+        EXPECT_TRUE(levels[i].empty());
+    }
+}
+
+TEST(HugePageArenaTest, ArenaArrayFallsBackToHeap) {
+    HugePageArena arena(1);
+    ArenaArray<uint64_t> fits(1024, &arena);
+    ArenaArray<uint64_t> spills(arena.capacity(), &arena);
+    ArenaArray<uint64_t> heap(16, nullptr);
+
+    EXPECT_TRUE(fits.in_arena());
+    EXPECT_FALSE(spills.in_arena());
+    EXPECT_FALSE(heap.in_arena());
+    spills[arena.capacity() - 1] = 7;
+    EXPECT_EQ(spills[arena.capacity() - 1], 7u);
+}
+
+TEST(HugePageArenaTest, RingSlotsLiveInTheArena) {
+    HugePageArena arena(1 << 20);
+    SPSCRing<uint64_t, 1024, AtomicRingStats, ArenaRingStorage> ring(arena);
+    EXPECT_GE(arena.used(), 1024 * sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < 2000; ++i) {
+        ASSERT_TRUE(ring.try_emplace(i));
+        uint64_t value = 0;
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(HugePageArenaTest, BookManagerTakesPoolIndexAndLevels) {
+    HugePageArena arena(64 << 20);
+    const void* base = arena.allocate(0);
+    BookManager books(1024, &arena);
+    ASSERT_TRUE(books.add_symbol(1));
+
+    EXPECT_EQ(arena.failed_allocations(), 0u);
+    EXPECT_TRUE(inside(arena, base, books.pool().storage()));
+
+    ASSERT_TRUE(books.add_order(1, 42, Side::BUY, 10025, 100));
+    EXPECT_EQ(books.book(1)->best_bid(), 10025u);
+    EXPECT_TRUE(books.cancel_order(42));
+    EXPECT_EQ(books.order_count(), 0u);
+}
@@ -0,0 +1,227 @@
+#include "ItchParser.h"
+#include "BookManager.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Builds a length-prefixed ITCH 5.0 stream in network byte order
+class ItchStream {
+public:
+    void add_order(uint16_t locate, uint64_t ref, char side, uint32_t shares, uint32_t price) {
+        begin('A', locate, 36);
+        put64(ref);
+        put8(side);
+        put32(shares);
+        put_stock("TEST");
+        put32(price);
+    }
+    void executed(uint16_t locate, uint64_t ref, uint32_t shares, uint64_t match) {
+        begin('E', locate, 31);
+        put64(ref);
+        put32(shares);
+        put64(match);
+    }
+    void cancel(uint16_t locate, uint64_t ref, uint32_t shares) {
+        begin('X', locate, 23);
+        put64(ref);
+        put32(shares);
+    }
+    void remove(uint16_t locate, uint64_t ref) {
+        begin('D', locate, 19);
+        put64(ref);
+    }
+    void replace(uint16_t locate, uint64_t ref, uint64_t new_ref, uint32_t shares, uint32_t price) {
+        begin('U', locate, 35);
+        put64(ref);
+        put64(new_ref);
+        put32(shares);
+        put32(price);
+    }
+    void stock_directory(uint16_t locate, const char* stock) {
+        begin('R', locate, 39);
+        put_stock(stock);
+        bytes_.resize(bytes_.size() + 39 - 19);  // Remaining directory fields
+    }
+    void unknown(char type, uint16_t length) {
+        begin(type, 0, length);
+        bytes_.resize(bytes_.size() + length - 11);
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+
+    void begin(char type, uint16_t locate, uint16_t length) {
+        put16(length);
+        put8(static_cast<uint8_t>(type));
+        put16(locate);
+        put16(0);                   // Tracking number
+        put16(0x0001);              // 48-bit timestamp: 0x0001'00000002
+        put32(0x00000002);
+    }
+    void put8(uint8_t v) { bytes_.push_back(v); }
+    void put16(uint16_t v) { put8(v >> 8); put8(v & 0xFF); }
+    void put32(uint32_t v) { put16(v >> 16); put16(v & 0xFFFF); }
+    void put64(uint64_t v) { put32(v >> 32); put32(v & 0xFFFFFFFF); }
+    void put_stock(const char* stock) {
+        char padded[8];
+        std::memset(padded, ' ', sizeof(padded));
+        std::memcpy(padded, stock, std::strlen(stock));
+        bytes_.insert(bytes_.end(), padded, padded + sizeof(padded));
+    }
+};
+
+struct CollectingSink {
+    std::vector<Message> messages;
+    std::vector<SymbolId> symbols;
+
+    void on_message(const Message& msg) noexcept { messages.push_back(msg); }
+    void on_symbol(SymbolId symbol, const char (&)[8]) { symbols.push_back(symbol); }
+};
+
+}  // namespace
+
+TEST(ItchParserTest, NormalizesOrderMessages) {
+    CollectingSink sink;
+    ItchParser<CollectingSink> parser(sink, false);
+    parser.map_locate(5, 3);
+
+    ItchStream stream;
+    stream.add_order(5, 1001, 'S', 200, 1002500);  // $100.25
+    stream.executed(5, 1001, 50, 77);
+    stream.cancel(5, 1001, 25);
+    stream.replace(5, 1001, 1002, 100, 1003000);
+    stream.remove(5, 1002);
+
+    ASSERT_EQ(parser.parse(stream.bytes().data(), stream.bytes().size()), stream.bytes().size());
+    ASSERT_EQ(sink.messages.size(), 5u);
+
+    const Message& add = sink.messages[0];
+    EXPECT_EQ(add.type, MessageType::ADD_ORDER);
+    EXPECT_EQ(add.symbol, 3u);
+    EXPECT_EQ(add.order_id, 1001u);
+    EXPECT_EQ(add.side, Side::SELL);
+    EXPECT_EQ(add.quantity, 200u);
+    EXPECT_EQ(add.price, 10025u);
+    EXPECT_EQ(add.timestamp, 0x000100000002ULL);
+
+    EXPECT_EQ(sink.messages[1].type, MessageType::EXECUTE_ORDER);
+    EXPECT_EQ(sink.messages[1].quantity, 50u);
+    EXPECT_EQ(sink.messages[1].new_order_id, 77u);
+
+    EXPECT_EQ(sink.messages[2].type, MessageType::CANCEL_ORDER);
+    EXPECT_EQ(sink.messages[2].quantity, 25u);
+
+    EXPECT_EQ(sink.messages[3].type, MessageType::MODIFY_ORDER);
+    EXPECT_EQ(sink.messages[3].new_order_id, 1002u);
+    EXPECT_EQ(sink.messages[3].price, 10030u);
+
+    EXPECT_EQ(sink.messages[4].type, MessageType::CANCEL_ORDER);
+    EXPECT_EQ(sink.messages[4].quantity, 0u);
+
+    for (size_t i = 0; i < sink.messages.size(); ++i) {
+        EXPECT_EQ(sink.messages[i].sequence, i);
+    }
+}
+
+TEST(ItchParserTest, LeavesPartialMessageUnconsumed) {
+    CollectingSink sink;
+    ItchParser<CollectingSink> parser(sink, false);
+    parser.map_locate(1, 1);
+
+    ItchStream stream;
+    stream.add_order(1, 1, 'B', 10, 10000);
+    stream.add_order(1, 2, 'B', 10, 10000);
+    const size_t first = 2 + 36;
+
+    EXPECT_EQ(parser.parse(stream.bytes().data(), stream.bytes().size() - 5), first);
+    EXPECT_EQ(sink.messages.size(), 1u);
+}
+
+TEST(ItchParserTest, SkipsUnknownAndUnmapped) {
+    CollectingSink sink;
+    ItchParser<CollectingSink> parser(sink, false);
+
+    ItchStream stream;
+    stream.unknown('H', 25);            // Trading action: not book-relevant
+    stream.add_order(9, 1, 'B', 10, 10000);
+    stream.remove(9, 1);                // Id-keyed: still forwarded
+
+    parser.parse(stream.bytes().data(), stream.bytes().size());
+    EXPECT_EQ(parser.messages_skipped(), 1u);
+    EXPECT_EQ(parser.unmapped_messages(), 1u);
+    ASSERT_EQ(sink.messages.size(), 1u);
+    EXPECT_EQ(sink.messages[0].type, MessageType::CANCEL_ORDER);
+}
+
+TEST(ItchParserTest, RejectsTruncatedMessages) {
+    CollectingSink sink;
+    ItchParser<CollectingSink> parser(sink, false);
+
+    ItchStream stream;
+    stream.unknown('A', 20);            // Add order shorter than the spec
+    parser.parse(stream.bytes().data(), stream.bytes().size());
+    EXPECT_EQ(parser.malformed_messages(), 1u);
+    EXPECT_TRUE(sink.messages.empty());
+}
+
+TEST(ItchParserTest, StockDirectoryAssignsSymbols) {
+    CollectingSink sink;
+    ItchParser<CollectingSink> parser(sink);
+
+    ItchStream stream;
+    stream.stock_directory(100, "AAPL");
+    stream.stock_directory(200, "MSFT");
+    stream.add_order(200, 1, 'B', 10, 10000);
+    parser.parse(stream.bytes().data(), stream.bytes().size());
+
+    EXPECT_EQ(parser.symbol_for(100), 0u);
+    EXPECT_EQ(parser.symbol_for(200), 1u);
+    EXPECT_EQ(sink.symbols, (std::vector<SymbolId>{0, 1}));
+    ASSERT_EQ(sink.messages.size(), 1u);
+    EXPECT_EQ(sink.messages[0].symbol, 1u);
+}
+
+TEST(ItchParserTest, DrivesBookDirectly) {
+    BookManager books(1024);
+    ItchBookSink<BookManager> sink{books};
+    ItchParser<ItchBookSink<BookManager>> parser(sink);
+
+    ItchStream stream;
+    stream.stock_directory(7, "SPY");
+    stream.add_order(7, 1, 'B', 100, 4500000);
+    stream.add_order(7, 2, 'S', 100, 4501000);
+    stream.executed(7, 2, 40, 1);
+    stream.replace(7, 1, 3, 80, 4500500);
+    parser.parse(stream.bytes().data(), stream.bytes().size());
+
+    const OrderBook* book = books.book(parser.symbol_for(7));
+    ASSERT_NE(book, nullptr);
+    EXPECT_EQ(book->best_bid(), 45005u);
+    EXPECT_EQ(book->quantity_at(Side::BUY, 45005), 80u);
+    EXPECT_EQ(book->best_ask(), 45010u);
+    EXPECT_EQ(book->quantity_at(Side::SELL, 45010), 60u);
+}
+
+TEST(ItchParserTest, FeedsRing) {
+    SPSCRing<Message, 4> ring;
+    ItchRingSink<SPSCRing<Message, 4>> sink{ring};
+    ItchParser<ItchRingSink<SPSCRing<Message, 4>>> parser(sink, false);
+    parser.map_locate(1, 1);
+
+    ItchStream stream;
+    for (uint64_t i = 0; i < 5; ++i) {
+        stream.add_order(1, i, 'B', 10, 10000);
+    }
+    parser.parse(stream.bytes().data(), stream.bytes().size());
+
+    EXPECT_EQ(ring.size(), 3u);         // Capacity is Size - 1
+    EXPECT_EQ(sink.dropped, 2u);
+    Message msg;
+    ASSERT_TRUE(ring.try_pop(msg));
+    EXPECT_EQ(msg.order_id, 0u);
+}
@@ -0,0 +1,99 @@
+#include "LatencyHistogram.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    for (uint64_t v = 0; v < LatencyHistogram::SUB_BUCKET_COUNT; ++v) {
+        EXPECT_EQ(LatencyHistogram::bucket_index(v), v);
+        EXPECT_EQ(LatencyHistogram::bucket_upper_bound(v), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsAreContiguousWithBoundedError) {
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t v = rng() >> (rng() % 64);
+        const size_t idx = LatencyHistogram::bucket_index(v);
+        ASSERT_LT(idx, LatencyHistogram::BUCKET_COUNT);
+
+        const uint64_t upper = LatencyHistogram::bucket_upper_bound(idx);
+        const uint64_t lower = idx == 0 ? 0 : LatencyHistogram::bucket_upper_bound(idx - 1) + 1;
+        ASSERT_LE(lower, v);
+        ASSERT_GE(upper, v);
+        ASSERT_LE(static_cast<double>(upper - lower), static_cast<double>(v) / 64.0 + 1.0);
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformDistribution) {
+    auto hist = std::make_unique<LatencyHistogram>();
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        hist->record(v);
+    }
+
+    EXPECT_EQ(hist->count(), 10000u);
+    EXPECT_EQ(hist->min_cycles(), 1u);
+    EXPECT_EQ(hist->max_cycles(), 10000u);
+    EXPECT_DOUBLE_EQ(hist->mean_cycles(), 5000.5);
+    EXPECT_NEAR(static_cast<double>(hist->percentile_cycles(50.0)), 5000.0, 5000.0 / 64);
+    EXPECT_NEAR(static_cast<double>(hist->percentile_cycles(99.0)), 9900.0, 9900.0 / 64);
+    EXPECT_EQ(hist->percentile_cycles(100.0), 10000u);
+}
+
+TEST(LatencyHistogramTest, EmptyAndReset) {
+    auto hist = std::make_unique<LatencyHistogram>();
+    EXPECT_EQ(hist->percentile_cycles(99.0), 0u);
+    EXPECT_EQ(hist->min_cycles(), 0u);
+
+    hist->record(500);
+    hist->reset();
+    EXPECT_EQ(hist->count(), 0u);
+    EXPECT_EQ(hist->max_cycles(), 0u);
+}
+
+TEST(LatencyHistogramTest, MergeCombinesThreads) {
+    auto a = std::make_unique<LatencyHistogram>();
+    auto b = std::make_unique<LatencyHistogram>();
+    auto total = std::make_unique<LatencyHistogram>();
+
+    std::thread ta([&] { for (uint64_t i = 0; i < 1000; ++i) a->record(10); });
+    std::thread tb([&] { for (uint64_t i = 0; i < 1000; ++i) b->record(100000); });
+    ta.join();
+    tb.join();
+
+    total->merge(*a);
+    total->merge(*b);
+    EXPECT_EQ(total->count(), 2000u);
+    EXPECT_EQ(total->min_cycles(), 10u);
+    EXPECT_EQ(total->max_cycles(), 100000u);
+    EXPECT_EQ(total->percentile_cycles(50.0), 10u);
+    EXPECT_GE(total->percentile_cycles(99.0), 100000u - 100000u / 64);
+}
+
+TEST(LatencyHistogramTest, SummaryReportsNanoseconds) {
+    const TSCTimer& timer = TSCTimer::instance();
+    auto hist = std::make_unique<LatencyHistogram>();
+    for (int i = 0; i < 100; ++i) hist->record(1000);
+
+    const LatencySummary s = hist->summary(timer);
+    EXPECT_EQ(s.count, 100u);
+    EXPECT_NEAR(s.max_ns, timer.cycles_to_ns(1000), 1e-9);
+    EXPECT_LE(s.p50_ns, s.p99_ns);
+    EXPECT_LE(s.p9999_ns, s.max_ns);
+
+    std::ostringstream out;
+    hist->print("test", timer, out);
+    EXPECT_NE(out.str().find("p99.99="), std::string::npos);
+}
+
+TEST(LatencyHistogramTest, PerMessageTypeRecorder) {
+    auto recorder = std::make_unique<MessageLatencyRecorder>();
+    recorder->record(MessageType::CANCEL_ORDER, 50);
+    recorder->record(MessageType::CANCEL_ORDER, 60);
+    recorder->record(MessageType::ADD_ORDER, 70);
+    EXPECT_EQ((*recorder)[MessageType::CANCEL_ORDER].count(), 2u);
+    EXPECT_EQ((*recorder)[MessageType::ADD_ORDER].max_cycles(), 70u);
+}
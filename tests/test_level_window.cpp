@@ -0,0 +1,140 @@
+#include "LevelWindow.h"
+#include "OrderBook.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+namespace {
+
+using SmallWindow = LevelWindow<16, 16>;   // 16-level window, 8 far levels
+
+void put(SmallWindow& w, Price price, Quantity qty) {
+    PriceLevel* lvl = w.acquire(price);
+    ASSERT_NE(lvl, nullptr);
+    lvl->head = lvl->tail = 1;
+    lvl->total_quantity = qty;
+    lvl->order_count = 1;
+}
+
+void clear(SmallWindow& w, Price price) {
+    w.at(price) = PriceLevel{};
+    w.release_if_empty(price);
+}
+
+}  // namespace
+
+TEST(LevelWindowTest, FarLevelsGoToOverflow) {
+    SmallWindow w;
+    put(w, 5, 10);
+    put(w, 500, 20);
+    EXPECT_TRUE(w.in_window(5));
+    EXPECT_FALSE(w.in_window(500));
+    EXPECT_EQ(w.overflow_size(), 1u);
+    EXPECT_EQ(w.get(500).total_quantity, 20u);
+    EXPECT_TRUE(w.get(501).empty());
+
+    clear(w, 500);
+    EXPECT_EQ(w.overflow_size(), 0u);
+}
+
+TEST(LevelWindowTest, RecenterSwapsLevelsBothWays) {
+    SmallWindow w;
+    put(w, 3, 30);
+    put(w, 40, 400);
+    put(w, 45, 450);
+
+    ASSERT_TRUE(w.recenter(42));
+    EXPECT_EQ(w.base(), 34u);
+    EXPECT_TRUE(w.in_window(40));
+    EXPECT_FALSE(w.in_window(3));
+    EXPECT_EQ(w.overflow_size(), 1u);   // Only price 3 is far now
+    EXPECT_EQ(w.get(3).total_quantity, 30u);
+    EXPECT_EQ(w.get(40).total_quantity, 400u);
+    EXPECT_EQ(w.get(45).total_quantity, 450u);
+
+    ASSERT_TRUE(w.recenter(38));          // Small shift: only 4 slots move
+    EXPECT_EQ(w.get(45).total_quantity, 450u);
+    EXPECT_EQ(w.recenters(), 2u);
+}
+
+TEST(LevelWindowTest, RecenterRefusedWhenOverflowFull) {
+    SmallWindow w;
+    for (Price p = 100; p < 100 + SmallWindow::OVERFLOW_CAPACITY; ++p) {
+        put(w, p * 10, 1);
+    }
+    EXPECT_EQ(w.acquire(5000), nullptr);
+    EXPECT_FALSE(w.can_acquire(5000));
+
+    put(w, 2, 1);
+    EXPECT_FALSE(w.recenter(300));       // Price 2 has nowhere to go
+    EXPECT_EQ(w.failed_recenters(), 1u);
+    EXPECT_EQ(w.base(), Config::MIN_PRICE);
+    EXPECT_EQ(w.get(2).total_quantity, 1u);
+}
+
+TEST(LevelWindowTest, NeighbourSearchCrossesIntoOverflow) {
+    SmallWindow w;
+    put(w, 2, 1);
+    put(w, 9, 1);
+    put(w, 200, 1);
+    put(w, 300, 1);
+
+    EXPECT_EQ(w.highest_below(9), 2u);
+    EXPECT_EQ(w.highest_below(2), SmallWindow::NO_PRICE);
+    EXPECT_EQ(w.lowest_above(9), 200u);
+    EXPECT_EQ(w.lowest_above(200), 300u);
+    EXPECT_EQ(w.highest_below(300), 200u);
+    EXPECT_EQ(w.highest_below(250), 200u);
+    EXPECT_EQ(w.highest_below(150), 9u);
+    EXPECT_EQ(w.lowest_above(300), SmallWindow::NO_PRICE);
+}
+
+TEST(LevelWindowTest, MatchesReferenceUnderRandomChurn) {
+    SmallWindow w;
+    std::map<Price, Quantity> reference;
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<Price> price_dist(1, 120);
+
+    for (int i = 0; i < 20000; ++i) {
+        const Price p = price_dist(rng);
+        if (reference.count(p)) {
+            clear(w, p);
+            reference.erase(p);
+        } else if (w.can_acquire(p)) {
+            put(w, p, p);
+            reference[p] = p;
+        }
+        if (i % 7 == 0) {
+            w.maybe_recenter(price_dist(rng));
+        }
+
+        const Price probe = price_dist(rng);
+        auto above = reference.upper_bound(probe);
+        EXPECT_EQ(w.lowest_above(probe), above == reference.end() ? 0 : above->first);
+        auto below = reference.lower_bound(probe);
+        EXPECT_EQ(w.highest_below(probe), below == reference.begin() ? 0 : std::prev(below)->first);
+        EXPECT_EQ(w.get(probe).total_quantity, reference.count(probe) ? probe : 0);
+    }
+}
+
+TEST(LevelWindowTest, BookFollowsTouchAcrossTheRange) {
+    OrderPool pool(64);
+    OrderBook book(1, pool);
+
+    const OrderHandle near = book.add_order(1, Side::BUY, 30000, 10);
+    const OrderHandle far = book.add_order(2, Side::BUY, 100, 20);
+    ASSERT_NE(near, INVALID_ORDER_HANDLE);
+    ASSERT_NE(far, INVALID_ORDER_HANDLE);
+    EXPECT_TRUE(book.bid_levels().in_window(30000));
+    EXPECT_EQ(book.bid_levels().overflow_size(), 1u);
+    EXPECT_EQ(book.quantity_at(Side::BUY, 100), 20u);
+
+    book.cancel_order(near);
+    EXPECT_EQ(book.best_bid(), 100u);
+    EXPECT_TRUE(book.bid_levels().in_window(100));
+    EXPECT_EQ(book.bid_levels().overflow_size(), 0u);
+
+    EXPECT_TRUE(book.modify_order(far, 60000, 5));
+    EXPECT_EQ(book.best_bid(), 60000u);
+    EXPECT_EQ(book.quantity_at(Side::BUY, 60000), 5u);
+}
@@ -0,0 +1,167 @@
+#include "MarketDataBus.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+Message add(OrderId id, Side side, Price price, Quantity qty, uint64_t seq) {
+    Message msg{};
+    msg.type = MessageType::ADD_ORDER;
+    msg.symbol = 1;
+    msg.order_id = id;
+    msg.side = side;
+    msg.price = price;
+    msg.quantity = qty;
+    msg.sequence = seq;
+    return msg;
+}
+
+LevelUpdate update(uint64_t seq) {
+    return LevelUpdate{seq * 10, seq, static_cast<Price>(100 + seq % 50),
+                       static_cast<Quantity>(seq), 1, 1, Side::BUY};
+}
+
+std::vector<LevelUpdate> drain(MarketDataBusReader& reader) {
+    std::vector<LevelUpdate> out;
+    reader.consume_all([&](const LevelUpdate& u) { out.push_back(u); });
+    return out;
+}
+
+}  // namespace
+
+class MarketDataBusTest : public ::testing::Test {
+protected:
+    std::string name = "/hft_bus_test_" + std::to_string(getpid());
+    MarketDataBus bus;
+
+    void SetUp() override { ASSERT_TRUE(bus.create(name.c_str())); }
+};
+
+TEST_F(MarketDataBusTest, ReaderSeesUpdatesPublishedAfterAttach) {
+    bus.try_publish(update(1));        // Before attach: not replayed
+
+    MarketDataBusReader reader;
+    ASSERT_TRUE(reader.attach(name.c_str()));
+    EXPECT_EQ(reader.session(), bus.session());
+    EXPECT_TRUE(reader.producer_alive());
+
+    for (uint64_t s = 2; s <= 200; ++s) {
+        ASSERT_TRUE(bus.try_publish(update(s)));
+    }
+    const auto seen = drain(reader);
+    ASSERT_EQ(seen.size(), 199u);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        EXPECT_EQ(seen[i].sequence, i + 2);
+        EXPECT_EQ(seen[i].total_quantity, i + 2);
+    }
+    EXPECT_EQ(reader.lag(), 0u);
+    EXPECT_TRUE(drain(reader).empty());
+}
+
+TEST_F(MarketDataBusTest, AttachRejectsMissingAndClosedSegments) {
+    MarketDataBusReader reader;
+    EXPECT_FALSE(reader.attach("/hft_bus_test_absent"));
+
+    ASSERT_TRUE(reader.attach(name.c_str()));
+    bus.close();
+    EXPECT_FALSE(reader.producer_alive());      // Old mapping stays readable
+    EXPECT_FALSE(reader.attach(name.c_str()));  // Unlinked
+}
+
+TEST_F(MarketDataBusTest, LappedReaderStopsAndResyncs) {
+    MarketDataBusReader reader;
+    ASSERT_TRUE(reader.attach(name.c_str()));
+
+    for (uint64_t s = 1; s <= MarketDataBus::SLOTS + 10; ++s) {
+        bus.try_publish(update(s));
+    }
+    EXPECT_TRUE(drain(reader).empty());
+    EXPECT_TRUE(reader.lapped());
+    EXPECT_EQ(reader.overruns(), 1u);
+    EXPECT_TRUE(drain(reader).empty());         // No delivery across the gap
+
+    reader.resync();
+    EXPECT_FALSE(reader.lapped());
+    bus.try_publish(update(99'999));
+    const auto seen = drain(reader);
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(seen[0].sequence, 99'999u);
+}
+
+TEST_F(MarketDataBusTest, ReaderJustWithinALapGetsEverything) {
+    MarketDataBusReader reader;
+    ASSERT_TRUE(reader.attach(name.c_str()));
+    for (uint64_t s = 1; s < MarketDataBus::SLOTS; ++s) {
+        bus.try_publish(update(s));
+    }
+    EXPECT_EQ(drain(reader).size(), MarketDataBus::SLOTS - 1);
+    EXPECT_FALSE(reader.lapped());
+}
+
+TEST_F(MarketDataBusTest, PublisherWritesDeltasAndDepthSnapshots) {
+    BookManager books{1024};
+    books.add_symbol(1);
+    BookPublisher<MarketDataBus> out(books, bus);
+
+    MarketDataBusReader reader;
+    ASSERT_TRUE(reader.attach(name.c_str()));
+
+    out.process(add(1, Side::BUY, 100, 10, 1));
+    out.process(add(2, Side::BUY, 101, 20, 2));
+    out.process(add(3, Side::SELL, 105, 30, 3));
+    out.process(add(4, Side::BUY, 100, 5, 4));
+
+    const auto seen = drain(reader);
+    ASSERT_EQ(seen.size(), 4u);
+    EXPECT_EQ(seen[3].price, 100u);
+    EXPECT_EQ(seen[3].total_quantity, 15u);
+
+    const BookSnapshot snap = reader.snapshot(1);
+    EXPECT_EQ(snap.sequence, 4u);
+    ASSERT_EQ(snap.bid_count, 2u);
+    ASSERT_EQ(snap.ask_count, 1u);
+    EXPECT_EQ(snap.bids[0].price, 101u);
+    EXPECT_EQ(snap.bids[1].price, 100u);
+    EXPECT_EQ(snap.bids[1].quantity, 15u);
+    EXPECT_EQ(snap.bids[1].order_count, 2u);
+    EXPECT_EQ(snap.asks[0].quantity, 30u);
+    EXPECT_EQ(snap.bids[2].price, 0u);
+}
+
+TEST_F(MarketDataBusTest, ConsumerProcessReadsThroughOwnMapping) {
+    constexpr uint64_t COUNT = 10'000;
+
+    int attached[2];
+    ASSERT_EQ(pipe(attached), 0);
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        MarketDataBusReader reader;
+        const char ok = reader.attach(name.c_str()) ? 1 : 0;
+        if (write(attached[1], &ok, 1) != 1 || !ok) _exit(2);
+        uint64_t expected = 1;
+        while (expected <= COUNT && !reader.lapped()) {
+            reader.consume_all([&](const LevelUpdate& u) {
+                if (u.sequence == expected) ++expected;
+            });
+        }
+        _exit(expected == COUNT + 1 ? 0 : 1);
+    }
+
+    // Publish only once the child has attached and sits at position 0
+    char ok = 0;
+    ASSERT_EQ(read(attached[0], &ok, 1), 1);
+    ASSERT_EQ(ok, 1);
+    for (uint64_t s = 1; s <= COUNT; ++s) {
+        bus.try_publish(update(s));
+    }
+    close(attached[0]);
+    close(attached[1]);
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
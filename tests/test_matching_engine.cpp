@@ -0,0 +1,205 @@
+#include "MatchingEngine.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+class MatchingEngineTest : public ::testing::Test {
+protected:
+    BookManager books{1024};
+    std::unique_ptr<MatchOutputRing> out = std::make_unique<MatchOutputRing>();
+    MatchingEngine<MatchOutputRing> venue{books, *out};
+
+    void SetUp() override { books.add_symbol(1); }
+
+    std::vector<Message> drain() {
+        std::vector<Message> events;
+        Message msg;
+        while (out->try_pop(msg)) events.push_back(msg);
+        return events;
+    }
+
+    void rest(OrderId id, Side side, Price price, Quantity qty) {
+        ASSERT_EQ(venue.submit(1, id, side, price, qty).rested, qty);
+    }
+};
+
+TEST_F(MatchingEngineTest, NonCrossingOrderRests) {
+    const MatchResult r = venue.submit(1, 1, Side::BUY, 100, 10);
+    EXPECT_TRUE(r.accepted);
+    EXPECT_EQ(r.filled, 0u);
+    EXPECT_EQ(r.rested, 10u);
+    EXPECT_EQ(books.book(1)->best_bid(), 100u);
+
+    const auto events = drain();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, MessageType::ADD_ORDER);
+    EXPECT_EQ(events[0].sequence, 1u);
+}
+
+TEST_F(MatchingEngineTest, CrossingOrderSweepsInPriceTimePriority) {
+    rest(1, Side::SELL, 101, 5);
+    rest(2, Side::SELL, 100, 3);
+    rest(3, Side::SELL, 100, 4);       // Behind order 2 at the same price
+    drain();
+
+    const MatchResult r = venue.submit(1, 10, Side::BUY, 101, 10);
+    EXPECT_EQ(r.filled, 10u);
+    EXPECT_EQ(r.rested, 0u);
+
+    const auto events = drain();
+    ASSERT_EQ(events.size(), 6u);      // Execute + trade per fill
+    EXPECT_EQ(events[0].type, MessageType::EXECUTE_ORDER);
+    EXPECT_EQ(events[0].order_id, 2u);
+    EXPECT_EQ(events[0].price, 100u);
+    EXPECT_EQ(events[0].quantity, 3u);
+    EXPECT_EQ(events[1].type, MessageType::TRADE);
+    EXPECT_EQ(events[1].order_id, 10u);
+    EXPECT_EQ(events[1].side, Side::BUY);
+    EXPECT_EQ(events[1].new_order_id, events[0].new_order_id);
+    EXPECT_EQ(events[2].order_id, 3u);
+    EXPECT_EQ(events[4].order_id, 1u);
+    EXPECT_EQ(events[4].price, 101u);
+    EXPECT_EQ(events[4].quantity, 3u);
+
+    // Order 1 keeps its residual; 2 and 3 are gone from the index
+    EXPECT_EQ(books.book(1)->best_ask(), 101u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 101), 2u);
+    EXPECT_EQ(books.find_order(2), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(venue.matches(), 3u);
+    EXPECT_EQ(venue.matched_volume(), 10u);
+}
+
+TEST_F(MatchingEngineTest, LimitRemainderRestsAtItsPrice) {
+    rest(1, Side::BUY, 100, 4);
+    const MatchResult r = venue.submit(1, 2, Side::SELL, 99, 10);
+    EXPECT_EQ(r.filled, 4u);
+    EXPECT_EQ(r.rested, 6u);
+    EXPECT_FALSE(books.book(1)->has_bid());
+    EXPECT_EQ(books.book(1)->best_ask(), 99u);
+}
+
+TEST_F(MatchingEngineTest, ImmediateOrCancelDropsRemainder) {
+    rest(1, Side::SELL, 100, 4);
+    const MatchResult r = venue.submit<ImmediateOrCancel>(1, 2, Side::BUY, 100, 10);
+    EXPECT_EQ(r.filled, 4u);
+    EXPECT_EQ(r.rested, 0u);
+    EXPECT_FALSE(books.book(1)->has_bid());
+    EXPECT_EQ(books.find_order(2), INVALID_ORDER_HANDLE);
+}
+
+TEST_F(MatchingEngineTest, FillOrKillNeedsTheWholeQuantity) {
+    rest(1, Side::SELL, 100, 4);
+    rest(2, Side::SELL, 102, 4);
+    drain();
+
+    // Only 4 within the limit: killed, book untouched
+    MatchResult r = venue.submit<FillOrKill>(1, 3, Side::BUY, 101, 6);
+    EXPECT_EQ(r.filled, 0u);
+    EXPECT_EQ(venue.killed_orders(), 1u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 100), 4u);
+    EXPECT_TRUE(drain().empty());
+
+    r = venue.submit<FillOrKill>(1, 4, Side::BUY, 102, 6);
+    EXPECT_EQ(r.filled, 6u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 102), 2u);
+}
+
+TEST_F(MatchingEngineTest, PostOnlyRejectsCrossingOrders) {
+    rest(1, Side::SELL, 100, 4);
+    EXPECT_FALSE((venue.submit<PostOnlyOrder>(1, 2, Side::BUY, 100, 5).accepted));
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 100), 4u);
+
+    const MatchResult r = venue.submit<PostOnlyOrder>(1, 3, Side::BUY, 99, 5);
+    EXPECT_EQ(r.rested, 5u);
+}
+
+TEST_F(MatchingEngineTest, DuplicateAndInvalidOrdersAreRejected) {
+    rest(1, Side::BUY, 100, 4);
+    EXPECT_FALSE(venue.submit(1, 1, Side::BUY, 99, 1).accepted);
+    EXPECT_FALSE(venue.submit(1, 2, Side::BUY, 0, 1).accepted);
+    EXPECT_FALSE(venue.submit(7, 3, Side::BUY, 100, 1).accepted);
+    EXPECT_FALSE(venue.submit(1, 4, Side::BUY, 100, 0).accepted);
+    EXPECT_EQ(venue.rejected_orders(), 4u);
+}
+
+TEST_F(MatchingEngineTest, CrossingRepriceMatches) {
+    rest(1, Side::SELL, 102, 5);
+    rest(2, Side::BUY, 100, 5);
+
+    Message modify{};
+    modify.type = MessageType::MODIFY_ORDER;
+    modify.order_id = 2;
+    modify.price = 102;
+    modify.quantity = 3;
+    ASSERT_TRUE(venue.process(modify));
+    EXPECT_FALSE(books.book(1)->has_bid());
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 102), 2u);
+}
+
+TEST_F(MatchingEngineTest, CrossingRepriceOntoALiveIdKeepsTheRestingOrder) {
+    rest(1, Side::SELL, 102, 5);
+    rest(2, Side::BUY, 100, 5);
+    rest(3, Side::BUY, 99, 4);
+    drain();
+
+    Message modify{};
+    modify.type = MessageType::MODIFY_ORDER;
+    modify.order_id = 2;
+    modify.new_order_id = 3;                          // Already live
+    modify.price = 102;
+    modify.quantity = 3;
+    EXPECT_FALSE(venue.process(modify));
+
+    EXPECT_EQ(venue.rejected_orders(), 1u);
+    EXPECT_TRUE(drain().empty());                     // No CANCEL went out
+    EXPECT_EQ(books.book(1)->quantity_at(Side::BUY, 100), 5u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::BUY, 99), 4u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::SELL, 102), 5u);
+}
+
+TEST_F(MatchingEngineTest, CrossingRepriceOutOfRangeKeepsTheRestingOrder) {
+    rest(1, Side::SELL, 102, 5);
+    rest(2, Side::BUY, 100, 5);
+    drain();
+
+    Message modify{};
+    modify.type = MessageType::MODIFY_ORDER;
+    modify.order_id = 2;
+    modify.price = Config::MAX_PRICE + 1;             // Crosses, but beyond the book
+    modify.quantity = 3;
+    EXPECT_FALSE(venue.process(modify));
+
+    EXPECT_EQ(venue.rejected_orders(), 1u);
+    EXPECT_TRUE(drain().empty());
+    EXPECT_EQ(books.book(1)->best_bid(), 100u);
+    EXPECT_EQ(books.book(1)->quantity_at(Side::BUY, 100), 5u);
+}
+
+TEST_F(MatchingEngineTest, OutputFeedRebuildsTheBook) {
+    rest(1, Side::SELL, 101, 5);
+    rest(2, Side::SELL, 103, 5);
+    rest(3, Side::BUY, 99, 5);
+    venue.submit(1, 4, Side::BUY, 103, 7);
+    venue.submit<ImmediateOrCancel>(1, 5, Side::SELL, 98, 8);
+
+    Message cancel{};
+    cancel.type = MessageType::CANCEL_ORDER;
+    cancel.order_id = 2;
+    cancel.quantity = 1;
+    ASSERT_TRUE(venue.process(cancel));
+
+    BookManager replica(1024);
+    replica.add_symbol(1);
+    uint64_t expected_sequence = 1;
+    for (const Message& msg : drain()) {
+        EXPECT_EQ(msg.sequence, expected_sequence++);
+        ASSERT_TRUE(replica.process(msg));
+    }
+
+    const OrderBook& a = *books.book(1);
+    const OrderBook& b = *replica.book(1);
+    EXPECT_EQ(a.best_bid(), b.best_bid());
+    EXPECT_EQ(a.best_ask(), b.best_ask());
+    EXPECT_EQ(b.quantity_at(Side::SELL, 103), 2u);
+    EXPECT_EQ(a.order_count(), b.order_count());
+}
@@ -0,0 +1,89 @@
+#include "Message.h"
+#include "BookManager.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+Message make_message(MessageType type, OrderId id, Price price = 0, Quantity quantity = 0,
+                     Side side = Side::BUY, SymbolId symbol = 1) {
+    Message msg{};
+    msg.type = type;
+    msg.order_id = id;
+    msg.price = price;
+    msg.quantity = quantity;
+    msg.side = side;
+    msg.symbol = symbol;
+    return msg;
+}
+
+}  // namespace
+
+TEST(MessageTest, RoundTripsThroughWireFormat) {
+    Message msg = make_message(MessageType::MODIFY_ORDER, 0x1122334455667788ULL, 10025, 300,
+                               Side::SELL, 42);
+    msg.new_order_id = 99;
+    msg.timestamp = 123456789;
+    msg.sequence = 7;
+
+    uint8_t buffer[MESSAGE_WIRE_SIZE];
+    ASSERT_EQ(encode_message(msg, buffer, sizeof(buffer)), MESSAGE_WIRE_SIZE);
+
+    Message decoded{};
+    ASSERT_EQ(decode_message(buffer, sizeof(buffer), decoded), MESSAGE_WIRE_SIZE);
+    EXPECT_EQ(decoded.type, MessageType::MODIFY_ORDER);
+    EXPECT_EQ(decoded.order_id, msg.order_id);
+    EXPECT_EQ(decoded.new_order_id, 99u);
+    EXPECT_EQ(decoded.price, 10025u);
+    EXPECT_EQ(decoded.quantity, 300u);
+    EXPECT_EQ(decoded.side, Side::SELL);
+    EXPECT_EQ(decoded.symbol, 42u);
+    EXPECT_EQ(decoded.timestamp, 123456789u);
+    EXPECT_EQ(decoded.sequence, 7u);
+}
+
+TEST(MessageTest, RejectsShortAndInvalidBuffers) {
+    uint8_t buffer[MESSAGE_WIRE_SIZE] = {};
+    Message out{};
+    EXPECT_EQ(decode_message(buffer, MESSAGE_WIRE_SIZE - 1, out), 0u);
+    EXPECT_EQ(decode_message(buffer, MESSAGE_WIRE_SIZE, out), 0u);  // type 0 is invalid
+    EXPECT_EQ(encode_message(out, buffer, MESSAGE_WIRE_SIZE - 1), 0u);
+}
+
+TEST(MessageTest, DecodesBackToBackMessages) {
+    std::vector<uint8_t> buffer(MESSAGE_WIRE_SIZE * 3 + 10);
+    for (int i = 0; i < 3; ++i) {
+        const Message msg = make_message(MessageType::ADD_ORDER, i + 1, 100, 10);
+        encode_message(msg, buffer.data() + i * MESSAGE_WIRE_SIZE, MESSAGE_WIRE_SIZE);
+    }
+
+    std::vector<OrderId> ids;
+    const size_t consumed = decode_messages(buffer.data(), buffer.size(),
+                                            [&](const Message& m) { ids.push_back(m.order_id); });
+    EXPECT_EQ(consumed, MESSAGE_WIRE_SIZE * 3);
+    EXPECT_EQ(ids, (std::vector<OrderId>{1, 2, 3}));
+}
+
+TEST(MessageTest, BookManagerProcessesEachType) {
+    BookManager books(64);
+    books.add_symbol(1);
+
+    EXPECT_TRUE(books.process(make_message(MessageType::ADD_ORDER, 10, 100, 50, Side::BUY)));
+    EXPECT_TRUE(books.process(make_message(MessageType::EXECUTE_ORDER, 10, 0, 5)));
+    EXPECT_TRUE(books.process(make_message(MessageType::CANCEL_ORDER, 10, 0, 5)));
+    EXPECT_EQ(books.book(1)->quantity_at(Side::BUY, 100), 40u);
+
+    EXPECT_TRUE(books.process(make_message(MessageType::MODIFY_ORDER, 10, 101, 40)));
+    EXPECT_EQ(books.book(1)->best_bid(), 101u);
+
+    Message replace = make_message(MessageType::MODIFY_ORDER, 10, 102, 30);
+    replace.new_order_id = 11;
+    EXPECT_TRUE(books.process(replace));
+    EXPECT_NE(books.find_order(11), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(books.book(1)->best_bid(), 102u);
+
+    EXPECT_TRUE(books.process(make_message(MessageType::HEARTBEAT, 0)));
+    EXPECT_TRUE(books.process(make_message(MessageType::CANCEL_ORDER, 11)));
+    EXPECT_FALSE(books.book(1)->has_bid());
+    EXPECT_FALSE(books.process(make_message(MessageType::CANCEL_ORDER, 11)));
+}
@@ -0,0 +1,73 @@
+#include "MPSCRing.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(MPSCRingTest, UsesEverySlot) {
+    MPSCRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_emplace(i));
+    }
+    EXPECT_FALSE(ring.try_emplace(4));
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.failed_pushes(), 1u);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MPSCRingTest, ConsumeAllAcrossLaps) {
+    MPSCRing<int, 8, NoRingStats> ring;
+    std::vector<int> seen;
+    int next = 0;
+    for (int lap = 0; lap < 5; ++lap) {
+        for (int i = 0; i < 6; ++i) ring.try_emplace(next++);
+        EXPECT_EQ(ring.consume_all([&](int& v) { seen.push_back(v); }, 4), 4u);
+        EXPECT_EQ(ring.consume_all([&](int& v) { seen.push_back(v); }), 2u);
+    }
+    ASSERT_EQ(seen.size(), 30u);
+    for (int i = 0; i < 30; ++i) EXPECT_EQ(seen[i], i);
+}
+
+TEST(MPSCRingTest, ConcurrentProducersDeliverEverything) {
+    constexpr int PRODUCERS = 3;
+    constexpr uint32_t PER_PRODUCER = 20000;
+    MPSCRing<uint64_t, 256> ring;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+                const uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                while (!ring.try_emplace(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Items from one producer must arrive in that producer's order
+    std::vector<uint32_t> next_expected(PRODUCERS, 0);
+    bool in_order = true;
+    uint64_t received = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        uint64_t value;
+        if (ring.try_pop(value)) {
+            const auto p = static_cast<size_t>(value >> 32);
+            in_order &= (static_cast<uint32_t>(value) == next_expected[p]++);
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(ring.total_pushes(), received);
+    EXPECT_EQ(ring.total_pops(), received);
+}
@@ -0,0 +1,72 @@
+#include "OccupancyBitmap.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+using Bitmap = OccupancyBitmap<65536>;
+
+TEST(OccupancyBitmapTest, EmptyFindsNothing) {
+    Bitmap bits;
+    EXPECT_FALSE(bits.any());
+    EXPECT_EQ(bits.find_prev(65535), Bitmap::NPOS);
+    EXPECT_EQ(bits.find_next(0), Bitmap::NPOS);
+}
+
+TEST(OccupancyBitmapTest, SearchIsInclusiveAndCrossesWords) {
+    Bitmap bits;
+    bits.set(5);
+    bits.set(4100);      // Different summary group
+    bits.set(65535);
+    EXPECT_TRUE(bits.test(4100));
+
+    EXPECT_EQ(bits.find_prev(5), 5u);
+    EXPECT_EQ(bits.find_prev(4099), 5u);
+    EXPECT_EQ(bits.find_prev(65534), 4100u);
+    EXPECT_EQ(bits.find_prev(4), Bitmap::NPOS);
+    EXPECT_EQ(bits.find_next(6), 4100u);
+    EXPECT_EQ(bits.find_next(4101), 65535u);
+    EXPECT_EQ(bits.find_next(0), 5u);
+
+    bits.clear(4100);
+    EXPECT_FALSE(bits.test(4100));
+    EXPECT_EQ(bits.find_next(6), 65535u);
+    EXPECT_EQ(bits.find_prev(65534), 5u);
+
+    bits.reset();
+    EXPECT_FALSE(bits.any());
+}
+
+TEST(OccupancyBitmapTest, ClearKeepsNeighboursInTheSameWord) {
+    Bitmap bits;
+    bits.set(128);
+    bits.set(130);
+    bits.clear(128);
+    EXPECT_EQ(bits.find_next(0), 130u);
+    EXPECT_EQ(bits.find_prev(200), 130u);
+}
+
+TEST(OccupancyBitmapTest, MatchesOrderedSetUnderRandomChurn) {
+    Bitmap bits;
+    std::set<size_t> reference;
+    std::mt19937 rng(20);
+    // Clustered and sparse indices, so all three levels get exercised
+    std::uniform_int_distribution<size_t> index(0, 65535);
+    std::uniform_int_distribution<size_t> near(30000, 30300);
+
+    for (int step = 0; step < 20000; ++step) {
+        const size_t i = (step & 1) ? index(rng) : near(rng);
+        if (reference.count(i)) {
+            bits.clear(i);
+            reference.erase(i);
+        } else {
+            bits.set(i);
+            reference.insert(i);
+        }
+
+        const size_t probe = index(rng);
+        auto next = reference.lower_bound(probe);
+        EXPECT_EQ(bits.find_next(probe), next == reference.end() ? Bitmap::NPOS : *next);
+        auto prev = reference.upper_bound(probe);
+        EXPECT_EQ(bits.find_prev(probe), prev == reference.begin() ? Bitmap::NPOS : *std::prev(prev));
+    }
+}
@@ -0,0 +1,300 @@
+#include "OrderBook.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+class OrderBookTest : public ::testing::Test {
+protected:
+    OrderPool pool{4096};
+    OrderBook book{7, pool};
+};
+
+}  // namespace
+
+TEST_F(OrderBookTest, StartsEmpty) {
+    EXPECT_FALSE(book.has_bid());
+    EXPECT_FALSE(book.has_ask());
+    EXPECT_EQ(book.best_bid(), OrderBook::NO_BID);
+    EXPECT_EQ(book.best_ask(), OrderBook::NO_ASK);
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+TEST_F(OrderBookTest, AddUpdatesTouchAndLevels) {
+    const OrderHandle b1 = book.add_order(1, Side::BUY, 100, 10);
+    ASSERT_NE(b1, INVALID_ORDER_HANDLE);
+    ASSERT_NE(book.add_order(2, Side::BUY, 101, 20), INVALID_ORDER_HANDLE);
+    ASSERT_NE(book.add_order(3, Side::SELL, 105, 30), INVALID_ORDER_HANDLE);
+
+    EXPECT_EQ(book.best_bid(), 101u);
+    EXPECT_EQ(book.best_ask(), 105u);
+    EXPECT_EQ(book.quantity_at(Side::BUY, 100), 10u);
+    EXPECT_EQ(book.quantity_at(Side::SELL, 105), 30u);
+    EXPECT_EQ(book.order_count(), 3u);
+    EXPECT_EQ(book.order(b1).id, 1u);
+    EXPECT_EQ(book.order(b1).symbol, 7u);
+    EXPECT_EQ(pool.in_use(), 3u);
+}
+
+TEST_F(OrderBookTest, RejectsInvalidOrders) {
+    EXPECT_EQ(book.add_order(1, Side::BUY, 0, 10), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(book.add_order(2, Side::SELL, Config::MAX_PRICE + 1, 10), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(book.add_order(3, Side::BUY, 100, 0), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(book.order_count(), 0u);
+    EXPECT_EQ(book.rejected_orders(), 3u);
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST_F(OrderBookTest, RejectsWhenPoolExhausted) {
+    OrderPool small_pool(2);
+    OrderBook small_book(1, small_pool);
+
+    EXPECT_NE(small_book.add_order(1, Side::BUY, 100, 1), INVALID_ORDER_HANDLE);
+    const OrderHandle h = small_book.add_order(2, Side::BUY, 100, 1);
+    EXPECT_NE(h, INVALID_ORDER_HANDLE);
+    EXPECT_EQ(small_book.add_order(3, Side::BUY, 100, 1), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(small_pool.failed_allocations(), 1u);
+
+    small_book.cancel_order(h);
+    EXPECT_NE(small_book.add_order(4, Side::BUY, 100, 1), INVALID_ORDER_HANDLE);
+}
+
+TEST_F(OrderBookTest, LevelKeepsFifoOrder) {
+    const OrderHandle o1 = book.add_order(1, Side::SELL, 200, 1);
+    const OrderHandle o2 = book.add_order(2, Side::SELL, 200, 2);
+    const OrderHandle o3 = book.add_order(3, Side::SELL, 200, 3);
+
+    const PriceLevel& lvl = book.level(Side::SELL, 200);
+    ASSERT_EQ(lvl.order_count, 3u);
+    EXPECT_EQ(lvl.head, o1);
+    EXPECT_EQ(book.order(lvl.head).next, o2);
+    EXPECT_EQ(lvl.tail, o3);
+
+    book.cancel_order(o2);
+    EXPECT_EQ(book.order(lvl.head).next, o3);
+    EXPECT_EQ(book.order(lvl.tail).prev, o1);
+    EXPECT_EQ(lvl.total_quantity, 4u);
+    EXPECT_EQ(pool.in_use(), 2u);
+}
+
+TEST_F(OrderBookTest, CancellingTouchRecoversNextLevel) {
+    const OrderHandle b1 = book.add_order(1, Side::BUY, 90, 5);
+    const OrderHandle b2 = book.add_order(2, Side::BUY, 95, 5);
+    const OrderHandle a1 = book.add_order(3, Side::SELL, 110, 5);
+    const OrderHandle a2 = book.add_order(4, Side::SELL, 120, 5);
+
+    book.cancel_order(b2);
+    EXPECT_EQ(book.best_bid(), 90u);
+    book.cancel_order(a1);
+    EXPECT_EQ(book.best_ask(), 120u);
+
+    book.cancel_order(b1);
+    book.cancel_order(a2);
+    EXPECT_FALSE(book.has_bid());
+    EXPECT_FALSE(book.has_ask());
+}
+
+TEST_F(OrderBookTest, TouchRecoveryAtPriceBounds) {
+    const OrderHandle low = book.add_order(1, Side::SELL, Config::MIN_PRICE, 1);
+    const OrderHandle high = book.add_order(2, Side::BUY, Config::MAX_PRICE, 1);
+    EXPECT_EQ(book.best_ask(), Config::MIN_PRICE);
+    EXPECT_EQ(book.best_bid(), Config::MAX_PRICE);
+
+    book.cancel_order(low);
+    book.cancel_order(high);
+    EXPECT_FALSE(book.has_bid());
+    EXPECT_FALSE(book.has_ask());
+}
+
+TEST_F(OrderBookTest, ExecuteFillsPartiallyThenRemoves) {
+    const OrderHandle a1 = book.add_order(1, Side::SELL, 100, 50);
+
+    EXPECT_EQ(book.execute_order(a1, 20), 30u);
+    EXPECT_EQ(book.quantity_at(Side::SELL, 100), 30u);
+    EXPECT_EQ(book.order_count(), 1u);
+
+    EXPECT_EQ(book.execute_order(a1, 100), 0u);
+    EXPECT_EQ(book.executed_volume(), 50u);
+    EXPECT_EQ(book.order_count(), 0u);
+    EXPECT_FALSE(book.has_ask());
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST_F(OrderBookTest, ReduceKeepsPriority) {
+    const OrderHandle o1 = book.add_order(1, Side::BUY, 100, 10);
+    book.add_order(2, Side::BUY, 100, 10);
+
+    EXPECT_EQ(book.reduce_order(o1, 4), 6u);
+    EXPECT_EQ(book.level(Side::BUY, 100).head, o1);
+    EXPECT_EQ(book.quantity_at(Side::BUY, 100), 16u);
+}
+
+TEST_F(OrderBookTest, ModifySizeDownKeepsPriority) {
+    const OrderHandle o1 = book.add_order(1, Side::BUY, 100, 10);
+    book.add_order(2, Side::BUY, 100, 10);
+
+    ASSERT_TRUE(book.modify_order(o1, 100, 5));
+    EXPECT_EQ(book.level(Side::BUY, 100).head, o1);
+    EXPECT_EQ(book.quantity_at(Side::BUY, 100), 15u);
+}
+
+TEST_F(OrderBookTest, ModifySizeUpLosesPriority) {
+    const OrderHandle o1 = book.add_order(1, Side::BUY, 100, 10);
+    const OrderHandle o2 = book.add_order(2, Side::BUY, 100, 10);
+
+    ASSERT_TRUE(book.modify_order(o1, 100, 15));
+    EXPECT_EQ(book.level(Side::BUY, 100).head, o2);
+    EXPECT_EQ(book.level(Side::BUY, 100).tail, o1);
+    EXPECT_EQ(book.quantity_at(Side::BUY, 100), 25u);
+}
+
+TEST_F(OrderBookTest, ModifyPriceMovesLevelAndTouch) {
+    const OrderHandle o1 = book.add_order(1, Side::SELL, 100, 10);
+
+    ASSERT_TRUE(book.modify_order(o1, 102, 10));
+    EXPECT_EQ(book.best_ask(), 102u);
+    EXPECT_EQ(book.quantity_at(Side::SELL, 100), 0u);
+    EXPECT_EQ(book.quantity_at(Side::SELL, 102), 10u);
+
+    EXPECT_FALSE(book.modify_order(o1, 0, 10));
+    EXPECT_EQ(book.best_ask(), 102u);
+    EXPECT_EQ(book.rejected_orders(), 1u);
+
+    ASSERT_TRUE(book.modify_order(o1, 102, 0));
+    EXPECT_FALSE(book.has_ask());
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST_F(OrderBookTest, ModifyThatEmptiesTouchWithOverflowFullStaysConsistent) {
+    // Two touch-area bids, then enough far bids below to fill the window's
+    // overflow table to capacity
+    const OrderHandle top = book.add_order(1, Side::BUY, 4700, 10);
+    ASSERT_NE(top, INVALID_ORDER_HANDLE);
+    ASSERT_NE(book.add_order(2, Side::BUY, 4300, 10), INVALID_ORDER_HANDLE);
+    size_t far_orders = 0;
+    for (Price p = 1000; p < 1000 + OrderBook::Levels::OVERFLOW_CAPACITY; ++p) {
+        far_orders += book.add_order(p, Side::BUY, p, 1) != INVALID_ORDER_HANDLE;
+    }
+    const size_t orders = book.order_count();
+    ASSERT_EQ(orders, 2 + far_orders);
+
+    // Moving the touch order re-empties its level, so the touch falls to
+    // 4300; the window must not re-centre on that before the order relinks
+    const bool moved = book.modify_order(top, 5150, 10);
+    EXPECT_EQ(book.order_count(), orders);
+    if (moved) {
+        EXPECT_EQ(book.best_bid(), 5150u);
+        EXPECT_EQ(book.quantity_at(Side::BUY, 5150), 10u);
+        EXPECT_EQ(book.order(top).price, 5150u);
+    } else {
+        EXPECT_EQ(book.best_bid(), 4700u);
+        EXPECT_EQ(book.quantity_at(Side::BUY, 4700), 10u);
+    }
+
+    // Every order is still reachable through its level
+    book.cancel_order(top);
+    EXPECT_EQ(book.best_bid(), 4300u);
+    EXPECT_EQ(book.order_count(), orders - 1);
+}
+
+TEST_F(OrderBookTest, ManyLevelsStayConsistent) {
+    std::vector<OrderHandle> handles;
+    for (Price p = 1000; p < 2000; ++p) {
+        handles.push_back(book.add_order(p, Side::BUY, p, 1));
+    }
+    EXPECT_EQ(book.best_bid(), 1999u);
+
+    // Cancel from the top down; the touch must follow every step
+    for (auto it = handles.rbegin(); it != handles.rend(); ++it) {
+        EXPECT_EQ(book.best_bid(), book.order(*it).price);
+        book.cancel_order(*it);
+    }
+    EXPECT_FALSE(book.has_bid());
+}
+
+TEST_F(OrderBookTest, QuantityAheadSumsEarlierOrdersAtLevel) {
+    const OrderHandle a = book.add_order(1, Side::BUY, 100, 10);
+    const OrderHandle b = book.add_order(2, Side::BUY, 100, 20);
+    const OrderHandle c = book.add_order(3, Side::BUY, 100, 30);
+    book.add_order(4, Side::BUY, 101, 99);         // Other level does not count
+
+    EXPECT_EQ(book.quantity_ahead(a), 0u);
+    EXPECT_EQ(book.quantity_ahead(b), 10u);
+    EXPECT_EQ(book.quantity_ahead(c), 30u);
+
+    book.cancel_order(a);
+    EXPECT_EQ(book.quantity_ahead(c), 20u);
+}
+
+TEST_F(OrderBookTest, ForEachOrderVisitsInTimePriority) {
+    book.add_order(1, Side::SELL, 105, 10);
+    book.add_order(2, Side::SELL, 105, 20);
+    book.add_order(3, Side::SELL, 105, 30);
+
+    std::vector<Quantity> seen;
+    book.for_each_order(Side::SELL, 105, [&](OrderHandle, Quantity quantity) {
+        seen.push_back(quantity);
+    });
+    EXPECT_EQ(seen, (std::vector<Quantity>{10, 20, 30}));
+
+    seen.clear();
+    book.for_each_order(Side::SELL, 106, [&](OrderHandle, Quantity q) { seen.push_back(q); });
+    EXPECT_TRUE(seen.empty());
+}
+
+TEST_F(OrderBookTest, SweepWithKnownSideEmptiesLevel) {
+    book.add_order(1, Side::SELL, 105, 10);
+    book.add_order(2, Side::SELL, 105, 20);
+    book.add_order(3, Side::SELL, 106, 30);
+
+    // Executing the visited order is safe: the walk has its successor
+    size_t filled = 0;
+    book.for_each_order(Side::SELL, 105, [&](OrderHandle h, Quantity quantity) {
+        EXPECT_EQ(book.execute_order(h, quantity, Side::SELL), 0u);     // Nothing left
+        ++filled;
+    });
+    EXPECT_EQ(filled, 2u);
+    EXPECT_EQ(book.best_ask(), 106u);
+    EXPECT_EQ(book.order_count(), 1u);
+    EXPECT_EQ(pool.in_use(), 1u);
+}
+
+TEST(OrderBookLayoutTest, SplitAndInterleavedBooksAgree) {
+    using Split = BookSpec<Price, Quantity, uint32_t, Config::MIN_PRICE, Config::MAX_PRICE,
+                           Config::MAX_ORDERS, Config::LEVEL_WINDOW_SIZE,
+                           Config::LEVEL_OVERFLOW_SLOTS, OrderLayout::SPLIT>;
+    BasicOrderPool<Split> split_pool(1024);
+    BasicOrderBook<Split> split(7, split_pool);
+    OrderPool pool(1024);
+    OrderBook book(7, pool);
+
+    std::vector<OrderHandle> handles;
+    std::vector<BasicOrderBook<Split>::Handle> split_handles;
+    for (OrderId id = 1; id <= 200; ++id) {
+        const Side side = (id & 1) ? Side::SELL : Side::BUY;
+        const Price price = side == Side::SELL ? 100 + id % 7 : 99 - id % 7;
+        handles.push_back(book.add_order(id, side, price, 10 * id));
+        split_handles.push_back(split.add_order(id, side, price, 10 * id));
+    }
+    for (size_t i = 0; i < handles.size(); i += 3) {
+        book.execute_order(handles[i], 15);
+        split.execute_order(split_handles[i], 15);
+    }
+    for (size_t i = 1; i < handles.size(); i += 5) {
+        book.modify_order(handles[i], 105, 7);
+        split.modify_order(split_handles[i], 105, 7);
+    }
+
+    EXPECT_EQ(book.best_bid(), split.best_bid());
+    EXPECT_EQ(book.best_ask(), split.best_ask());
+    EXPECT_EQ(book.order_count(), split.order_count());
+    for (Price p = 90; p <= 110; ++p) {
+        EXPECT_EQ(book.quantity_at(Side::BUY, p), split.quantity_at(Side::BUY, p));
+        EXPECT_EQ(book.quantity_at(Side::SELL, p), split.quantity_at(Side::SELL, p));
+    }
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (book.order(handles[i]).quantity == 0) continue;
+        EXPECT_EQ(book.order(handles[i]).id, split.order(split_handles[i]).id);
+        EXPECT_EQ(book.quantity_ahead(handles[i]), split.quantity_ahead(split_handles[i]));
+    }
+}
@@ -0,0 +1,84 @@
+#include "OrderIdMap.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+TEST(OrderIdMapTest, SlotCountIsPowerOfTwoAtHalfLoad) {
+    EXPECT_TRUE(is_power_of_2(OrderIdMap<>::SLOT_COUNT));
+    EXPECT_GE(OrderIdMap<>::SLOT_COUNT, 2 * Config::MAX_ORDERS);
+    EXPECT_EQ(OrderIdMap<1000>::SLOT_COUNT, 2048u);
+}
+
+TEST(OrderIdMapTest, InsertFindErase) {
+    OrderIdMap<16> map;
+    EXPECT_TRUE(map.insert(42, 7));
+    EXPECT_TRUE(map.insert(43, 8));
+    EXPECT_EQ(map.find(42), 7u);
+    EXPECT_EQ(map.find(43), 8u);
+    EXPECT_EQ(map.find(44), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_TRUE(map.erase(42));
+    EXPECT_FALSE(map.erase(42));
+    EXPECT_FALSE(map.contains(42));
+    EXPECT_TRUE(map.contains(43));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(OrderIdMapTest, RejectsDuplicatesAndOverflow) {
+    OrderIdMap<4> map;
+    EXPECT_TRUE(map.insert(1, 1));
+    EXPECT_FALSE(map.insert(1, 2));
+    EXPECT_EQ(map.find(1), 1u);
+
+    EXPECT_TRUE(map.insert(2, 2));
+    EXPECT_TRUE(map.insert(3, 3));
+    EXPECT_TRUE(map.insert(4, 4));
+    EXPECT_FALSE(map.insert(5, 5));
+    EXPECT_EQ(map.size(), 4u);
+}
+
+TEST(OrderIdMapTest, ZeroIsAValidKey) {
+    OrderIdMap<4> map;
+    EXPECT_FALSE(map.contains(0));
+    EXPECT_TRUE(map.insert(0, 3));
+    EXPECT_EQ(map.find(0), 3u);
+}
+
+TEST(OrderIdMapTest, ChurnMatchesReferenceMap) {
+    // Random insert/erase churn at full load exercises backward-shift
+    // deletion across wrapped and colliding probe chains
+    constexpr size_t N = 4096;
+    OrderIdMap<N> map;
+    std::unordered_map<OrderId, OrderHandle> reference;
+    std::mt19937_64 rng(12345);
+
+    for (int step = 0; step < 200000; ++step) {
+        const OrderId id = rng() % (N * 2);
+        if (reference.count(id)) {
+            EXPECT_TRUE(map.erase(id));
+            reference.erase(id);
+        } else if (reference.size() < N) {
+            const OrderHandle h = static_cast<OrderHandle>(step);
+            EXPECT_TRUE(map.insert(id, h));
+            reference[id] = h;
+        }
+    }
+
+    EXPECT_EQ(map.size(), reference.size());
+    for (OrderId id = 0; id < N * 2; ++id) {
+        auto it = reference.find(id);
+        const OrderHandle expected = it == reference.end() ? INVALID_ORDER_HANDLE : it->second;
+        ASSERT_EQ(map.find(id), expected) << "id " << id;
+    }
+}
+
+TEST(OrderIdMapTest, ClearEmptiesMap) {
+    OrderIdMap<8> map;
+    map.insert(1, 1);
+    map.insert(2, 2);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.insert(1, 5));
+}
@@ -0,0 +1,87 @@
+#include "OrderPool.h"
+#include <gtest/gtest.h>
+#include <set>
+
+TEST(OrderPoolTest, HandsOutEveryDistinctSlot) {
+    OrderPool pool(64);
+    std::set<OrderHandle> seen;
+    for (size_t i = 0; i < pool.capacity(); ++i) {
+        const OrderHandle h = pool.allocate();
+        ASSERT_NE(h, INVALID_ORDER_HANDLE);
+        EXPECT_LT(h, pool.capacity());
+        EXPECT_TRUE(seen.insert(h).second);
+    }
+    EXPECT_TRUE(pool.exhausted());
+    EXPECT_EQ(pool.in_use(), 64u);
+    EXPECT_EQ(pool.available(), 0u);
+}
+
+TEST(OrderPoolTest, ReportsExhaustionWithoutThrowing) {
+    OrderPool pool(1);
+    EXPECT_NE(pool.allocate(), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(pool.allocate(), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(pool.allocate(), INVALID_ORDER_HANDLE);
+    EXPECT_EQ(pool.failed_allocations(), 2u);
+}
+
+TEST(OrderPoolTest, ReleasedSlotsAreReused) {
+    OrderPool pool(4);
+    const OrderHandle a = pool.allocate();
+    const OrderHandle b = pool.allocate();
+    pool.release(a);
+    EXPECT_EQ(pool.allocate(), a);  // LIFO reuse keeps hot slots in cache
+    pool.release(b);
+    EXPECT_EQ(pool.in_use(), 1u);
+    EXPECT_EQ(pool.high_watermark(), 2u);
+}
+
+TEST(OrderPoolTest, AllocatedSlotIsUnlinked) {
+    OrderPool pool(4);
+    const OrderHandle h = pool.allocate();
+    EXPECT_EQ(pool[h].next, INVALID_ORDER_HANDLE);
+    EXPECT_EQ(pool[h].prev, INVALID_ORDER_HANDLE);
+}
+
+namespace {
+
+using SplitSpec = BookSpec<Price, Quantity, uint32_t, Config::MIN_PRICE, Config::MAX_PRICE,
+                           Config::MAX_ORDERS, Config::LEVEL_WINDOW_SIZE,
+                           Config::LEVEL_OVERFLOW_SLOTS, OrderLayout::SPLIT>;
+
+}  // namespace
+
+TEST(OrderPoolTest, SplitLayoutKeepsHotAndColdInOneRegion) {
+    BasicOrderPool<SplitSpec> pool(100);
+    const auto* base = static_cast<const std::byte*>(pool.storage());
+    const auto* hot = reinterpret_cast<const std::byte*>(&pool.hot(0));
+    const auto* cold = reinterpret_cast<const std::byte*>(&pool.cold(0));
+
+    EXPECT_EQ(hot, base);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(cold) % CACHE_LINE_SIZE, 0u);
+    EXPECT_GE(cold, hot + 100 * sizeof(OrderLinks<SplitSpec>));
+    EXPECT_LE(reinterpret_cast<const std::byte*>(&pool.cold(99)) + sizeof(OrderInfo<SplitSpec>),
+              base + pool.storage_bytes());
+    EXPECT_EQ(&pool.hot(1), &pool.hot(0) + 1);     // Hot records densely packed
+}
+
+TEST(OrderPoolTest, SplitLayoutAssemblesWholeOrder) {
+    BasicOrderPool<SplitSpec> pool(4);
+    const auto h = pool.allocate();
+    pool.hot(h).quantity = 300;
+    pool.hot(h).price = 101;
+    pool.cold(h).id = 42;
+    pool.cold(h).symbol = 3;
+    pool.cold(h).side = Side::SELL;
+
+    const auto order = pool[h];
+    EXPECT_EQ(order.quantity, 300u);
+    EXPECT_EQ(order.price, 101u);
+    EXPECT_EQ(order.id, 42u);
+    EXPECT_EQ(order.symbol, 3u);
+    EXPECT_EQ(order.side, Side::SELL);
+    EXPECT_EQ(order.next, SplitSpec::INVALID_HANDLE);
+
+    pool.release(h);
+    EXPECT_EQ(pool.allocate(), h);
+    EXPECT_EQ(pool.in_use(), 1u);
+}
@@ -0,0 +1,70 @@
+#include "Profiler.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+TEST(ProfilerTest, DisabledZonesRecordNothing) {
+    Profiler& profiler = Profiler::instance();
+    ASSERT_TRUE(profiler.register_thread());
+    Profiler::set_enabled(false);
+    profiler.drain();
+
+    const uint64_t before = profiler.histogram(ProfileZone::BOOK_ADD).count();
+    { ScopedZoneTimer zone(ProfileZone::BOOK_ADD); }
+    profiler.drain();
+    EXPECT_EQ(profiler.histogram(ProfileZone::BOOK_ADD).count(), before);
+}
+
+TEST(ProfilerTest, EnabledZonesReachHistograms) {
+    Profiler& profiler = Profiler::instance();
+    ASSERT_TRUE(profiler.register_thread());
+    profiler.drain();
+
+    const uint64_t before = profiler.histogram(ProfileZone::BOOK_CANCEL).count();
+    Profiler::set_enabled(true);
+    for (int i = 0; i < 10; ++i) {
+        ScopedZoneTimer zone(ProfileZone::BOOK_CANCEL);
+    }
+    Profiler::set_enabled(false);
+
+    EXPECT_EQ(profiler.drain(), 10u);
+    EXPECT_EQ(profiler.histogram(ProfileZone::BOOK_CANCEL).count(), before + 10);
+}
+
+TEST(ProfilerTest, UnregisteredThreadIsIgnored) {
+    Profiler& profiler = Profiler::instance();
+    profiler.drain();
+    Profiler::set_enabled(true);
+    std::thread([] { ScopedZoneTimer zone(ProfileZone::FEED_PARSE); }).join();
+    Profiler::set_enabled(false);
+    EXPECT_EQ(profiler.drain(), 0u);
+}
+
+TEST(ProfilerTest, BackgroundThreadDrainsWorkers) {
+    Profiler& profiler = Profiler::instance();
+    profiler.drain();
+    const uint64_t before = profiler.histogram(ProfileZone::BOOK_EXECUTE).count();
+
+    profiler.start();
+    std::thread worker([&] {
+        profiler.register_thread();
+        for (int i = 0; i < 1000; ++i) {
+            ScopedZoneTimer zone(ProfileZone::BOOK_EXECUTE);
+        }
+    });
+    worker.join();
+    profiler.stop();
+
+    const uint64_t recorded = profiler.histogram(ProfileZone::BOOK_EXECUTE).count() - before;
+    EXPECT_EQ(recorded + profiler.dropped_samples(), 1000u);
+
+    const TSCTimer& timer = TSCTimer::instance();
+    std::ostringstream out;
+    profiler.report(timer, out);
+    EXPECT_NE(out.str().find("BOOK_EXECUTE"), std::string::npos);
+}
+
+TEST(ProfilerTest, MacroCompilesInEitherMode) {
+    HFT_PROFILE_ZONE(ProfileZone::BOOK_MODIFY);
+    SUCCEED();
+}
@@ -0,0 +1,163 @@
+#include "ShardedEngine.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+Message add(SymbolId symbol, OrderId id, Side side, Price price, Quantity qty) {
+    Message msg{};
+    msg.type = MessageType::ADD_ORDER;
+    msg.symbol = symbol;
+    msg.order_id = id;
+    msg.side = side;
+    msg.price = price;
+    msg.quantity = qty;
+    return msg;
+}
+
+Message cancel(SymbolId symbol, OrderId id) {
+    Message msg{};
+    msg.type = MessageType::CANCEL_ORDER;
+    msg.symbol = symbol;
+    msg.order_id = id;
+    return msg;
+}
+
+EngineConfig small_config() {
+    EngineConfig config;
+    config.orders_per_shard = 4096;
+    config.yield_when_idle = true;
+    return config;
+}
+
+}  // namespace
+
+TEST(ShardRouterTest, RoundRobinByDefault) {
+    ShardRouter router(4);
+    EXPECT_EQ(router.shard_count(), 4u);
+    EXPECT_EQ(router.shard_of(0), 0u);
+    EXPECT_EQ(router.shard_of(5), 1u);
+    EXPECT_EQ(router.symbols_on(0), Config::MAX_SYMBOLS / 4);
+}
+
+TEST(ShardRouterTest, WeightsBalanceLoad) {
+    std::array<uint64_t, Config::MAX_SYMBOLS> weights{};
+    weights[1] = 100;    // One very hot symbol
+    weights[2] = 40;
+    weights[3] = 30;
+    weights[4] = 30;
+
+    ShardRouter router = ShardRouter::from_weights(weights, 2);
+    EXPECT_NE(router.shard_of(1), router.shard_of(2));
+    EXPECT_EQ(router.shard_of(2), router.shard_of(3));
+    EXPECT_EQ(router.shard_of(2), router.shard_of(4));
+
+    // Cold symbols still spread across both shards
+    EXPECT_GT(router.symbols_on(0), 400u);
+    EXPECT_GT(router.symbols_on(1), 400u);
+}
+
+TEST(ShardRouterTest, WeightsRoundTripThroughFile) {
+    const std::string path = "/tmp/hft_weights_test_" + std::to_string(::getpid());
+    std::array<uint64_t, Config::MAX_SYMBOLS> weights{};
+    weights[7] = 123;
+    weights[999] = 4;
+    ASSERT_TRUE(ShardRouter::save_weights(path.c_str(), weights));
+
+    std::array<uint64_t, Config::MAX_SYMBOLS> loaded{};
+    loaded[3] = 9;   // Overwritten by the load
+    ASSERT_TRUE(ShardRouter::load_weights(path.c_str(), loaded));
+    EXPECT_EQ(loaded, weights);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(ShardRouter::load_weights("/nonexistent/weights", loaded));
+}
+
+TEST(ShardedEngineTest, RoutesSymbolsToOwningShards) {
+    ShardRouter router(2);
+    ShardedEngine engine(router, small_config());
+    ASSERT_TRUE(engine.start());
+
+    engine.publish(add(10, 1, Side::BUY, 100, 5));     // Shard 0
+    engine.publish(add(11, 2, Side::SELL, 105, 7));    // Shard 1
+    engine.publish(add(10, 3, Side::BUY, 101, 9));
+    engine.publish(cancel(10, 1));
+    engine.stop();
+
+    EXPECT_EQ(engine.processed(0), 3u);
+    EXPECT_EQ(engine.processed(1), 1u);
+    ASSERT_NE(engine.book(10), nullptr);
+    EXPECT_EQ(engine.book(10)->best_bid(), 101u);
+    EXPECT_EQ(engine.book(10)->order_count(), 1u);
+    EXPECT_EQ(engine.book(11)->best_ask(), 105u);
+
+    // Each shard only built books for its own symbols
+    EXPECT_EQ(engine.shard_books(0)->book(11), nullptr);
+    EXPECT_EQ(engine.shard_books(1)->book(10), nullptr);
+}
+
+TEST(ShardedEngineTest, IdKeyedMessagesFollowTheirOrderAcrossShards) {
+    ShardedEngine engine(ShardRouter(2), small_config());
+    ASSERT_TRUE(engine.start());
+    engine.publish(add(11, 1, Side::SELL, 105, 7));    // Shard 1
+    engine.publish(add(11, 2, Side::SELL, 106, 4));
+
+    Message execute{};                                 // No symbol set: 0 is shard 0's
+    execute.type = MessageType::EXECUTE_ORDER;
+    execute.order_id = 1;
+    execute.quantity = 3;
+    engine.publish(execute);
+
+    Message replace{};
+    replace.type = MessageType::MODIFY_ORDER;
+    replace.order_id = 2;
+    replace.new_order_id = 3;
+    replace.price = 107;
+    replace.quantity = 4;
+    engine.publish(replace);
+
+    Message unset{};
+    unset.type = MessageType::CANCEL_ORDER;
+    unset.order_id = 3;
+    engine.publish(unset);
+    EXPECT_EQ(engine.tracked_orders(), 1u);
+    engine.stop();
+
+    EXPECT_EQ(engine.processed(0), 0u);
+    EXPECT_EQ(engine.processed(1), 5u);
+    EXPECT_EQ(engine.book(11)->order_count(), 1u);
+    EXPECT_EQ(engine.book(11)->best_ask(), 105u);
+    EXPECT_EQ(engine.book(11)->quantity_at(Side::SELL, 105), 4u);
+    EXPECT_EQ(engine.observed_weights()[11], 5u);
+    EXPECT_EQ(engine.observed_weights()[0], 0u);
+}
+
+TEST(ShardedEngineTest, ObservedWeightsFeedTheNextSession) {
+    ShardedEngine engine(ShardRouter(2), small_config());
+    ASSERT_TRUE(engine.start());
+    for (OrderId id = 1; id <= 50; ++id) {
+        engine.publish(add(4, id, Side::BUY, 100, 1));
+    }
+    engine.publish(add(6, 100, Side::BUY, 100, 1));
+    engine.publish(add(Config::MAX_SYMBOLS, 101, Side::BUY, 100, 1));
+    engine.stop();
+
+    EXPECT_EQ(engine.unroutable(), 1u);
+    const auto weights = engine.observed_weights();
+    EXPECT_EQ(weights[4], 50u);
+    EXPECT_EQ(weights[6], 1u);
+
+    ShardRouter next = ShardRouter::from_weights(weights, 2);
+    EXPECT_FALSE(engine.running());
+    ASSERT_TRUE(engine.set_router(next));
+    EXPECT_NE(engine.router().shard_of(4), engine.router().shard_of(6));
+
+    ASSERT_TRUE(engine.start());
+    EXPECT_FALSE(engine.set_router(ShardRouter(2)));   // Not mid-session
+    engine.publish(add(4, 1, Side::SELL, 200, 3));
+    engine.stop();
+    EXPECT_EQ(engine.book(4)->best_ask(), 200u);
+    EXPECT_EQ(engine.book(4)->order_count(), 1u);      // Fresh session books
+}
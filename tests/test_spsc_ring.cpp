@@ -0,0 +1,275 @@
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <type_traits>
+#include <thread>
+#include <vector>
+
+TEST(SPSCRingTest, PushPopSingleItems) {
+    SPSCRing<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.capacity(), 3u);
+
+    EXPECT_TRUE(ring.try_emplace(1));
+    EXPECT_TRUE(ring.try_emplace(2));
+    EXPECT_TRUE(ring.try_emplace(3));
+    EXPECT_TRUE(ring.full());
+    EXPECT_FALSE(ring.try_emplace(4));
+    EXPECT_EQ(ring.failed_pushes(), 1u);
+
+    int value = 0;
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(ring.size(), 2u);
+    EXPECT_EQ(ring.total_pushes(), 3u);
+    EXPECT_EQ(ring.total_pops(), 1u);
+}
+
+TEST(SPSCRingTest, BatchPushIsPartialWhenNearlyFull) {
+    SPSCRing<int, 8> ring;
+    std::array<int, 10> items;
+    std::iota(items.begin(), items.end(), 0);
+
+    EXPECT_EQ(ring.try_push_n(items), 7u);
+    EXPECT_EQ(ring.failed_pushes(), 3u);
+    EXPECT_EQ(ring.total_pushes(), 7u);
+    EXPECT_EQ(ring.try_push_n(items), 0u);
+}
+
+TEST(SPSCRingTest, BatchOperationsWrapAround) {
+    SPSCRing<int, 8> ring;
+    std::array<int, 5> in{};
+    std::array<int, 5> out{};
+
+    // Move the indices near the end so the next batches straddle the wrap
+    std::iota(in.begin(), in.end(), 0);
+    ASSERT_EQ(ring.try_push_n(in), 5u);
+    ASSERT_EQ(ring.try_pop_n(out), 5u);
+
+    std::iota(in.begin(), in.end(), 100);
+    ASSERT_EQ(ring.try_push_n(in), 5u);
+    EXPECT_EQ(ring.size(), 5u);
+    ASSERT_EQ(ring.try_pop_n(out), 5u);
+    EXPECT_EQ(out, in);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.try_pop_n(out), 0u);
+}
+
+TEST(SPSCRingTest, ConsumeAllHonoursLimit) {
+    SPSCRing<int, 16> ring;
+    for (int i = 0; i < 10; ++i) {
+        ring.try_emplace(i);
+    }
+
+    std::vector<int> seen;
+    EXPECT_EQ(ring.consume_all([&](int& v) { seen.push_back(v); }, 4), 4u);
+    EXPECT_EQ(ring.consume_all([&](int& v) { seen.push_back(v); }), 6u);
+    EXPECT_EQ(ring.consume_all([&](int& v) { seen.push_back(v); }), 0u);
+
+    std::vector<int> expected(10);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(seen, expected);
+    EXPECT_EQ(ring.total_pops(), 10u);
+}
+
+TEST(SPSCRingTest, CrossThreadBatchesPreserveOrder) {
+    constexpr uint64_t N = 50000;
+    SPSCRing<uint64_t, 1024> ring;
+
+    std::thread producer([&] {
+        std::array<uint64_t, 32> batch;
+        uint64_t next = 0;
+        while (next < N) {
+            const size_t n = std::min<uint64_t>(batch.size(), N - next);
+            for (size_t i = 0; i < n; ++i) batch[i] = next + i;
+            size_t sent = 0;
+            while (sent < n) {
+                sent += ring.try_push_n(std::span<const uint64_t>(batch.data() + sent, n - sent));
+            }
+            next += n;
+        }
+    });
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    while (expected < N) {
+        ring.consume_all([&](uint64_t& v) { in_order &= (v == expected++); }, 64);
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(ring.total_pops(), N);
+}
+
+TEST(SPSCRingTest, CachedIndicesRefreshWhenStale) {
+    SPSCRing<int, 4> ring;
+    int value = 0;
+
+    // Consumer caches an empty view, producer caches a full one; each
+    // must reload the real index once the other side has moved
+    EXPECT_FALSE(ring.try_pop(value));
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(ring.try_emplace(i));
+    EXPECT_FALSE(ring.try_emplace(99));
+
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_emplace(3));
+
+    for (int expected = 1; expected <= 3; ++expected) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(SPSCRingTest, ReserveCommitPeekRelease) {
+    SPSCRing<std::array<int, 8>, 4> ring;
+
+    for (int i = 0; i < 3; ++i) {
+        auto* slot = ring.reserve();
+        ASSERT_NE(slot, nullptr);
+        (*slot)[0] = i;
+        (*slot)[7] = i * 10;
+        ring.commit();
+    }
+    EXPECT_EQ(ring.reserve(), nullptr);
+    EXPECT_EQ(ring.failed_pushes(), 1u);
+
+    for (int i = 0; i < 3; ++i) {
+        const auto* item = ring.peek();
+        ASSERT_NE(item, nullptr);
+        EXPECT_EQ(ring.peek(), item);  // Peeking twice sees the same slot
+        EXPECT_EQ((*item)[0], i);
+        EXPECT_EQ((*item)[7], i * 10);
+        ring.release();
+    }
+    EXPECT_EQ(ring.peek(), nullptr);
+    EXPECT_EQ(ring.total_pushes(), 3u);
+    EXPECT_EQ(ring.total_pops(), 3u);
+}
+
+TEST(SPSCRingTest, ReservedSlotInvisibleUntilCommit) {
+    SPSCRing<int, 4> ring;
+    int* slot = ring.reserve();
+    ASSERT_NE(slot, nullptr);
+    *slot = 5;
+    EXPECT_EQ(ring.peek(), nullptr);
+    EXPECT_TRUE(ring.empty());
+
+    ring.commit();
+    ASSERT_NE(ring.peek(), nullptr);
+    EXPECT_EQ(*ring.peek(), 5);
+}
+
+TEST(SPSCRingTest, StatsPoliciesCountOrCompileAway) {
+    SPSCRing<int, 4, SingleWriterRingStats> counted;
+    SPSCRing<int, 4, NoRingStats> silent;
+    int value = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        counted.try_emplace(i);
+        silent.try_emplace(i);
+    }
+    counted.try_pop(value);
+    silent.try_pop(value);
+
+    EXPECT_EQ(counted.total_pushes(), 3u);
+    EXPECT_EQ(counted.failed_pushes(), 1u);
+    EXPECT_EQ(counted.total_pops(), 1u);
+    EXPECT_EQ(silent.total_pushes(), 0u);
+    EXPECT_EQ(silent.failed_pushes(), 0u);
+    EXPECT_EQ(silent.size(), 2u);
+}
+
+template<typename Wait>
+class SPSCRingWaitTest : public ::testing::Test {};
+
+using WaitStrategies = ::testing::Types<BusySpinWait, PauseBackoffWait, FutexWait>;
+TYPED_TEST_SUITE(SPSCRingWaitTest, WaitStrategies);
+
+// FutexWait only compiles against a ring that wakes sleepers
+template<typename Wait>
+using WaitRing = SPSCRing<uint64_t, 64, SingleWriterRingStats, InlineRingStorage,
+                          std::conditional_t<std::is_same_v<Wait, FutexWait>, FutexRingWake, NoRingWake>>;
+
+TYPED_TEST(SPSCRingWaitTest, BlockingPushPopDeliversEverything) {
+    constexpr uint64_t N = 4096;
+    WaitRing<TypeParam> ring;
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < N; ++i) {
+            ring.template push<TypeParam>(i);
+        }
+    });
+
+    bool in_order = true;
+    for (uint64_t i = 0; i < N; ++i) {
+        uint64_t value = 0;
+        ring.template pop<TypeParam>(value);
+        in_order &= (value == i);
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(ring.total_pushes(), N);
+    EXPECT_EQ(ring.total_pops(), N);
+    EXPECT_EQ(ring.failed_pushes(), 0u);
+}
+
+using FutexRing = SPSCRing<uint64_t, 64, SingleWriterRingStats, InlineRingStorage, FutexRingWake>;
+
+TEST(SPSCRingFutexTest, NonBlockingProducerWakesSleepingConsumer) {
+    constexpr uint64_t N = 4096;
+    FutexRing ring;
+
+    // Spinning producer on try_emplace and reserve/commit, as an engine
+    // thread feeding a logger would
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < N; ++i) {
+            if (i % 2 == 0) {
+                while (!ring.try_emplace(i)) {}
+            } else {
+                uint64_t* slot;
+                while ((slot = ring.reserve()) == nullptr) {}
+                *slot = i;
+                ring.commit();
+            }
+            if (i % 512 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));   // Let the consumer sleep
+            }
+        }
+    });
+
+    bool in_order = true;
+    for (uint64_t i = 0; i < N; ++i) {
+        uint64_t value = 0;
+        ring.pop<FutexWait>(value);
+        in_order &= (value == i);
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+}
+
+TEST(SPSCRingFutexTest, NonBlockingConsumerWakesSleepingProducer) {
+    constexpr uint64_t N = 4096;
+    FutexRing ring;
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < N; ++i) {
+            ring.push<FutexWait>(i);
+        }
+    });
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    while (expected < N) {
+        ring.consume_all([&](uint64_t value) { in_order &= (value == expected++); });
+        if (expected % 1024 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));       // Let the producer fill up and sleep
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+}
@@ -0,0 +1,180 @@
+#include "TelemetryExporter.h"
+#include "BookManager.h"
+#include "OrderIdMap.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+Message add(OrderId id, Price price) {
+    Message msg{};
+    msg.type = MessageType::ADD_ORDER;
+    msg.symbol = 1;
+    msg.order_id = id;
+    msg.side = Side::BUY;
+    msg.price = price;
+    msg.quantity = 10;
+    return msg;
+}
+
+Message of_type(MessageType type, OrderId id) {
+    Message msg{};
+    msg.type = type;
+    msg.order_id = id;
+    msg.quantity = 5;
+    msg.price = 100;
+    return msg;
+}
+
+std::string scrape(uint16_t port, const char* request) {
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    std::string response;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        send(fd, request, std::strlen(request), 0) > 0) {
+        char buffer[4096];
+        ssize_t n;
+        while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) response.append(buffer, n);
+    }
+    close(fd);
+    return response;
+}
+
+using Ring = SPSCRing<int, 64, SingleWriterRingStats>;
+
+}  // namespace
+
+TEST(RingHealthTest, ConsumerRecordsBacklogHighWatermark) {
+    Ring ring;
+    for (int i = 0; i < 10; ++i) ASSERT_TRUE(ring.try_emplace(i));
+    EXPECT_EQ(ring.high_watermark(), 0u);       // Producer side records nothing
+
+    int item;
+    ASSERT_TRUE(ring.try_pop(item));
+    EXPECT_EQ(ring.high_watermark(), 10u);
+
+    for (int i = 0; i < 30; ++i) ASSERT_TRUE(ring.try_emplace(i));
+    ring.consume_all([](int) {});
+    EXPECT_EQ(ring.high_watermark(), 39u);
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(ring.try_emplace(i));
+    ring.consume_all([](int) {});
+    EXPECT_EQ(ring.high_watermark(), 39u);      // A peak, not the latest
+}
+
+TEST(OrderIdMapTest, TracksProbeLengths) {
+    OrderIdMap<4096> index;
+    EXPECT_EQ(index.longest_probe(), 0u);
+    for (OrderId id = 1; id <= 4096; ++id) {
+        ASSERT_TRUE(index.insert(id * 7919, static_cast<OrderHandle>(id)));
+    }
+    EXPECT_GE(index.longest_probe(), 1u);
+    EXPECT_LT(index.mean_probe(), 2.0);          // 50% load: short chains
+    index.clear();
+    EXPECT_EQ(index.longest_probe(), 0u);
+    EXPECT_EQ(index.mean_probe(), 0.0);
+}
+
+TEST(BookHealthTest, CountsAppliedMessagesByTypeAndRefreshesGauges) {
+    BookManager books(1024);
+    books.add_symbol(1);
+    for (OrderId id = 1; id <= 20; ++id) ASSERT_TRUE(books.process(add(id, 100 + id % 3)));
+    Message cancel = of_type(MessageType::CANCEL_ORDER, 1);
+    cancel.quantity = 10;                                // Full cancel
+    books.process(cancel);
+    books.process(of_type(MessageType::EXECUTE_ORDER, 2));
+    books.process(of_type(MessageType::MODIFY_ORDER, 3));
+    books.process(of_type(MessageType::HEARTBEAT, 0));
+    EXPECT_FALSE(books.process(add(4, 100)));           // Duplicate id: not counted
+    EXPECT_FALSE(books.process(of_type(MessageType::CANCEL_ORDER, 999)));
+
+    const BookHealth& health = books.health();
+    EXPECT_EQ(health.messages[static_cast<size_t>(MessageType::ADD_ORDER)].value(), 20u);
+    EXPECT_EQ(health.messages[static_cast<size_t>(MessageType::CANCEL_ORDER)].value(), 1u);
+    EXPECT_EQ(health.messages[static_cast<size_t>(MessageType::EXECUTE_ORDER)].value(), 1u);
+    EXPECT_EQ(health.messages[static_cast<size_t>(MessageType::MODIFY_ORDER)].value(), 1u);
+    EXPECT_EQ(health.messages[static_cast<size_t>(MessageType::HEARTBEAT)].value(), 1u);
+    EXPECT_EQ(health.rejected.value(), 1u);
+    EXPECT_EQ(health.unknown.value(), 1u);
+    EXPECT_EQ(books.rejected_orders(), 1u);
+
+    EXPECT_EQ(health.orders_in_use.value(), 0u);        // Not yet refreshed
+    books.refresh_health();
+    EXPECT_EQ(health.orders_in_use.value(), 19u);
+    EXPECT_EQ(health.pool_high_watermark.value(), 20u);
+
+    // process() refreshes by itself every REFRESH_INTERVAL messages
+    for (uint32_t i = 0; i < BookHealth::REFRESH_INTERVAL; ++i) {
+        books.process(add(100 + i, 200));
+    }
+    EXPECT_EQ(health.orders_in_use.value(), books.pool().in_use());
+}
+
+TEST(TelemetryExporterTest, RendersEveryFamilyOnce) {
+    const TSCTimer timer(3.0);
+    Ring ring;
+    ring.try_emplace(1);
+    BookManager books(1024);
+    books.add_symbol(1);
+    books.process(add(1, 100));
+    books.refresh_health();
+    LatencyHistogram histogram;
+    for (uint64_t c = 1; c <= 1000; ++c) histogram.record(c * 3);
+
+    TelemetryExporter telemetry(timer);
+    ASSERT_TRUE(telemetry.add_ring("feed", ring));
+    ASSERT_TRUE(telemetry.add_ring("output", ring));
+    ASSERT_TRUE(telemetry.add_books("equities", books));
+    ASSERT_TRUE(telemetry.add_histogram("book_process", histogram));
+
+    std::string text;
+    telemetry.render(text);
+    EXPECT_NE(text.find("hft_ring_occupancy{ring=\"feed\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_ring_capacity{ring=\"output\"} 63\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_book_messages_total{books=\"equities\",type=\"add\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_pool_orders_in_use{books=\"equities\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_pool_capacity{books=\"equities\"} 1024\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_latency_ns{zone=\"book_process\",quantile=\"0.5\"}"), std::string::npos);
+    EXPECT_NE(text.find("hft_latency_ns_count{zone=\"book_process\"} 1000\n"), std::string::npos);
+
+    // Exposition format: one TYPE line per family, samples follow it
+    std::set<std::string> families;
+    std::istringstream lines(text);
+    std::string line, current;
+    while (std::getline(lines, line)) {
+        if (line.rfind("# TYPE ", 0) == 0) {
+            current = line.substr(7, line.find(' ', 7) - 7);
+            EXPECT_TRUE(families.insert(current).second) << current;
+        } else if (line[0] != '#') {
+            EXPECT_EQ(line.rfind(current, 0), 0u) << line;
+        }
+    }
+    EXPECT_GE(families.size(), 15u);
+}
+
+TEST(TelemetryExporterTest, ServesMetricsOverHttp) {
+    const TSCTimer timer(3.0);
+    Ring ring;
+    TelemetryExporter telemetry(timer);
+    telemetry.add_ring("feed", ring);
+    ASSERT_TRUE(telemetry.start(0));
+    ASSERT_NE(telemetry.port(), 0);
+
+    const std::string response = scrape(telemetry.port(), "GET /metrics HTTP/1.1\r\nHost: x\r\n\r\n");
+    EXPECT_EQ(response.rfind("HTTP/1.0 200 OK\r\n", 0), 0u);
+    EXPECT_NE(response.find("text/plain; version=0.0.4"), std::string::npos);
+    EXPECT_NE(response.find("hft_ring_pushes_total{ring=\"feed\"} 0\n"), std::string::npos);
+
+    EXPECT_EQ(scrape(telemetry.port(), "POST / HTTP/1.1\r\n\r\n").rfind("HTTP/1.0 405", 0), 0u);
+    telemetry.stop();
+    EXPECT_GE(telemetry.scrapes(), 2u);
+}
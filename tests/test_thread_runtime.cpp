@@ -0,0 +1,78 @@
+#include "ThreadRuntime.h"
+#include "OrderPool.h"
+#include "SPSCRing.h"
+#include <gtest/gtest.h>
+#include <atomic>
+
+namespace {
+
+struct Tracked {
+    static inline int live = 0;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    ~Tracked() { --live; }
+};
+
+}  // namespace
+
+TEST(ThreadRuntimeTest, TopologyHasAtLeastOneNode) {
+    EXPECT_GE(ThreadRuntime::node_count(), 1);
+    EXPECT_GE(ThreadRuntime::node_of_cpu(0), 0);
+    EXPECT_EQ(ThreadRuntime::page_size() & (ThreadRuntime::page_size() - 1), 0u);
+}
+
+TEST(ThreadRuntimeTest, PinnedThreadRunsOnItsCore) {
+    std::atomic<int> observed_cpu{-1};
+    PinnedThread thread("test-pin", {.cpu = 0}, [&] {
+        observed_cpu.store(ThreadRuntime::current_cpu());
+    });
+    const PlacementStatus status = thread.status();
+    thread.join();
+
+    EXPECT_TRUE(status.pinned);
+    EXPECT_EQ(status.node, ThreadRuntime::node_of_cpu(0));
+    EXPECT_FALSE(status.realtime);   // Not requested
+    EXPECT_EQ(observed_cpu.load(), 0);
+}
+
+TEST(ThreadRuntimeTest, InvalidPlacementIsReportedNotFatal) {
+    PinnedThread thread("test-bad", {.cpu = CPU_SETSIZE + 1}, [] {});
+    EXPECT_FALSE(thread.status().pinned);
+}
+
+TEST(ThreadRuntimeTest, NodeLocalConstructsAndDestroys) {
+    {
+        auto object = NodeLocal<Tracked>::create(0, 42);
+        ASSERT_TRUE(object);
+        EXPECT_EQ(object->value, 42);
+        EXPECT_EQ(Tracked::live, 1);
+
+        NodeLocal<Tracked> moved = std::move(object);
+        EXPECT_FALSE(object);
+        EXPECT_EQ(moved->value, 42);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(ThreadRuntimeTest, NodeLocalRingIsUsable) {
+    auto ring = NodeLocal<SPSCRing<int, 1024>>::create(ThreadRuntime::node_of_cpu(0));
+    ASSERT_TRUE(ring);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ring.get()) % CACHE_LINE_SIZE, 0u);
+
+    EXPECT_TRUE(ring->try_emplace(7));
+    int value = 0;
+    EXPECT_TRUE(ring->try_pop(value));
+    EXPECT_EQ(value, 7);
+}
+
+TEST(ThreadRuntimeTest, PoolStorageCanBeBoundAndPrefaulted) {
+    OrderPool pool(4096);
+    ThreadRuntime::bind_to_node(pool.storage(), pool.storage_bytes(), 0);
+    ThreadRuntime::prefault(pool.storage(), pool.storage_bytes());
+
+    // Prefaulting rewrites bytes in place: the free list is intact
+    OrderHandle h = pool.allocate();
+    EXPECT_NE(h, INVALID_ORDER_HANDLE);
+    EXPECT_EQ(pool.in_use(), 1u);
+}
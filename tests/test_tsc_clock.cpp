@@ -0,0 +1,114 @@
+#include "TSCClock.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+namespace {
+
+int64_t realtime_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000LL + ts.tv_nsec;
+}
+
+}  // namespace
+
+TEST(TSCClockTest, MultiplyShiftMatchesNominalRate) {
+    TSCTimer timer(2.0);
+    TSCClock clock(timer);
+    EXPECT_EQ(clock.nominal_mult(), uint64_t{1} << (TSCClock::SHIFT - 1));
+    EXPECT_EQ(clock.cycles_to_ns(2000), 1000u);
+    EXPECT_EQ(TSCClock::scale(uint64_t{1} << 40, clock.nominal_mult()), uint64_t{1} << 39);
+}
+
+TEST(TSCClockTest, TracksRealtime) {
+    TSCClock clock;
+    const int64_t before = realtime_ns();
+    const int64_t mapped = static_cast<int64_t>(clock.now_utc_ns());
+    const int64_t after = realtime_ns();
+
+    // Allow for the bracket width and scheduling noise on a shared host
+    EXPECT_GE(mapped, before - 1'000'000);
+    EXPECT_LE(mapped, after + 1'000'000);
+}
+
+TEST(TSCClockTest, StampsBeforeTheAnchorMapBackwards) {
+    TSCClock clock;
+    uint32_t aux;
+    const uint64_t early = rdtscp(&aux);
+    clock.anchor();
+    const uint64_t late = rdtscp(&aux);
+
+    EXPECT_LT(clock.utc_ns(early), clock.utc_ns(late));
+}
+
+TEST(TSCClockTest, ReanchorRefinesSlopeWithinTolerance) {
+    TSCClock clock;
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    clock.anchor();
+
+    EXPECT_EQ(clock.anchor_count(), 2u);
+    const uint64_t nominal = clock.nominal_mult();
+    const uint64_t tolerance = nominal / 1'000'000 * TSCClock::MAX_DRIFT_PPM;
+    EXPECT_LE(clock.mult(), nominal + tolerance);
+    EXPECT_GE(clock.mult(), nominal - tolerance);
+    EXPECT_LT(std::llabs(clock.last_correction_ns()), 1'000'000);
+}
+
+TEST(TSCClockTest, EstimatedNominalRateIsReplacedByTheMeasuredSlope) {
+    // CPUID base MHz is typically 0.1-0.3% off the real TSC rate
+    const double real_ghz = TSCTimer::instance().get_frequency_ghz();
+    const TSCTimer estimated(real_ghz * 1.002, TSCFrequencySource::CPUID_ESTIMATE);
+    TSCClock clock(estimated);
+    EXPECT_TRUE(clock.nominal_is_provisional());
+    const uint64_t estimate_mult = clock.nominal_mult();
+
+    for (int i = 0; i < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        clock.anchor();
+    }
+
+    // The measured slope became the reference and later slopes track it;
+    // held at the estimate, each re-anchor would correct by ~300 us
+    EXPECT_FALSE(clock.nominal_is_provisional());
+    EXPECT_EQ(clock.rejected_slopes(), 0u);
+    EXPECT_GT(clock.nominal_mult(), estimate_mult);
+    EXPECT_LT(std::llabs(clock.last_correction_ns()), 100'000);
+}
+
+TEST(TSCClockTest, ExactNominalRateRejectsFarSlopes) {
+    const double real_ghz = TSCTimer::instance().get_frequency_ghz();
+    const TSCTimer wrong(real_ghz * 1.002);
+    TSCClock clock(wrong);
+    EXPECT_FALSE(clock.nominal_is_provisional());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    clock.anchor();
+    EXPECT_EQ(clock.rejected_slopes(), 1u);
+    EXPECT_EQ(clock.mult(), clock.nominal_mult());
+}
+
+TEST(TSCClockTest, ReadersNeverSeeTornAnchors) {
+    TSCClock clock;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> bad{0};
+
+    std::thread reader([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            const int64_t mapped = static_cast<int64_t>(clock.now_utc_ns());
+            if (std::llabs(mapped - realtime_ns()) > 50'000'000) {
+                bad.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        clock.anchor();
+    }
+    stop.store(true);
+    reader.join();
+
+    EXPECT_EQ(bad.load(), 0u);
+}
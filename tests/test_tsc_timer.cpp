@@ -0,0 +1,117 @@
+#include "TSCTimer.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::string temp_cache_path() {
+    return "/tmp/hft_tsc_test_" + std::to_string(::getpid());
+}
+
+}  // namespace
+
+TEST(TSCTimerTest, ExplicitFrequencyConvertsCycles) {
+    TSCTimer timer(2.5);
+    EXPECT_EQ(timer.frequency_source(), TSCFrequencySource::EXPLICIT);
+    EXPECT_DOUBLE_EQ(timer.cycles_to_ns(2500), 1000.0);
+}
+
+TEST(TSCTimerTest, EnvironmentOverrideWins) {
+    ::setenv(TSCTimer::FREQ_ENV_VAR, "3.125", 1);
+    EXPECT_DOUBLE_EQ(TSCTimer::frequency_from_environment(), 3.125);
+
+    TSCTimer timer;
+    EXPECT_EQ(timer.frequency_source(), TSCFrequencySource::ENVIRONMENT);
+    EXPECT_DOUBLE_EQ(timer.get_frequency_ghz(), 3.125);
+
+    ::setenv(TSCTimer::FREQ_ENV_VAR, "fast", 1);
+    EXPECT_EQ(TSCTimer::frequency_from_environment(), 0.0);
+    ::setenv(TSCTimer::FREQ_ENV_VAR, "500", 1);
+    EXPECT_EQ(TSCTimer::frequency_from_environment(), 0.0);
+    ::unsetenv(TSCTimer::FREQ_ENV_VAR);
+}
+
+TEST(TSCTimerTest, CacheFileRoundTrip) {
+    const std::string path = temp_cache_path();
+    ASSERT_TRUE(TSCTimer::store_cached_frequency(path.c_str(), 2.899876));
+    EXPECT_NEAR(TSCTimer::load_cached_frequency(path.c_str()), 2.899876, 1e-9);
+
+    ::setenv(TSCTimer::CACHE_ENV_VAR, path.c_str(), 1);
+    TSCTimer timer;
+    EXPECT_EQ(timer.frequency_source(), TSCFrequencySource::CACHE_FILE);
+    EXPECT_NEAR(timer.get_frequency_ghz(), 2.899876, 1e-9);
+    ::unsetenv(TSCTimer::CACHE_ENV_VAR);
+    std::remove(path.c_str());
+}
+
+TEST(TSCTimerTest, CacheFromAnotherBootIsIgnored) {
+    const std::string path = temp_cache_path();
+    {
+        std::ofstream out(path);
+        out << "00000000-0000-0000-0000-000000000000 2.5\n";
+    }
+    EXPECT_EQ(TSCTimer::load_cached_frequency(path.c_str()), 0.0);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(TSCTimer::load_cached_frequency(path.c_str()), 0.0);  // Missing
+    EXPECT_EQ(TSCTimer::load_cached_frequency(""), 0.0);            // Disabled
+    EXPECT_FALSE(TSCTimer::store_cached_frequency("", 2.5));
+}
+
+TEST(TSCTimerTest, UntrustedCacheFilesAreIgnored) {
+    const std::string path = temp_cache_path();
+    const std::string target = path + ".target";
+    ASSERT_TRUE(TSCTimer::store_cached_frequency(target.c_str(), 2.5));
+
+    struct stat st;
+    ASSERT_EQ(::stat(target.c_str(), &st), 0);
+    EXPECT_EQ(st.st_mode & 0777, 0600u);
+
+    // A symlink planted at the cache path is not followed
+    ASSERT_EQ(::symlink(target.c_str(), path.c_str()), 0);
+    EXPECT_EQ(TSCTimer::load_cached_frequency(path.c_str()), 0.0);
+    std::remove(path.c_str());
+
+    // Nor is a file others could have rewritten
+    ASSERT_EQ(::chmod(target.c_str(), 0666), 0);
+    EXPECT_EQ(TSCTimer::load_cached_frequency(target.c_str()), 0.0);
+    std::remove(target.c_str());
+}
+
+TEST(TSCTimerTest, DefaultCachePathIsPerUser) {
+    const std::string path = TSCTimer::cache_file_path();
+    EXPECT_NE(path.find(TSCTimer::CACHE_FILE_NAME), std::string::npos);
+    if (std::getenv("XDG_RUNTIME_DIR") == nullptr) {
+        EXPECT_EQ(path, "/tmp/" + std::string(TSCTimer::CACHE_FILE_NAME) + '.' + std::to_string(::geteuid()));
+    }
+}
+
+TEST(TSCTimerTest, CpuidFrequencyIsPlausibleWhenReported) {
+    bool estimate = true;
+    const double freq_ghz = TSCTimer::frequency_from_cpuid(&estimate);
+    if (freq_ghz == 0.0) {
+        EXPECT_FALSE(estimate);
+        GTEST_SKIP() << "CPUID does not report the TSC frequency here";
+    }
+    if (freq_ghz == 0.0) {
+        GTEST_SKIP() << "CPUID does not report the TSC frequency here";
+    }
+    EXPECT_GE(freq_ghz, TSCTimer::MIN_FREQ_GHZ);
+    EXPECT_LE(freq_ghz, TSCTimer::MAX_FREQ_GHZ);
+}
+
+TEST(TSCTimerTest, InstanceIsSharedAndMonotonic) {
+    const TSCTimer& a = TSCTimer::instance();
+    const TSCTimer& b = TSCTimer::instance();
+    EXPECT_EQ(&a, &b);
+    EXPECT_GT(a.get_frequency_ghz(), 0.0);
+
+    const uint64_t t0 = a.now();
+    const uint64_t t1 = a.now();
+    EXPECT_GE(t1, t0);
+}